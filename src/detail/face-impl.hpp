@@ -27,9 +27,14 @@
 
 #include "registered-prefix.hpp"
 #include "pending-interest.hpp"
+#include "pending-interest-table.hpp"
+#include "interest-filter-table.hpp"
 #include "container-with-on-empty-signal.hpp"
 
 #include "../util/scheduler.hpp"
+#include "../util/timing-wheel.hpp"
+#include "../util/interest-latency-tracker.hpp"
+#include "../util/packet-capture.hpp"
 #include "../util/config-file.hpp"
 #include "../util/signal.hpp"
 #include "../util/logger.hpp"
@@ -52,8 +57,6 @@ NDN_CXX_LOG_INIT(Face);
 class Face::Impl : noncopyable
 {
 public:
-  typedef ContainerWithOnEmptySignal<shared_ptr<PendingInterest>> PendingInterestTable;
-  typedef std::list<shared_ptr<InterestFilterRecord> > InterestFilterTable;
   typedef ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>> RegisteredPrefixTable;
 
   explicit
@@ -61,6 +64,7 @@ public:
     : m_face(face)
     , m_scheduler(m_face.getIoService())
     , m_processEventsTimeoutEvent(m_scheduler)
+    , m_timingWheel(m_face.getIoService())
   {
     auto postOnEmptyPitOrNoRegisteredPrefixes = [this] {
       this->m_face.getIoService().post(bind(&Impl::onEmptyPitOrNoRegisteredPrefixes, this));
@@ -80,51 +84,79 @@ public:
   void
   satisfyPendingInterests(Data& data)
   {
-    for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
-      if ((*entry)->getInterest()->matchesData(data)) {
+    // Removals are posted, so that matched entries stay valid while callbacks run.  A callback
+    // can express an Interest, which is inserted right away; as in a scan of the whole table,
+    // it is also satisfied by this Data if it matches.
+    uint64_t insertedSince = 0;
+    while (insertedSince != m_pendingInterestTable.getInsertionMark()) {
+      auto matches = m_pendingInterestTable.findMatchingData(data, insertedSince);
+      insertedSince = m_pendingInterestTable.getInsertionMark();
+
+      for (auto entry : matches) {
         shared_ptr<PendingInterest> matchedEntry = *entry;
         NDN_CXX_LOG_DEBUG("   satisfying " << *matchedEntry->getInterest());
+        this->recordLatency(&util::InterestLatencyTracker::recordData, *matchedEntry);
 
-        entry = m_pendingInterestTable.erase(entry);
+        m_pendingInterestTable.erase(entry);
 
         matchedEntry->invokeDataCallback(data);
       }
-      else
-        ++entry;
     }
   }
 
   void
   nackPendingInterests(const lp::Nack& nack)
   {
-    for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
-      const Interest& pendingInterest = *(*entry)->getInterest();
-      if (pendingInterest == nack.getInterest()) {
+    // an Interest expressed by a callback is nacked too, as in satisfyPendingInterests
+    uint64_t insertedSince = 0;
+    while (insertedSince != m_pendingInterestTable.getInsertionMark()) {
+      auto matches = m_pendingInterestTable.findMatchingNack(nack, insertedSince);
+      insertedSince = m_pendingInterestTable.getInsertionMark();
+
+      for (auto entry : matches) {
         shared_ptr<PendingInterest> matchedEntry = *entry;
         NDN_CXX_LOG_DEBUG("   nacking " << *matchedEntry->getInterest());
+        this->recordLatency(&util::InterestLatencyTracker::recordNack, *matchedEntry);
 
-        entry = m_pendingInterestTable.erase(entry);
+        m_pendingInterestTable.erase(entry);
 
         matchedEntry->invokeNackCallback(nack);
       }
-      else {
-        ++entry;
-      }
     }
   }
 
   void
   processInterestFilters(Interest& interest)
   {
-    for (const auto& filter : m_interestFilterTable) {
-      if (filter->doesMatch(interest.getName())) {
-        NDN_CXX_LOG_DEBUG("   matching " << filter->getFilter().getPrefix() << " "
-                          << (filter->getFilter().hasRegexFilter() ?
-                              filter->getFilter().getRegexFilter().getExpr() :
-                              std::string()));
-
-        filter->invokeInterestCallback(interest);
-      }
+    for (const auto& filter : m_interestFilterTable.findMatches(interest.getName())) {
+      NDN_CXX_LOG_DEBUG("   matching " << filter->getFilter().getPrefix() << " "
+                        << (filter->getFilter().hasRegexFilter() ?
+                            filter->getFilter().getRegexFilter().getExpr() :
+                            std::string()));
+
+      filter->invokeInterestCallback(interest);
+    }
+  }
+
+  /** \brief record the time since \p entry was expressed, if latencies are being tracked
+   */
+  void
+  recordLatency(void (util::InterestLatencyTracker::*record)(const Name&, time::nanoseconds),
+                const PendingInterest& entry)
+  {
+    if (m_latencyTracker != nullptr) {
+      ((*m_latencyTracker).*record)(entry.getInterest()->getName(),
+                                    time::steady_clock::now() - entry.getExpressTime());
+    }
+  }
+
+  /** \brief pass \p wire to the packet capture, if any, unless filtered out by \p name
+   */
+  void
+  capturePacket(util::PacketCapture::Direction direction, const Name& name, const Block& wire)
+  {
+    if (m_packetCapture != nullptr && m_packetCapture->wantsPacket(name)) {
+      m_packetCapture->capture(direction, wire);
     }
   }
 
@@ -155,8 +187,11 @@ public:
                                                                  afterSatisfied,
                                                                  afterNacked,
                                                                  afterTimeout,
-                                                                 ref(m_scheduler))).first;
-    (*entry)->setDeleter([this, entry] { m_pendingInterestTable.erase(entry); });
+                                                                 ref(m_timingWheel))).first;
+    (*entry)->setDeleter([this, entry] {
+      this->recordLatency(&util::InterestLatencyTracker::recordTimeout, **entry);
+      m_pendingInterestTable.erase(entry);
+    });
 
     lp::Packet packet;
 
@@ -169,7 +204,9 @@ public:
                                                  interest->wireEncode().end()));
 
     NDN_CXX_LOG_DEBUG("<I " << *interest);
-    m_face.m_transport->send(packet.wireEncode());
+    Block wire = packet.wireEncode();
+    this->capturePacket(util::PacketCapture::Direction::OUTGOING, interest->getName(), wire);
+    m_face.m_transport->send(wire);
   }
 
   void
@@ -200,7 +237,9 @@ public:
                                                  data->wireEncode().end()));
 
     NDN_CXX_LOG_DEBUG("<D " << data->getName());
-    m_face.m_transport->send(packet.wireEncode());
+    Block wire = packet.wireEncode();
+    this->capturePacket(util::PacketCapture::Direction::OUTGOING, data->getName(), wire);
+    m_face.m_transport->send(wire);
   }
 
   void
@@ -215,7 +254,10 @@ public:
     packet.add<lp::FragmentField>(std::make_pair(interest.begin(), interest.end()));
 
     NDN_CXX_LOG_DEBUG("<N " << nack->getInterest() << "~" << nack->getHeader().getReason());
-    m_face.m_transport->send(packet.wireEncode());
+    Block wire = packet.wireEncode();
+    this->capturePacket(util::PacketCapture::Direction::OUTGOING,
+                        nack->getInterest().getName(), wire);
+    m_face.m_transport->send(wire);
   }
 
   /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -230,13 +272,7 @@ public:
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end())
-      {
-        m_interestFilterTable.erase(i);
-      }
+    m_interestFilterTable.remove(reinterpret_cast<const InterestFilterRecord*>(interestFilterId));
   }
 
   /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -299,7 +335,7 @@ public:
 
       if (filter != nullptr) {
         // it was a combined operation
-        m_interestFilterTable.remove(filter);
+        m_interestFilterTable.remove(filter.get());
       }
 
       ControlParameters params;
@@ -344,11 +380,15 @@ private:
   Face& m_face;
   util::Scheduler m_scheduler;
   util::scheduler::ScopedEventId m_processEventsTimeoutEvent;
+  util::TimingWheel m_timingWheel; ///< drives the timeouts of pending Interests
 
   PendingInterestTable m_pendingInterestTable;
   InterestFilterTable m_interestFilterTable;
   RegisteredPrefixTable m_registeredPrefixTable;
 
+  shared_ptr<util::InterestLatencyTracker> m_latencyTracker;
+  shared_ptr<util::PacketCapture> m_packetCapture;
+
   unique_ptr<boost::asio::io_service::work> m_ioServiceWork; // if thread needs to be preserved
 
   friend class Face;
@@ -76,27 +76,6 @@ private:
  */
 class InterestFilterId;
 
-/**
- * @brief Functor to match InterestFilterId
- */
-class MatchInterestFilterId
-{
-public:
-  explicit
-  MatchInterestFilterId(const InterestFilterId* interestFilterId)
-    : m_id(interestFilterId)
-  {
-  }
-
-  bool
-  operator()(const shared_ptr<InterestFilterRecord>& interestFilterId) const
-  {
-    return (reinterpret_cast<const InterestFilterId*>(interestFilterId.get()) == m_id);
-  }
-private:
-  const InterestFilterId* m_id;
-};
-
 } // namespace ndn
 
 #endif // NDN_DETAIL_INTEREST_FILTER_RECORD_HPP
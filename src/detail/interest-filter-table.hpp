@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+#define NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+
+#include "../common.hpp"
+#include "interest-filter-record.hpp"
+#include "name-component-hash.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ndn {
+
+/**
+ * @brief The Interest filters of a Face, indexed by the prefix of each filter
+ *
+ * Each filter is stored in a trie of Name components at the node of its prefix, so that
+ * finding the filters of an Interest only visits the nodes along the Interest Name.  The
+ * regular expression of a filter, if any, is evaluated only when its prefix matches.
+ */
+class InterestFilterTable : noncopyable
+{
+public:
+  typedef shared_ptr<InterestFilterRecord> value_type;
+
+  size_t
+  size() const
+  {
+    return m_records.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_records.empty();
+  }
+
+  /**
+   * @brief add @p record after the filters already in the table
+   */
+  void
+  push_back(const value_type& record)
+  {
+    Node* node = &m_root;
+    for (const name::Component& component : record->getFilter().getPrefix()) {
+      unique_ptr<Node>& child = node->children[component];
+      if (child == nullptr) {
+        child.reset(new Node);
+      }
+      node = child.get();
+    }
+    node->entries.push_back({m_nextSequence++, record});
+    m_records.insert(record.get());
+  }
+
+  /**
+   * @brief remove @p record
+   * @return whether @p record was in the table
+   * @note @p record is not dereferenced unless it is in the table
+   */
+  bool
+  remove(const InterestFilterRecord* record)
+  {
+    if (m_records.erase(record) == 0) {
+      return false;
+    }
+
+    const Name& prefix = record->getFilter().getPrefix();
+    std::vector<Node*> path{&m_root};
+    for (const name::Component& component : prefix) {
+      path.push_back(path.back()->children.at(component).get());
+    }
+    std::vector<Entry>& entries = path.back()->entries;
+    entries.erase(std::find_if(entries.begin(), entries.end(),
+                               [record] (const Entry& entry) { return entry.record.get() == record; }));
+
+    // delete nodes left without entries and children
+    for (size_t i = path.size() - 1; i > 0; --i) {
+      if (!path[i]->entries.empty() || !path[i]->children.empty()) {
+        break;
+      }
+      path[i - 1]->children.erase(prefix.get(i - 1));
+    }
+    return true;
+  }
+
+  /**
+   * @return filters that match @p name, in the order they were added
+   */
+  std::vector<value_type>
+  findMatches(const Name& name) const
+  {
+    std::vector<const Entry*> matches;
+    auto collectMatches = [&name, &matches] (const Node& node) {
+      for (const Entry& entry : node.entries) {
+        if (!entry.record->getFilter().hasRegexFilter() || entry.record->doesMatch(name)) {
+          matches.push_back(&entry);
+        }
+      }
+    };
+
+    const Node* node = &m_root;
+    collectMatches(*node);
+    for (const name::Component& component : name) {
+      auto child = node->children.find(component);
+      if (child == node->children.end()) {
+        break;
+      }
+      node = child->second.get();
+      collectMatches(*node);
+    }
+
+    std::sort(matches.begin(), matches.end(),
+              [] (const Entry* a, const Entry* b) { return a->sequence < b->sequence; });
+    std::vector<value_type> records;
+    records.reserve(matches.size());
+    for (const Entry* entry : matches) {
+      records.push_back(entry->record);
+    }
+    return records;
+  }
+
+private:
+  struct Entry
+  {
+    uint64_t sequence; ///< registration order
+    value_type record;
+  };
+
+  /**
+   * @brief a node in the trie of filter prefixes
+   */
+  struct Node
+  {
+    std::unordered_map<name::Component, unique_ptr<Node>, NameComponentHash> children;
+    std::vector<Entry> entries; ///< filters whose prefix ends at this node
+  };
+
+  Node m_root;
+  std::unordered_set<const InterestFilterRecord*> m_records;
+  uint64_t m_nextSequence = 0;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
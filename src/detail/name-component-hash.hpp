@@ -0,0 +1,50 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_DETAIL_NAME_COMPONENT_HASH_HPP
+#define NDN_DETAIL_NAME_COMPONENT_HASH_HPP
+
+#include "../name-component.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace ndn {
+
+/**
+ * @brief Hash function of name::Component, for the unordered containers of name tries
+ *
+ * Like name::Component::operator==, which these containers use as their key equality, this
+ * considers only the value of the component, so that equal components have equal hashes
+ * regardless of their TLV-TYPE.
+ */
+struct NameComponentHash
+{
+  size_t
+  operator()(const name::Component& component) const
+  {
+    return boost::hash_range(component.value_begin(), component.value_end());
+  }
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_NAME_COMPONENT_HASH_HPP
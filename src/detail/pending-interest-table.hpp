@@ -0,0 +1,286 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+#define NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+
+#include "../common.hpp"
+#include "../util/signal.hpp"
+#include "pending-interest.hpp"
+#include "name-component-hash.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief The pending Interest table of a Face, indexed by Interest Name and Nonce
+ *
+ * Entries are kept in a list in the order they were inserted, which is also the order in which
+ * findMatchingData and findMatchingNack return them.  In addition, each entry is indexed in a
+ * trie of Name components, so that finding the entries satisfied by a Data only visits entries
+ * whose Name is a prefix of the Data full Name, and in a hash table of Nonces, so that finding
+ * the entries of a Nack only visits entries with the same Nonce.
+ *
+ * Like ContainerWithOnEmptySignal, onEmpty is fired when the last entry is erased.
+ */
+class PendingInterestTable : noncopyable
+{
+public:
+  typedef std::list<shared_ptr<PendingInterest>> Base;
+  typedef Base::value_type value_type;
+  typedef Base::iterator iterator;
+
+  iterator
+  begin()
+  {
+    return m_entries.begin();
+  }
+
+  iterator
+  end()
+  {
+    return m_entries.end();
+  }
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_entries.empty();
+  }
+
+  std::pair<iterator, bool>
+  insert(const value_type& value)
+  {
+    iterator entry = m_entries.insert(m_entries.end(), value);
+    IndexEntry indexEntry{m_nextSequence++, entry};
+
+    const Interest& interest = *value->getInterest();
+    Node* node = &m_root;
+    for (const name::Component& component : interest.getName()) {
+      unique_ptr<Node>& child = node->children[component];
+      if (child == nullptr) {
+        child.reset(new Node);
+      }
+      node = child.get();
+    }
+    node->entries.push_back(indexEntry);
+
+    m_nonceIndex.insert({interest.getNonce(), indexEntry});
+    return {entry, true};
+  }
+
+  iterator
+  erase(iterator entry)
+  {
+    iterator next = this->eraseEntry(entry);
+    if (empty()) {
+      this->onEmpty();
+    }
+    return next;
+  }
+
+  void
+  clear()
+  {
+    m_entries.clear();
+    m_root = Node();
+    m_nonceIndex.clear();
+    this->onEmpty();
+  }
+
+  /**
+   * @return a mark of the insertion order, which findMatchingData and findMatchingNack accept
+   *         to return only entries inserted after the mark was taken
+   */
+  uint64_t
+  getInsertionMark() const
+  {
+    return m_nextSequence;
+  }
+
+  template<class Predicate>
+  void
+  remove_if(Predicate p)
+  {
+    for (iterator entry = m_entries.begin(); entry != m_entries.end();) {
+      entry = p(*entry) ? this->eraseEntry(entry) : std::next(entry);
+    }
+    if (empty()) {
+      this->onEmpty();
+    }
+  }
+
+  /**
+   * @return entries whose Interest matches @p data, in the order they were inserted
+   * @param insertedSince if given, only entries inserted after getInsertionMark returned it
+   *
+   * Interest::matchesData is evaluated only on entries whose Name is a prefix of the Name of
+   * @p data, or equals its full Name.
+   */
+  std::vector<iterator>
+  findMatchingData(const Data& data, uint64_t insertedSince = 0) const
+  {
+    std::vector<IndexEntry> matches;
+    auto collectMatches = [&] (const Node& node) {
+      for (const IndexEntry& indexEntry : node.entries) {
+        if (indexEntry.sequence >= insertedSince &&
+            (*indexEntry.entry)->getInterest()->matchesData(data)) {
+          matches.push_back(indexEntry);
+        }
+      }
+    };
+
+    const Node* node = &m_root;
+    collectMatches(*node);
+    for (const name::Component& component : data.getName()) {
+      auto child = node->children.find(component);
+      if (child == node->children.end()) {
+        return sortEntries(matches);
+      }
+      node = child->second.get();
+      collectMatches(*node);
+    }
+
+    // an Interest Name can also end with the implicit digest of the Data
+    if (!node->children.empty()) {
+      auto child = node->children.find(data.getFullName().get(-1));
+      if (child != node->children.end()) {
+        collectMatches(*child->second);
+      }
+    }
+    return sortEntries(matches);
+  }
+
+  /**
+   * @return entries whose Interest equals the Interest of @p nack, in the order they were
+   *         inserted
+   * @param insertedSince if given, only entries inserted after getInsertionMark returned it
+   */
+  std::vector<iterator>
+  findMatchingNack(const lp::Nack& nack, uint64_t insertedSince = 0) const
+  {
+    const Interest& nackInterest = nack.getInterest();
+    if (!nackInterest.hasNonce()) {
+      // every pending Interest has a Nonce
+      return {};
+    }
+
+    std::vector<IndexEntry> matches;
+    auto range = m_nonceIndex.equal_range(nackInterest.getNonce());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.sequence >= insertedSince &&
+          *(*it->second.entry)->getInterest() == nackInterest) {
+        matches.push_back(it->second);
+      }
+    }
+    return sortEntries(matches);
+  }
+
+private:
+  struct IndexEntry
+  {
+    uint64_t sequence; ///< insertion order
+    iterator entry;
+  };
+
+  /**
+   * @brief a node in the trie of Interest Names
+   */
+  struct Node
+  {
+    std::unordered_map<name::Component, unique_ptr<Node>, NameComponentHash> children;
+    std::vector<IndexEntry> entries; ///< entries whose Name ends at this node
+  };
+
+  /**
+   * @brief erase @p entry from the list and the indexes, without firing onEmpty
+   */
+  iterator
+  eraseEntry(iterator entry)
+  {
+    const Interest& interest = *(*entry)->getInterest();
+    auto matchesEntry = [entry] (const IndexEntry& indexEntry) {
+      return indexEntry.entry == entry;
+    };
+
+    // remember the path, so that nodes left without entries and children can be deleted
+    std::vector<Node*> path{&m_root};
+    for (const name::Component& component : interest.getName()) {
+      path.push_back(path.back()->children.at(component).get());
+    }
+    std::vector<IndexEntry>& entries = path.back()->entries;
+    entries.erase(std::find_if(entries.begin(), entries.end(), matchesEntry));
+    for (size_t i = path.size() - 1; i > 0; --i) {
+      if (!path[i]->entries.empty() || !path[i]->children.empty()) {
+        break;
+      }
+      path[i - 1]->children.erase(interest.getName().get(i - 1));
+    }
+
+    auto range = m_nonceIndex.equal_range(interest.getNonce());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.entry == entry) {
+        m_nonceIndex.erase(it);
+        break;
+      }
+    }
+
+    return m_entries.erase(entry);
+  }
+
+  static std::vector<iterator>
+  sortEntries(std::vector<IndexEntry>& indexEntries)
+  {
+    std::sort(indexEntries.begin(), indexEntries.end(),
+              [] (const IndexEntry& a, const IndexEntry& b) { return a.sequence < b.sequence; });
+    std::vector<iterator> entries;
+    entries.reserve(indexEntries.size());
+    for (const IndexEntry& indexEntry : indexEntries) {
+      entries.push_back(indexEntry.entry);
+    }
+    return entries;
+  }
+
+public:
+  /**
+   * @brief Signal to be fired when the table becomes empty
+   */
+  util::Signal<PendingInterestTable> onEmpty;
+
+private:
+  Base m_entries;
+  Node m_root;
+  std::unordered_multimap<uint32_t, IndexEntry> m_nonceIndex;
+  uint64_t m_nextSequence = 0;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
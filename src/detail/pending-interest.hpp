@@ -26,8 +26,7 @@
 #include "../interest.hpp"
 #include "../data.hpp"
 #include "../util/time.hpp"
-#include "../util/scheduler.hpp"
-#include "../util/scheduler-scoped-event-id.hpp"
+#include "../util/timing-wheel.hpp"
 #include "../lp/nack.hpp"
 
 namespace ndn {
@@ -42,25 +41,25 @@ public:
    * @param dataCallback function to call when matching Data packet is received
    * @param nackCallback function to call when Nack matching Interest is received
    * @param timeoutCallback function to call if Interest times out
-   * @param scheduler Scheduler instance to use to schedule a timeout event. The scheduled
-   *                  event will be automatically cancelled when pending Interest is destroyed.
+   * @param timingWheel TimingWheel instance to use to schedule the timeout. The timeout
+   *                    will be automatically cancelled when pending Interest is destroyed.
    */
   PendingInterest(shared_ptr<const Interest> interest,
                   const DataCallback& dataCallback,
                   const NackCallback& nackCallback,
                   const TimeoutCallback& timeoutCallback,
-                  Scheduler& scheduler)
+                  util::TimingWheel& timingWheel)
     : m_interest(interest)
     , m_dataCallback(dataCallback)
     , m_nackCallback(nackCallback)
     , m_timeoutCallback(timeoutCallback)
-    , m_timeoutEvent(scheduler)
+    , m_expressTime(time::steady_clock::now())
   {
-    m_timeoutEvent =
-      scheduler.scheduleEvent(m_interest->getInterestLifetime() > time::milliseconds::zero() ?
-                              m_interest->getInterestLifetime() :
-                              DEFAULT_INTEREST_LIFETIME,
-                              bind(&PendingInterest::invokeTimeoutCallback, this));
+    timingWheel.schedule(m_timeoutTimer,
+                         m_interest->getInterestLifetime() > time::milliseconds::zero() ?
+                         m_interest->getInterestLifetime() :
+                         DEFAULT_INTEREST_LIFETIME,
+                         bind(&PendingInterest::invokeTimeoutCallback, this));
   }
 
   /**
@@ -72,6 +71,15 @@ public:
     return m_interest;
   }
 
+  /**
+   * @return the time when the Interest was expressed
+   */
+  const time::steady_clock::TimePoint&
+  getExpressTime() const
+  {
+    return m_expressTime;
+  }
+
   /**
    * @brief invokes the DataCallback
    * @note If the DataCallback is an empty function, this method does nothing.
@@ -122,7 +130,8 @@ private:
   DataCallback m_dataCallback;
   NackCallback m_nackCallback;
   TimeoutCallback m_timeoutCallback;
-  util::scheduler::ScopedEventId m_timeoutEvent;
+  time::steady_clock::TimePoint m_expressTime;
+  util::TimingWheel::Timer m_timeoutTimer;
   std::function<void()> m_deleter;
 };
 
@@ -237,6 +237,27 @@ Face::getNPendingInterests() const
   return m_impl->m_pendingInterestTable.size();
 }
 
+void
+Face::setInterestLatencyTracker(shared_ptr<util::InterestLatencyTracker> tracker)
+{
+  m_ioService.post([=] { m_impl->m_latencyTracker = tracker; });
+}
+
+void
+Face::setInterestLifetimeAccuracy(const time::nanoseconds& accuracy)
+{
+  if (accuracy <= time::nanoseconds::zero()) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("Interest lifetime accuracy must be positive"));
+  }
+  m_ioService.post([=] { m_impl->m_timingWheel.setAccuracy(accuracy); });
+}
+
+void
+Face::setPacketCapture(shared_ptr<util::PacketCapture> capture)
+{
+  m_ioService.post([=] { m_impl->m_packetCapture = capture; });
+}
+
 const RegisteredPrefixId*
 Face::setInterestFilter(const InterestFilter& interestFilter,
                   const OnInterest& onInterest,
@@ -487,12 +508,20 @@ extractLpLocalFields(NETPKT& netPacket, const lp::Packet& lpPacket)
 void
 Face::onReceiveElement(const Block& blockFromDaemon)
 {
-  lp::Packet lpPacket(blockFromDaemon); // bare Interest/Data is a valid lp::Packet,
-                                        // no need to distinguish
+  lp::Packet lpPacket;
+  Block netPacket;
+  if (blockFromDaemon.type() == tlv::Interest || blockFromDaemon.type() == tlv::Data) {
+    // a bare Interest/Data has no lp fields
+    netPacket = blockFromDaemon;
+  }
+  else {
+    lpPacket.wireDecode(blockFromDaemon);
+    Buffer::const_iterator begin, end;
+    std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
+    // the fragment refers to the buffer of the received packet, without copying
+    netPacket = Block(blockFromDaemon, begin, end);
+  }
 
-  Buffer::const_iterator begin, end;
-  std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
-  Block netPacket(&*begin, std::distance(begin, end));
   switch (netPacket.type()) {
     case tlv::Interest: {
       shared_ptr<Interest> interest = make_shared<Interest>(netPacket);
@@ -501,11 +530,15 @@ Face::onReceiveElement(const Block& blockFromDaemon)
         nack->setHeader(lpPacket.get<lp::NackField>());
         extractLpLocalFields(*nack, lpPacket);
         NDN_CXX_LOG_DEBUG(">N " << nack->getInterest() << "~" << nack->getHeader().getReason());
+        m_impl->capturePacket(util::PacketCapture::Direction::INCOMING,
+                              nack->getInterest().getName(), blockFromDaemon);
         m_impl->nackPendingInterests(*nack);
       }
       else {
         extractLpLocalFields(*interest, lpPacket);
         NDN_CXX_LOG_DEBUG(">I " << *interest);
+        m_impl->capturePacket(util::PacketCapture::Direction::INCOMING,
+                              interest->getName(), blockFromDaemon);
         m_impl->processInterestFilters(*interest);
       }
       break;
@@ -514,6 +547,8 @@ Face::onReceiveElement(const Block& blockFromDaemon)
       shared_ptr<Data> data = make_shared<Data>(netPacket);
       extractLpLocalFields(*data, lpPacket);
       NDN_CXX_LOG_DEBUG(">D " << data->getName());
+      m_impl->capturePacket(util::PacketCapture::Direction::INCOMING,
+                            data->getName(), blockFromDaemon);
       m_impl->satisfyPendingInterests(*data);
       break;
     }
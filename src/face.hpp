@@ -61,13 +61,24 @@ namespace nfd {
 class Controller;
 }
 
+namespace util {
+class InterestLatencyTracker;
+class PacketCapture;
+}
+
 /**
  * @brief Callback called when expressed Interest gets satisfied with a Data packet
+ *
+ * @note A Data of at least MAX_NDN_PACKET_SIZE / 2 octets received by a stream transport
+ *       refers to the whole receive buffer of MAX_NDN_PACKET_SIZE octets without copying.
+ *       Keeping it, e.g., in a cache, keeps that buffer allocated.
  */
 typedef function<void(const Interest&, const Data&)> DataCallback;
 
 /**
  * @brief Callback called when Nack is sent in response to expressed Interest
+ *
+ * @note As with DataCallback, a large received packet refers to the whole receive buffer.
  */
 typedef function<void(const Interest&, const lp::Nack&)> NackCallback;
 
@@ -90,6 +101,9 @@ typedef function<void(const Interest&)> OnTimeout;
 
 /**
  * @brief Callback called when incoming Interest matches the specified InterestFilter
+ *
+ * @note As with DataCallback, a large received Interest refers to the whole receive buffer,
+ *       which a queue of retained Interests keeps allocated.
  */
 typedef function<void (const InterestFilter&, const Interest&)> OnInterest;
 
@@ -289,6 +303,42 @@ public: // consumer
   size_t
   getNPendingInterests() const;
 
+  /**
+   * @brief Record latencies of Interests into @p tracker
+   *
+   * Like other operations on the Face, the tracker is installed asynchronously, on the thread
+   * that processes events.  From then on, whenever a pending Interest is satisfied, nacked,
+   * or timed out, the time since it was expressed is recorded under the longest matching
+   * prefix tracked by @p tracker.  This includes Interests that were expressed earlier.
+   *
+   * @param tracker the tracker, or nullptr to stop recording
+   */
+  void
+  setInterestLatencyTracker(shared_ptr<util::InterestLatencyTracker> tracker);
+
+  /**
+   * @brief Set the accuracy of Interest lifetimes
+   *
+   * Pending Interests time out on a timing wheel whose ticks last @p accuracy, so that an
+   * Interest times out at most @p accuracy after its lifetime.  Coarser ticks mean fewer
+   * wakeups.  The default is 1 millisecond.
+   *
+   * @throw std::invalid_argument @p accuracy is not positive
+   */
+  void
+  setInterestLifetimeAccuracy(const time::nanoseconds& accuracy);
+
+  /**
+   * @brief Capture packets sent and received from now on into @p capture
+   *
+   * The wire encoding of each packet that passes the prefix filter of @p capture is queued
+   * without copying, and is written out by the writer thread of @p capture.
+   *
+   * @param capture the packet capture, or nullptr to stop capturing
+   */
+  void
+  setPacketCapture(shared_ptr<util::PacketCapture> capture);
+
 public: // producer
   /**
    * @brief Set InterestFilter to dispatch incoming matching interest to onInterest
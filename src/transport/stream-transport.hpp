@@ -41,6 +41,7 @@ public:
   StreamTransportImpl(BaseTransport& transport, boost::asio::io_service& ioService)
     : m_transport(transport)
     , m_socket(ioService)
+    , m_inputBuffer(make_shared<Buffer>(MAX_NDN_PACKET_SIZE))
     , m_inputBufferSize(0)
     , m_connectionInProgress(false)
     , m_connectTimer(ioService)
@@ -141,7 +142,10 @@ public:
       {
         m_transport.m_isExpectingData = true;
         m_inputBufferSize = 0;
-        m_socket.async_receive(boost::asio::buffer(m_inputBuffer, MAX_NDN_PACKET_SIZE), 0,
+        if (m_inputBuffer.use_count() > 1) {
+          this->replaceInputBuffer();
+        }
+        m_socket.async_receive(boost::asio::buffer(m_inputBuffer->buf(), MAX_NDN_PACKET_SIZE), 0,
                                bind(&Impl::handleAsyncReceive, this, _1, _2));
       }
   }
@@ -209,18 +213,40 @@ public:
     }
   }
 
+  /**
+   * @brief deliver the complete TLV elements in the first @p nBytesAvailable bytes of @p buffer,
+   *        starting from @p offset
+   *
+   * An element of at least MIN_UNCOPIED_SIZE octets is delivered as a Block that refers to
+   * @p buffer without copying.  A smaller element is copied into a buffer of its own size, so
+   * that a receiver retaining a packet pins at most twice its size, and @p buffer can return to
+   * the pool.
+   *
+   * @return whether all bytes were delivered; @p offset is advanced past the delivered elements
+   */
   bool
-  processAll(uint8_t* buffer, size_t& offset, size_t nBytesAvailable)
+  processAll(const ConstBufferPtr& buffer, size_t& offset, size_t nBytesAvailable)
   {
+    Buffer::const_iterator end = buffer->begin() + nBytesAvailable;
     while (offset < nBytesAvailable) {
-      bool isOk = false;
-      Block element;
-      std::tie(isOk, element) = Block::fromBuffer(buffer + offset, nBytesAvailable - offset);
-      if (!isOk)
+      Buffer::const_iterator begin = buffer->begin() + offset;
+      Buffer::const_iterator valueBegin = begin;
+      uint32_t type = 0;
+      uint64_t length = 0;
+      if (!tlv::readType(valueBegin, end, type) ||
+          !tlv::readVarNumber(valueBegin, end, length) ||
+          length > static_cast<uint64_t>(end - valueBegin))
         return false;
 
-      m_transport.receive(element);
-      offset += element.size();
+      Buffer::const_iterator elementEnd = valueBegin + length;
+      size_t elementSize = elementEnd - begin;
+      offset += elementSize;
+      if (elementSize < MIN_UNCOPIED_SIZE) {
+        m_transport.receive(Block(&*begin, elementSize));
+      }
+      else {
+        m_transport.receive(Block(buffer, type, begin, elementEnd, valueBegin, elementEnd));
+      }
     }
     return true;
   }
@@ -254,29 +280,65 @@ public:
 
     if (offset > 0)
       {
-        if (offset != m_inputBufferSize)
+        if (m_inputBuffer.use_count() > 1)
           {
-            std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize,
-                      m_inputBuffer);
-            m_inputBufferSize -= offset;
+            // delivered Blocks still refer to the buffer: continue in another one
+            BufferPtr previous = m_inputBuffer;
+            this->replaceInputBuffer();
+            std::copy(previous->begin() + offset, previous->begin() + m_inputBufferSize,
+                      m_inputBuffer->begin());
           }
-        else
+        else if (offset != m_inputBufferSize)
           {
-            m_inputBufferSize = 0;
+            std::copy(m_inputBuffer->begin() + offset, m_inputBuffer->begin() + m_inputBufferSize,
+                      m_inputBuffer->begin());
           }
+        m_inputBufferSize -= offset;
       }
 
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
+    m_socket.async_receive(boost::asio::buffer(m_inputBuffer->buf() + m_inputBufferSize,
                                                MAX_NDN_PACKET_SIZE - m_inputBufferSize), 0,
                            bind(&Impl::handleAsyncReceive, this, _1, _2));
   }
 
+private:
+  /**
+   * @brief switch m_inputBuffer to a buffer that no Block refers to
+   *
+   * The current buffer is kept in the pool, and is reused once the Blocks referring to it are
+   * destroyed.  If the pool is full, the oldest buffer in the pool is left to its Blocks.
+   */
+  void
+  replaceInputBuffer()
+  {
+    BufferPtr previous = std::move(m_inputBuffer);
+    for (auto i = m_bufferPool.begin(); i != m_bufferPool.end(); ++i) {
+      if (i->use_count() == 1) {
+        m_inputBuffer = std::move(*i);
+        m_bufferPool.erase(i);
+        break;
+      }
+    }
+    if (m_inputBuffer == nullptr) {
+      m_inputBuffer = make_shared<Buffer>(MAX_NDN_PACKET_SIZE);
+    }
+
+    if (m_bufferPool.size() == MAX_POOLED_BUFFERS) {
+      m_bufferPool.erase(m_bufferPool.begin());
+    }
+    m_bufferPool.push_back(std::move(previous));
+  }
+
 protected:
   BaseTransport& m_transport;
 
   typename Protocol::socket m_socket;
-  uint8_t m_inputBuffer[MAX_NDN_PACKET_SIZE];
+  BufferPtr m_inputBuffer; ///< received elements are delivered as Blocks referring to it
   size_t m_inputBufferSize;
+  std::vector<BufferPtr> m_bufferPool; ///< input buffers that Blocks may still refer to
+  static const size_t MAX_POOLED_BUFFERS = 8;
+  /// received elements smaller than this are delivered as copies
+  static const size_t MIN_UNCOPIED_SIZE = MAX_NDN_PACKET_SIZE / 2;
 
   TransmissionQueue m_transmissionQueue;
   bool m_connectionInProgress;
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_DETAIL_SPSC_RING_BUFFER_HPP
+#define NDN_UTIL_DETAIL_SPSC_RING_BUFFER_HPP
+
+#include "../../common.hpp"
+
+#include <atomic>
+
+namespace ndn {
+namespace util {
+namespace detail {
+
+/** \return the smallest power of two that is not less than \p n
+ */
+inline size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t result = 1;
+  while (result < n) {
+    result <<= 1;
+  }
+  return result;
+}
+
+/** \brief a bounded lock-free queue with one producer thread and one consumer thread
+ *
+ *  Slots are preallocated at construction.  tryPush may only be invoked by the producer;
+ *  front, pop, and consume may only be invoked by the consumer.
+ */
+template<typename T>
+class SpscRingBuffer : noncopyable
+{
+public:
+  /** \param capacity maximum number of items; rounded up to a power of two
+   */
+  explicit
+  SpscRingBuffer(size_t capacity)
+    : m_capacity(roundUpToPowerOfTwo(capacity))
+    , m_mask(m_capacity - 1)
+    , m_slots(new Slot[m_capacity])
+    , m_head(0)
+    , m_cachedTail(0)
+    , m_tail(0)
+    , m_cachedHead(0)
+  {
+  }
+
+  ~SpscRingBuffer()
+  {
+    while (this->front() != nullptr) {
+      this->pop();
+    }
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_capacity;
+  }
+
+  /** \return number of queued items
+   *  \note The result is approximate when invoked concurrently with the producer or consumer.
+   */
+  size_t
+  size() const
+  {
+    return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+  }
+
+  bool
+  empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /** \brief append \p item, unless the ring is full
+   *  \return whether \p item has been appended
+   */
+  bool
+  tryPush(T&& item)
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cachedHead == m_capacity) {
+      m_cachedHead = m_head.load(std::memory_order_acquire);
+      if (tail - m_cachedHead == m_capacity) {
+        return false;
+      }
+    }
+
+    new (&m_slots[tail & m_mask]) T(std::move(item));
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** \return the oldest item, or nullptr if the ring is empty
+   */
+  T*
+  front()
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_cachedTail) {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+      if (head == m_cachedTail) {
+        return nullptr;
+      }
+    }
+    return reinterpret_cast<T*>(&m_slots[head & m_mask]);
+  }
+
+  /** \brief remove the oldest item
+   *  \pre front() != nullptr
+   */
+  void
+  pop()
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    reinterpret_cast<T*>(&m_slots[head & m_mask])->~T();
+    m_head.store(head + 1, std::memory_order_release);
+  }
+
+  /** \brief invoke \p f on each queued item in order, then remove it
+   *  \return number of consumed items
+   */
+  template<typename F>
+  size_t
+  consume(const F& f, size_t limit = std::numeric_limits<size_t>::max())
+  {
+    size_t nConsumed = 0;
+    for (T* item = this->front(); item != nullptr && nConsumed < limit; item = this->front()) {
+      f(*item);
+      this->pop();
+      ++nConsumed;
+    }
+    return nConsumed;
+  }
+
+private:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+  const size_t m_capacity;
+  const size_t m_mask;
+  unique_ptr<Slot[]> m_slots;
+
+  // consumer-owned and producer-owned indices are padded onto separate cache lines
+  char m_pad0[CACHE_LINE_SIZE];
+  std::atomic<size_t> m_head;
+  size_t m_cachedTail;
+  char m_pad1[CACHE_LINE_SIZE];
+  std::atomic<size_t> m_tail;
+  size_t m_cachedHead;
+  char m_pad2[CACHE_LINE_SIZE];
+};
+
+} // namespace detail
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_DETAIL_SPSC_RING_BUFFER_HPP
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "interest-latency-tracker.hpp"
+#include "logger.hpp"
+
+namespace ndn {
+namespace util {
+
+NDN_CXX_LOG_INIT(InterestLatencyTracker);
+
+InterestLatencyTracker::InterestLatencyTracker(const std::vector<Name>& prefixes)
+  : m_logSummaryInterval(time::nanoseconds::zero())
+{
+  for (const Name& prefix : prefixes) {
+    if (m_statistics.count(prefix) > 0) {
+      continue;
+    }
+    m_statistics[prefix] = make_unique<PrefixStatistics>();
+    m_prefixLengths.push_back(prefix.size());
+  }
+
+  std::sort(m_prefixLengths.begin(), m_prefixLengths.end(), std::greater<size_t>());
+  m_prefixLengths.erase(std::unique(m_prefixLengths.begin(), m_prefixLengths.end()),
+                        m_prefixLengths.end());
+}
+
+std::vector<Name>
+InterestLatencyTracker::getPrefixes() const
+{
+  std::vector<Name> prefixes;
+  for (const auto& entry : m_statistics) {
+    prefixes.push_back(entry.first);
+  }
+  return prefixes;
+}
+
+const InterestLatencyTracker::PrefixStatistics*
+InterestLatencyTracker::getStatistics(const Name& prefix) const
+{
+  auto it = m_statistics.find(prefix);
+  return it == m_statistics.end() ? nullptr : it->second.get();
+}
+
+InterestLatencyTracker::PrefixStatistics*
+InterestLatencyTracker::findLongestPrefix(const Name& name)
+{
+  for (size_t length : m_prefixLengths) {
+    if (length > name.size()) {
+      continue;
+    }
+    auto it = m_statistics.find(name.getPrefix(length));
+    if (it != m_statistics.end()) {
+      return it->second.get();
+    }
+  }
+  return nullptr;
+}
+
+void
+InterestLatencyTracker::recordData(const Name& interestName, time::nanoseconds latency)
+{
+  PrefixStatistics* statistics = this->findLongestPrefix(interestName);
+  if (statistics != nullptr) {
+    statistics->rtt.record(latency);
+  }
+}
+
+void
+InterestLatencyTracker::recordNack(const Name& interestName, time::nanoseconds latency)
+{
+  PrefixStatistics* statistics = this->findLongestPrefix(interestName);
+  if (statistics != nullptr) {
+    statistics->nack.record(latency);
+  }
+}
+
+void
+InterestLatencyTracker::recordTimeout(const Name& interestName, time::nanoseconds latency)
+{
+  PrefixStatistics* statistics = this->findLongestPrefix(interestName);
+  if (statistics != nullptr) {
+    statistics->timeout.record(latency);
+  }
+}
+
+void
+InterestLatencyTracker::printSummary(std::ostream& os) const
+{
+  for (const auto& entry : m_statistics) {
+    os << entry.first << " rtt(" << entry.second->rtt << ")"
+       << " nack(" << entry.second->nack << ")"
+       << " timeout(" << entry.second->timeout << ")\n";
+  }
+}
+
+void
+InterestLatencyTracker::enableLogSummary(boost::asio::io_service& ioService,
+                                         time::nanoseconds interval)
+{
+  this->disableLogSummary();
+  m_scheduler = make_unique<Scheduler>(ioService);
+  m_logSummaryEvent = make_unique<scheduler::ScopedEventId>(*m_scheduler);
+  m_logSummaryInterval = interval;
+  *m_logSummaryEvent = m_scheduler->scheduleEvent(interval, [this] { this->logSummary(); });
+}
+
+void
+InterestLatencyTracker::disableLogSummary()
+{
+  m_logSummaryEvent.reset();
+  m_scheduler.reset();
+}
+
+void
+InterestLatencyTracker::logSummary()
+{
+  for (const auto& entry : m_statistics) {
+    NDN_CXX_LOG_INFO(entry.first << " rtt(" << entry.second->rtt << ")"
+                     << " nack(" << entry.second->nack << ")"
+                     << " timeout(" << entry.second->timeout << ")");
+  }
+
+  *m_logSummaryEvent = m_scheduler->scheduleEvent(m_logSummaryInterval,
+                                                  [this] { this->logSummary(); });
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_INTEREST_LATENCY_TRACKER_HPP
+#define NDN_UTIL_INTEREST_LATENCY_TRACKER_HPP
+
+#include "latency-histogram.hpp"
+#include "scheduler.hpp"
+#include "scheduler-scoped-event-id.hpp"
+#include "../name.hpp"
+
+#include <map>
+
+namespace ndn {
+namespace util {
+
+/** \brief records the lifecycle latencies of Interests expressed by a Face, per name prefix
+ *
+ *  A tracker is attached to a Face with Face::setInterestLatencyTracker.  For each Interest
+ *  expressed by the Face, the time until it is satisfied, nacked, or timed out is recorded in
+ *  the histograms of the longest tracked prefix of the Interest name.  Interests that are not
+ *  under any tracked prefix are not recorded; track "/" to record all Interests.
+ *
+ *  The set of prefixes is fixed upon construction, so that histograms can be read on another
+ *  thread while the Face is recording into them.
+ */
+class InterestLatencyTracker : noncopyable
+{
+public:
+  class PrefixStatistics : noncopyable
+  {
+  public:
+    LatencyHistogram rtt;     ///< time from expressing an Interest to receiving Data
+    LatencyHistogram nack;    ///< time from expressing an Interest to receiving a Nack
+    LatencyHistogram timeout; ///< time from expressing an Interest to its timeout
+  };
+
+  explicit
+  InterestLatencyTracker(const std::vector<Name>& prefixes);
+
+  std::vector<Name>
+  getPrefixes() const;
+
+  /** \return statistics of a tracked \p prefix, or nullptr if \p prefix is not tracked
+   */
+  const PrefixStatistics*
+  getStatistics(const Name& prefix) const;
+
+  void
+  recordData(const Name& interestName, time::nanoseconds latency);
+
+  void
+  recordNack(const Name& interestName, time::nanoseconds latency);
+
+  void
+  recordTimeout(const Name& interestName, time::nanoseconds latency);
+
+  /** \brief print the histograms of every prefix, one prefix per line
+   */
+  void
+  printSummary(std::ostream& os) const;
+
+  /** \brief log the histograms of every prefix at INFO level every \p interval, in module
+   *         InterestLatencyTracker
+   *
+   *  The summary is logged from \p ioService, which should be the io_service of the Face.
+   *  This must be invoked on the thread that runs \p ioService, or before it is run.
+   */
+  void
+  enableLogSummary(boost::asio::io_service& ioService, time::nanoseconds interval);
+
+  void
+  disableLogSummary();
+
+private:
+  /** \return statistics of the longest tracked prefix of \p name, or nullptr
+   */
+  PrefixStatistics*
+  findLongestPrefix(const Name& name);
+
+  void
+  logSummary();
+
+private:
+  std::map<Name, unique_ptr<PrefixStatistics>> m_statistics;
+  std::vector<size_t> m_prefixLengths; ///< lengths of tracked prefixes, longest first
+
+  unique_ptr<Scheduler> m_scheduler;
+  unique_ptr<scheduler::ScopedEventId> m_logSummaryEvent;
+  time::nanoseconds m_logSummaryInterval;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_INTEREST_LATENCY_TRACKER_HPP
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "latency-histogram.hpp"
+
+#include <cmath>
+
+namespace ndn {
+namespace util {
+
+const int LatencyHistogram::SUB_BUCKET_BITS;
+const uint64_t LatencyHistogram::N_SUB_BUCKETS;
+const int LatencyHistogram::MAX_MAGNITUDE;
+const size_t LatencyHistogram::N_BUCKETS;
+
+LatencyHistogram::LatencyHistogram()
+{
+  this->reset();
+}
+
+void
+LatencyHistogram::record(time::nanoseconds latency)
+{
+  uint64_t microseconds = static_cast<uint64_t>(std::max<time::microseconds::rep>(
+                            time::duration_cast<time::microseconds>(latency).count(), 0));
+
+  m_buckets[getBucketIndex(microseconds)].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_sum.fetch_add(microseconds, std::memory_order_relaxed);
+
+  uint64_t max = m_max.load(std::memory_order_relaxed);
+  while (microseconds > max &&
+         !m_max.compare_exchange_weak(max, microseconds, std::memory_order_relaxed)) {
+  }
+}
+
+time::microseconds
+LatencyHistogram::getMean() const
+{
+  uint64_t count = m_count.load(std::memory_order_relaxed);
+  if (count == 0) {
+    return time::microseconds::zero();
+  }
+  return time::microseconds(m_sum.load(std::memory_order_relaxed) / count);
+}
+
+time::microseconds
+LatencyHistogram::getPercentile(double percentile) const
+{
+  uint64_t count = m_count.load(std::memory_order_relaxed);
+  if (count == 0) {
+    return time::microseconds::zero();
+  }
+
+  uint64_t rank = static_cast<uint64_t>(std::ceil(count * std::min(std::max(percentile, 0.0),
+                                                                   100.0) / 100.0));
+  rank = std::max<uint64_t>(rank, 1);
+
+  uint64_t cumulativeCount = 0;
+  for (size_t i = 0; i < N_BUCKETS; ++i) {
+    cumulativeCount += m_buckets[i].load(std::memory_order_relaxed);
+    if (cumulativeCount >= rank && i < N_BUCKETS - 1) {
+      return std::min(time::microseconds(getBucketUpperBound(i)), this->getMax());
+    }
+  }
+  // the last bucket has no upper bound; also, samples recorded concurrently may be counted
+  // in m_count but not yet in a bucket
+  return this->getMax();
+}
+
+void
+LatencyHistogram::reset()
+{
+  for (std::atomic<uint64_t>& bucket : m_buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  m_count.store(0, std::memory_order_relaxed);
+  m_sum.store(0, std::memory_order_relaxed);
+  m_max.store(0, std::memory_order_relaxed);
+}
+
+size_t
+LatencyHistogram::getBucketIndex(uint64_t microseconds)
+{
+  // latencies below 2 * N_SUB_BUCKETS have one bucket each
+  if (microseconds < 2 * N_SUB_BUCKETS) {
+    return static_cast<size_t>(microseconds);
+  }
+
+  // otherwise, the bucket is determined by the magnitude and the SUB_BUCKET_BITS bits below
+  // the most significant bit
+  int magnitude = 63 - __builtin_clzll(microseconds);
+  if (magnitude >= MAX_MAGNITUDE) {
+    return N_BUCKETS - 1;
+  }
+  int shift = magnitude - SUB_BUCKET_BITS;
+  return static_cast<size_t>(shift * N_SUB_BUCKETS + (microseconds >> shift));
+}
+
+uint64_t
+LatencyHistogram::getBucketUpperBound(size_t index)
+{
+  if (index < 2 * N_SUB_BUCKETS) {
+    return index;
+  }
+
+  int shift = static_cast<int>(index / N_SUB_BUCKETS) - 1;
+  uint64_t subBucket = index % N_SUB_BUCKETS + N_SUB_BUCKETS;
+  return ((subBucket + 1) << shift) - 1;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LatencyHistogram& histogram)
+{
+  return os << "count=" << histogram.getCount()
+            << " mean=" << histogram.getMean().count() << "us"
+            << " p50=" << histogram.getPercentile(50).count() << "us"
+            << " p90=" << histogram.getPercentile(90).count() << "us"
+            << " p99=" << histogram.getPercentile(99).count() << "us"
+            << " max=" << histogram.getMax().count() << "us";
+}
+
+} // namespace util
+} // namespace ndn
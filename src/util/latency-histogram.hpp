@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LATENCY_HISTOGRAM_HPP
+#define NDN_UTIL_LATENCY_HISTOGRAM_HPP
+
+#include "../common.hpp"
+#include "time.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace ndn {
+namespace util {
+
+/** \brief a histogram of latencies with log-linear buckets
+ *
+ *  Like an HDR histogram, latencies are counted in buckets whose width doubles every 16 buckets,
+ *  so that a percentile is reported with a relative error below 1/16 (6.25%), in microseconds,
+ *  for latencies from 1 microsecond to 19 hours.  Longer latencies are counted in the last
+ *  bucket.
+ *
+ *  record() is lock-free and may be invoked concurrently with itself and with the getters,
+ *  so that a histogram can be read on another thread while it is being updated.
+ */
+class LatencyHistogram : noncopyable
+{
+public:
+  LatencyHistogram();
+
+  /** \brief count a sample of \p latency
+   */
+  void
+  record(time::nanoseconds latency);
+
+  /** \return number of samples
+   */
+  uint64_t
+  getCount() const
+  {
+    return m_count.load(std::memory_order_relaxed);
+  }
+
+  /** \return mean latency, or zero if there is no sample
+   */
+  time::microseconds
+  getMean() const;
+
+  /** \return maximum latency, or zero if there is no sample
+   */
+  time::microseconds
+  getMax() const
+  {
+    return time::microseconds(m_max.load(std::memory_order_relaxed));
+  }
+
+  /** \return the latency that is greater than or equal to \p percentile percent of samples,
+   *          or zero if there is no sample
+   *  \param percentile a number between 0 and 100
+   */
+  time::microseconds
+  getPercentile(double percentile) const;
+
+  /** \brief remove all samples
+   *  \note Samples recorded concurrently may be partially removed.
+   */
+  void
+  reset();
+
+private:
+  static size_t
+  getBucketIndex(uint64_t microseconds);
+
+  /** \return the largest latency in microseconds counted in the bucket at \p index
+   */
+  static uint64_t
+  getBucketUpperBound(size_t index);
+
+private:
+  static const int SUB_BUCKET_BITS = 4;
+  static const uint64_t N_SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static const int MAX_MAGNITUDE = 36; ///< latencies below 2^36 microseconds are distinguished
+  static const size_t N_BUCKETS = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * N_SUB_BUCKETS;
+
+  std::array<std::atomic<uint64_t>, N_BUCKETS> m_buckets;
+  std::atomic<uint64_t> m_count;
+  std::atomic<uint64_t> m_sum; ///< in microseconds
+  std::atomic<uint64_t> m_max; ///< in microseconds
+};
+
+/** \brief print count, mean, 50th, 90th, and 99th percentiles, and maximum of \p histogram
+ */
+std::ostream&
+operator<<(std::ostream& os, const LatencyHistogram& histogram);
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LATENCY_HISTOGRAM_HPP
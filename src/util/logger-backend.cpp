@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-backend.hpp"
+
+#include <boost/log/attributes/attribute_value_impl.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+
+namespace ndn {
+namespace util {
+
+LoggerBackend::~LoggerBackend() = default;
+
+std::map<std::string, uint64_t>
+LoggerBackend::getNDroppedByModule() const
+{
+  return {};
+}
+
+/** \brief a Boost.Log sink backend that writes LogRecords to a LogSink
+ */
+class BoostLoggerBackend::SinkAdapter
+  : public boost::log::sinks::basic_sink_backend<
+      boost::log::sinks::combine_requirements<boost::log::sinks::synchronized_feeding,
+                                              boost::log::sinks::flushing>::type>
+{
+public:
+  SinkAdapter(shared_ptr<LogSink> sink, const boost::log::attribute_name& recordAttribute,
+              size_t maxBatchSize)
+    : m_sink(std::move(sink))
+    , m_recordAttribute(recordAttribute)
+    , m_maxBatchSize(maxBatchSize)
+    , m_nUnflushed(0)
+    , m_nWritten(0)
+  {
+  }
+
+  void
+  consume(const boost::log::record_view& rec)
+  {
+    auto record = boost::log::extract<LogRecord>(m_recordAttribute, rec);
+    if (record) {
+      m_sink->write(record.get());
+      m_nWritten.fetch_add(1, std::memory_order_relaxed);
+      if (++m_nUnflushed >= m_maxBatchSize) {
+        this->flush();
+      }
+    }
+  }
+
+  void
+  flush()
+  {
+    if (m_nUnflushed > 0) {
+      m_sink->flush();
+      m_nUnflushed = 0;
+    }
+  }
+
+  uint64_t
+  getNWritten() const
+  {
+    return m_nWritten.load(std::memory_order_relaxed);
+  }
+
+private:
+  shared_ptr<LogSink> m_sink;
+  boost::log::attribute_name m_recordAttribute;
+  const size_t m_maxBatchSize;
+  size_t m_nUnflushed;
+  std::atomic<uint64_t> m_nWritten;
+};
+
+BoostLoggerBackend::Options::Options()
+  : maxBatchSize(1024)
+  , maxDelay(time::milliseconds(1))
+{
+}
+
+BoostLoggerBackend::BoostLoggerBackend(const Options& options)
+  : m_options(options)
+  , m_recordAttribute("NdnCxxLogRecord")
+  , m_isFlusherIdle(false)
+  , m_shouldStop(false)
+{
+  BOOST_ASSERT(m_options.maxBatchSize > 0);
+  m_flusher = std::thread(&BoostLoggerBackend::runFlusher, this);
+}
+
+BoostLoggerBackend::~BoostLoggerBackend()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_flusherMutex);
+    m_shouldStop = true;
+  }
+  m_flusherCv.notify_one();
+  m_flusher.join();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_sink != nullptr) {
+    boost::log::core::get()->remove_sink(m_sink);
+    m_sink->flush();
+  }
+}
+
+void
+BoostLoggerBackend::log(LogRecord&& record)
+{
+  // the record is attached unformatted, and is rendered on the flusher thread
+  Logger& logger = record.getLogger();
+  boost::log::record rec = logger.open_record();
+  if (!rec) {
+    return;
+  }
+  rec.attribute_values().insert(m_recordAttribute,
+                                boost::log::attributes::make_attribute_value(std::move(record)));
+  logger.push_record(boost::move(rec));
+
+  // pairs with the fence in runFlusher, so that either the flusher sees this record before
+  // going idle, or this thread sees that the flusher is idle
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_isFlusherIdle.load(std::memory_order_relaxed) &&
+      m_isFlusherIdle.exchange(false, std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(m_flusherMutex);
+    m_flusherCv.notify_one();
+  }
+}
+
+void
+BoostLoggerBackend::setSink(shared_ptr<LogSink> sink)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_sink != nullptr) {
+    boost::log::core::get()->remove_sink(m_sink);
+    m_sink->flush();
+    m_sink.reset();
+  }
+
+  m_adapter = boost::make_shared<SinkAdapter>(std::move(sink), m_recordAttribute,
+                                              m_options.maxBatchSize);
+  // records are fed by the flusher thread, rather than by a dedicated thread of the frontend
+  m_sink = boost::make_shared<Sink>(m_adapter, false);
+  boost::log::core::get()->add_sink(m_sink);
+}
+
+void
+BoostLoggerBackend::flush()
+{
+  this->drain();
+}
+
+bool
+BoostLoggerBackend::drain()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_sink == nullptr) {
+    return false;
+  }
+
+  uint64_t nWritten = m_adapter->getNWritten();
+  // feeds all queued records to the adapter, and then flushes the adapter
+  m_sink->flush();
+  return m_adapter->getNWritten() != nWritten;
+}
+
+void
+BoostLoggerBackend::runFlusher()
+{
+  std::unique_lock<std::mutex> lock(m_flusherMutex);
+  while (!m_shouldStop) {
+    lock.unlock();
+    bool hasWritten = this->drain();
+    if (!hasWritten) {
+      // announce going idle, then check once more for a record queued in the meantime
+      m_isFlusherIdle.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (this->drain()) {
+        hasWritten = true;
+        m_isFlusherIdle.store(false, std::memory_order_relaxed);
+      }
+    }
+    lock.lock();
+
+    if (hasWritten) {
+      m_flusherCv.wait_for(lock, std::chrono::milliseconds(m_options.maxDelay.count()),
+                           [this] { return m_shouldStop; });
+    }
+    else {
+      m_flusherCv.wait(lock, [this] {
+        return !m_isFlusherIdle.load(std::memory_order_relaxed) || m_shouldStop;
+      });
+    }
+  }
+}
+
+} // namespace util
+} // namespace ndn
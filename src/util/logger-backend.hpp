@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_BACKEND_HPP
+#define NDN_UTIL_LOGGER_BACKEND_HPP
+
+#include "../common.hpp"
+#include "logger-sink.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <boost/log/attributes/attribute_name.hpp>
+#include <boost/log/sinks.hpp>
+
+namespace ndn {
+namespace util {
+
+/** \brief delivers log records from log statements to the LogSink
+ *
+ *  A backend is selected with LoggerFactory::setBackend.
+ *  Its log() method is invoked on the thread that executes the log statement.
+ */
+class LoggerBackend : noncopyable
+{
+public:
+  virtual
+  ~LoggerBackend();
+
+  /** \brief accept a record from a log statement
+   *  \note This function must be thread-safe.
+   */
+  virtual void
+  log(LogRecord&& record) = 0;
+
+  /** \brief change the sink where records are written
+   *
+   *  Records accepted before this call are written to the previous sink.
+   */
+  virtual void
+  setSink(shared_ptr<LogSink> sink) = 0;
+
+  /** \brief write out all accepted records, and flush the sink
+   */
+  virtual void
+  flush() = 0;
+
+  /** \return number of records dropped by the backend, per module name
+   *
+   *  The default implementation returns an empty map, which suits a backend that never drops
+   *  records or cannot attribute drops to modules.
+   */
+  virtual std::map<std::string, uint64_t>
+  getNDroppedByModule() const;
+};
+
+/** \brief a LoggerBackend that forwards records into Boost.Log core
+ *
+ *  Each record is pushed through the Logger's own boost::log::sources::logger_mt into an
+ *  asynchronous sink with an unbounded queue.  A flusher thread drains the queue in batches:
+ *  it writes all queued records to the LogSink and flushes the sink once per batch, at most
+ *  maxDelay after a record is queued.  While no records arrive, the flusher thread sleeps
+ *  until the next one.
+ *  This is the default backend.
+ */
+class BoostLoggerBackend : public LoggerBackend
+{
+public:
+  struct Options
+  {
+    Options();
+
+    size_t maxBatchSize;         ///< the sink is flushed after at most this many records
+    time::milliseconds maxDelay; ///< interval at which the flusher thread drains the queue
+  };
+
+  explicit
+  BoostLoggerBackend(const Options& options = Options());
+
+  ~BoostLoggerBackend() NDN_CXX_DECL_OVERRIDE;
+
+  void
+  log(LogRecord&& record) NDN_CXX_DECL_OVERRIDE;
+
+  void
+  setSink(shared_ptr<LogSink> sink) NDN_CXX_DECL_OVERRIDE;
+
+  void
+  flush() NDN_CXX_DECL_OVERRIDE;
+
+private:
+  class SinkAdapter;
+
+  void
+  runFlusher();
+
+  /** \brief write all queued records to the sink and flush it
+   *  \return whether any record was written
+   */
+  bool
+  drain();
+
+private:
+  const Options m_options;
+
+  /** \brief name of the Boost.Log attribute that carries the LogRecord
+   */
+  const boost::log::attribute_name m_recordAttribute;
+
+  std::mutex m_mutex;
+
+  typedef boost::log::sinks::asynchronous_sink<SinkAdapter> Sink;
+  boost::shared_ptr<SinkAdapter> m_adapter;
+  boost::shared_ptr<Sink> m_sink;
+
+  std::mutex m_flusherMutex;
+  std::condition_variable m_flusherCv;
+  std::atomic<bool> m_isFlusherIdle; ///< the flusher waits for a record instead of maxDelay
+  bool m_shouldStop;
+  std::thread m_flusher;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_BACKEND_HPP
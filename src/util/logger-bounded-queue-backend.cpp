@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-bounded-queue-backend.hpp"
+
+namespace ndn {
+namespace util {
+
+BoundedQueueLoggerBackend::Options::Options()
+  : capacity(65536)
+  , overflowPolicy(OverflowPolicy::DROP_NEWEST)
+  , dropLevel(LogLevel::INFO)
+{
+}
+
+BoundedQueueLoggerBackend::ModuleStatistics::ModuleStatistics()
+  : nEnqueued(0)
+  , nDropped(0)
+  , highWatermark(0)
+{
+}
+
+BoundedQueueLoggerBackend::Counters::Counters()
+  : nQueued(0)
+{
+}
+
+BoundedQueueLoggerBackend::BoundedQueueLoggerBackend(const Options& options)
+  : m_options(options)
+  , m_nEnqueued(0)
+  , m_nDropped(0)
+  , m_nWritten(0)
+  , m_highWatermark(0)
+  , m_shouldStop(false)
+{
+  BOOST_ASSERT(m_options.capacity > 0);
+
+  m_sink = make_shared<NullLogSink>();
+
+  m_writer = std::thread(&BoundedQueueLoggerBackend::runWriter, this);
+}
+
+BoundedQueueLoggerBackend::~BoundedQueueLoggerBackend()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_shouldStop = true;
+  }
+  m_hasRecords.notify_one();
+  m_hasSpace.notify_all();
+  m_writer.join();
+
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  this->drain();
+}
+
+void
+BoundedQueueLoggerBackend::log(LogRecord&& record)
+{
+  const Logger* logger = &record.getLogger();
+
+  std::unique_lock<std::mutex> lock(m_queueMutex);
+  Counters& counters = m_counters[logger];
+
+  if (m_queue.size() >= m_options.capacity) {
+    bool shouldDrop = false;
+    switch (m_options.overflowPolicy) {
+    case OverflowPolicy::BLOCK:
+      break;
+    case OverflowPolicy::DROP_NEWEST:
+      shouldDrop = true;
+      break;
+    case OverflowPolicy::DROP_OLDEST:
+      this->dropOldest();
+      break;
+    case OverflowPolicy::DROP_BELOW_LEVEL:
+      shouldDrop = record.getLevel() > m_options.dropLevel;
+      break;
+    }
+
+    if (shouldDrop) {
+      ++counters.statistics.nDropped;
+      ++m_nDropped;
+      return;
+    }
+
+    m_hasSpace.wait(lock, [this] { return m_queue.size() < m_options.capacity || m_shouldStop; });
+  }
+
+  m_queue.push_back(std::move(record));
+  ++counters.nQueued;
+  ++counters.statistics.nEnqueued;
+  counters.statistics.highWatermark = std::max(counters.statistics.highWatermark,
+                                               counters.nQueued);
+  ++m_nEnqueued;
+  m_highWatermark = std::max(m_highWatermark, m_queue.size());
+
+  bool wasEmpty = m_queue.size() == 1;
+  lock.unlock();
+  if (wasEmpty) {
+    m_hasRecords.notify_one();
+  }
+}
+
+void
+BoundedQueueLoggerBackend::dropOldest()
+{
+  Counters& counters = m_counters[&m_queue.front().getLogger()];
+  --counters.nQueued;
+  ++counters.statistics.nDropped;
+  ++m_nDropped;
+  m_queue.pop_front();
+}
+
+void
+BoundedQueueLoggerBackend::setSink(shared_ptr<LogSink> sink)
+{
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  this->drain();
+  m_sink = std::move(sink);
+}
+
+void
+BoundedQueueLoggerBackend::flush()
+{
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  this->drain();
+}
+
+BoundedQueueLoggerBackend::Statistics
+BoundedQueueLoggerBackend::getStatistics() const
+{
+  Statistics st;
+  std::lock_guard<std::mutex> lock(m_queueMutex);
+  st.nEnqueued = m_nEnqueued;
+  st.nDropped = m_nDropped;
+  st.nWritten = m_nWritten;
+  st.highWatermark = m_highWatermark;
+
+  for (const auto& entry : m_counters) {
+    // loggers of the same module are summed, except for their high watermarks
+    ModuleStatistics& module = st.modules[entry.first->getModuleName()];
+    module.nEnqueued += entry.second.statistics.nEnqueued;
+    module.nDropped += entry.second.statistics.nDropped;
+    module.highWatermark = std::max(module.highWatermark, entry.second.statistics.highWatermark);
+  }
+  return st;
+}
+
+std::map<std::string, uint64_t>
+BoundedQueueLoggerBackend::getNDroppedByModule() const
+{
+  std::map<std::string, uint64_t> nDropped;
+  for (const auto& module : this->getStatistics().modules) {
+    nDropped[module.first] = module.second.nDropped;
+  }
+  return nDropped;
+}
+
+void
+BoundedQueueLoggerBackend::runWriter()
+{
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_queueMutex);
+      m_hasRecords.wait(lock, [this] { return !m_queue.empty() || m_shouldStop; });
+      if (m_shouldStop) {
+        return;
+      }
+    }
+
+    std::lock_guard<std::mutex> writeLock(m_writeMutex);
+    this->drain();
+  }
+}
+
+void
+BoundedQueueLoggerBackend::drain()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_batch.swap(m_queue);
+    for (const LogRecord& record : m_batch) {
+      --m_counters[&record.getLogger()].nQueued;
+    }
+  }
+  m_hasSpace.notify_all();
+
+  if (m_batch.empty()) {
+    return;
+  }
+
+  for (const LogRecord& record : m_batch) {
+    m_sink->write(record);
+  }
+  m_sink->flush();
+
+  std::lock_guard<std::mutex> lock(m_queueMutex);
+  m_nWritten += m_batch.size();
+  m_batch.clear();
+}
+
+} // namespace util
+} // namespace ndn
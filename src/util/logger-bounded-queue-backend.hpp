@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_BOUNDED_QUEUE_BACKEND_HPP
+#define NDN_UTIL_LOGGER_BOUNDED_QUEUE_BACKEND_HPP
+
+#include "logger-backend.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
+namespace ndn {
+namespace util {
+
+/** \brief a LoggerBackend with a bounded queue and a selectable overflow policy
+ *
+ *  Logging threads append records to a single queue of limited capacity.  A writer thread
+ *  takes all queued records at once, writes them to the sink, and flushes the sink once per
+ *  batch.  When the queue is full, the OverflowPolicy decides which record is lost, if any.
+ *
+ *  \warning With OverflowPolicy::BLOCK or DROP_BELOW_LEVEL, a LogSink must not execute
+ *           log statements, because the writer thread could wait for itself.
+ */
+class BoundedQueueLoggerBackend : public LoggerBackend
+{
+public:
+  enum class OverflowPolicy {
+    BLOCK,           ///< the logging thread waits for space
+    DROP_NEWEST,     ///< the new record is dropped
+    DROP_OLDEST,     ///< the oldest queued record is dropped to make space
+    DROP_BELOW_LEVEL ///< the new record is dropped if less severe than dropLevel, otherwise
+                     ///< the logging thread waits for space
+  };
+
+  struct Options
+  {
+    Options();
+
+    size_t capacity; ///< maximum number of queued records
+    OverflowPolicy overflowPolicy;
+    LogLevel dropLevel; ///< least severe level that is not dropped under DROP_BELOW_LEVEL
+  };
+
+  /** \brief counters of a module
+   */
+  struct ModuleStatistics
+  {
+    ModuleStatistics();
+
+    uint64_t nEnqueued; ///< records accepted into the queue
+    uint64_t nDropped;  ///< records dropped due to overflow, either upon or after enqueuing
+    size_t highWatermark; ///< maximum number of records of the module that were queued at once
+  };
+
+  /** \brief counters of a BoundedQueueLoggerBackend
+   */
+  struct Statistics
+  {
+    uint64_t nEnqueued;
+    uint64_t nDropped;
+    uint64_t nWritten;
+    size_t highWatermark; ///< maximum length of the queue
+    std::map<std::string, ModuleStatistics> modules; ///< counters per module name
+  };
+
+  explicit
+  BoundedQueueLoggerBackend(const Options& options = Options());
+
+  ~BoundedQueueLoggerBackend() NDN_CXX_DECL_OVERRIDE;
+
+  void
+  log(LogRecord&& record) NDN_CXX_DECL_OVERRIDE;
+
+  void
+  setSink(shared_ptr<LogSink> sink) NDN_CXX_DECL_OVERRIDE;
+
+  void
+  flush() NDN_CXX_DECL_OVERRIDE;
+
+  Statistics
+  getStatistics() const;
+
+  std::map<std::string, uint64_t>
+  getNDroppedByModule() const NDN_CXX_DECL_OVERRIDE;
+
+private:
+  /** \brief counters of a Logger, which are aggregated by module name in getStatistics()
+   */
+  struct Counters
+  {
+    Counters();
+
+    ModuleStatistics statistics;
+    size_t nQueued;
+  };
+
+  /** \pre m_queueMutex is locked
+   */
+  void
+  dropOldest();
+
+  void
+  runWriter();
+
+  /** \brief write all queued records to the sink
+   *  \pre m_writeMutex is locked
+   */
+  void
+  drain();
+
+private:
+  const Options m_options;
+
+  mutable std::mutex m_queueMutex;
+  std::condition_variable m_hasRecords;
+  std::condition_variable m_hasSpace;
+  std::deque<LogRecord> m_queue;
+  std::unordered_map<const Logger*, Counters> m_counters;
+  uint64_t m_nEnqueued;
+  uint64_t m_nDropped;
+  uint64_t m_nWritten;
+  size_t m_highWatermark;
+  bool m_shouldStop;
+
+  std::mutex m_writeMutex; ///< serializes access to the sink
+  std::deque<LogRecord> m_batch;
+  shared_ptr<LogSink> m_sink;
+
+  std::thread m_writer;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_BOUNDED_QUEUE_BACKEND_HPP
@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-compressed-sink.hpp"
+
+#include <zlib.h>
+
+namespace ndn {
+namespace util {
+
+const size_t CompressedLogSink::INPUT_BUFFER_SIZE;
+
+/** \brief zlib windowBits that selects the gzip format with the largest window
+ */
+static const int GZIP_WINDOW_BITS = 15 + 16;
+
+static const size_t OUTPUT_BUFFER_SIZE = 65536;
+
+CompressedLogSink::Options::Options()
+  : compressionLevel(Z_BEST_SPEED)
+  , syncInterval(1024 * 1024)
+  , flushInterval(1000)
+{
+}
+
+CompressedLogSink::CompressedLogSink(const std::string& path, const Options& options)
+  : m_options(options)
+  , m_stream(new z_stream)
+  , m_output(OUTPUT_BUFFER_SIZE)
+  , m_formatter(m_input)
+  , m_nSinceSync(0)
+  , m_flushTime(time::steady_clock::now())
+  , m_nSyncPoints(0)
+  , m_isSyncDeferred(false)
+  , m_shouldStop(false)
+{
+  if (m_options.compressionLevel < Z_BEST_SPEED || m_options.compressionLevel > Z_BEST_COMPRESSION) {
+    BOOST_THROW_EXCEPTION(Error("Compression level must be between 1 and 9"));
+  }
+
+  m_file.open(path, std::ios::binary | std::ios::trunc);
+  if (!m_file) {
+    BOOST_THROW_EXCEPTION(Error("Cannot create log file " + path));
+  }
+
+  m_stream->zalloc = Z_NULL;
+  m_stream->zfree = Z_NULL;
+  m_stream->opaque = Z_NULL;
+  if (deflateInit2(m_stream.get(), m_options.compressionLevel, Z_DEFLATED, GZIP_WINDOW_BITS,
+                   8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    BOOST_THROW_EXCEPTION(Error("Cannot initialize compressor for log file " + path));
+  }
+  m_input.reserve(INPUT_BUFFER_SIZE);
+
+  if (m_options.flushInterval > time::milliseconds::zero()) {
+    m_syncer = std::thread(&CompressedLogSink::runSyncer, this);
+  }
+}
+
+CompressedLogSink::~CompressedLogSink()
+{
+  if (m_syncer.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_shouldStop = true;
+    }
+    m_syncerCv.notify_one();
+    m_syncer.join();
+  }
+
+  this->compress(Z_FINISH);
+  deflateEnd(m_stream.get());
+  m_file.flush();
+}
+
+void
+CompressedLogSink::write(const LogRecord& record)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  size_t size = m_input.size();
+  m_formatter.stream() << record << '\n';
+  m_formatter.flush();
+  m_nSinceSync += m_input.size() - size;
+
+  // a sync point is emitted between records, so that decompression from it starts with a record
+  if (m_nSinceSync >= m_options.syncInterval) {
+    this->sync();
+  }
+  else if (m_input.size() >= INPUT_BUFFER_SIZE) {
+    this->compress(Z_NO_FLUSH);
+  }
+}
+
+void
+CompressedLogSink::flush()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_nSinceSync == 0 && m_input.empty()) {
+    return;
+  }
+
+  if (time::steady_clock::now() - m_flushTime < m_options.flushInterval) {
+    // the records must still reach the file if nothing else is written
+    if (!m_isSyncDeferred) {
+      m_isSyncDeferred = true;
+      m_syncerCv.notify_one();
+    }
+    return;
+  }
+  this->sync();
+}
+
+void
+CompressedLogSink::compress(int mode)
+{
+  m_stream->next_in = reinterpret_cast<Bytef*>(&m_input[0]);
+  m_stream->avail_in = static_cast<uInt>(m_input.size());
+
+  do {
+    m_stream->next_out = reinterpret_cast<Bytef*>(m_output.data());
+    m_stream->avail_out = static_cast<uInt>(m_output.size());
+    deflate(m_stream.get(), mode);
+    m_file.write(m_output.data(), m_output.size() - m_stream->avail_out);
+  } while (m_stream->avail_out == 0);
+
+  BOOST_ASSERT(m_stream->avail_in == 0);
+  m_input.clear();
+}
+
+void
+CompressedLogSink::sync()
+{
+  this->compress(Z_FULL_FLUSH);
+  m_file.flush();
+
+  m_nSinceSync = 0;
+  m_flushTime = time::steady_clock::now();
+  ++m_nSyncPoints;
+  m_isSyncDeferred = false;
+}
+
+void
+CompressedLogSink::runSyncer()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_shouldStop) {
+    if (!m_isSyncDeferred) {
+      m_syncerCv.wait(lock, [this] { return m_isSyncDeferred || m_shouldStop; });
+      continue;
+    }
+
+    time::nanoseconds remaining = m_flushTime + m_options.flushInterval - time::steady_clock::now();
+    if (remaining > time::nanoseconds::zero()) {
+      m_syncerCv.wait_for(lock, std::chrono::nanoseconds(remaining.count()));
+    }
+    else {
+      this->sync();
+    }
+  }
+}
+
+} // namespace util
+} // namespace ndn
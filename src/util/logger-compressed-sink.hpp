@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_COMPRESSED_SINK_HPP
+#define NDN_UTIL_LOGGER_COMPRESSED_SINK_HPP
+
+#include "logger-sink.hpp"
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <boost/log/utility/formatting_ostream.hpp>
+
+struct z_stream_s;
+
+namespace ndn {
+namespace util {
+
+/** \brief a LogSink that writes text lines into a gzip-compressed log file
+ *
+ *  Records are formatted and compressed on the thread that drives the sink, which is the writer
+ *  thread of the asynchronous backends, so that compression adds no cost to log statements.
+ *
+ *  The file is a single gzip stream, readable by zcat.  The compressor is reset at a record
+ *  boundary after every syncInterval bytes of text, and whenever compressed data is passed to
+ *  the file, which happens at most every flushInterval.  Each reset emits a sync point, after
+ *  which decompression can start without the preceding data.  Therefore, the ndnlogzcat tool
+ *  can seek into a large log file, and can read a file that is still being written or has been
+ *  truncated by a crash, up to its last sync point.
+ *
+ *  A flush() that comes sooner than flushInterval after the last one arms a deadline instead;
+ *  a syncer thread passes the records to the file when it expires, even if neither another
+ *  record nor another flush() follows.
+ */
+class CompressedLogSink : public LogSink
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  struct Options
+  {
+    Options();
+
+    int compressionLevel;             ///< zlib compression level, from 1 (fastest) to 9 (smallest)
+    size_t syncInterval;              ///< maximum uncompressed bytes between sync points
+    time::milliseconds flushInterval; ///< maximum delay before written records reach the file
+  };
+
+  /** \brief create or replace the compressed log file at \p path
+   *  \throw Error the file cannot be created, or \p options are invalid
+   */
+  explicit
+  CompressedLogSink(const std::string& path, const Options& options = Options());
+
+  /** \brief compress remaining records and finish the gzip stream
+   */
+  ~CompressedLogSink() NDN_CXX_DECL_OVERRIDE;
+
+  void
+  write(const LogRecord& record) NDN_CXX_DECL_OVERRIDE;
+
+  /** \brief pass compressed records to the file, or schedule it for when flushInterval has
+   *         elapsed since last time
+   */
+  void
+  flush() NDN_CXX_DECL_OVERRIDE;
+
+  /** \return number of sync points written
+   */
+  uint64_t
+  getNSyncPoints() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nSyncPoints;
+  }
+
+private:
+  /** \brief pass buffered text to the compressor
+   *  \param mode Z_NO_FLUSH, Z_FULL_FLUSH, or Z_FINISH
+   */
+  void
+  compress(int mode);
+
+  /** \brief emit a sync point, and pass compressed data to the file
+   *  \pre m_mutex is locked
+   */
+  void
+  sync();
+
+  /** \brief invoke sync() whenever a deferred flush is due, until m_shouldStop
+   */
+  void
+  runSyncer();
+
+public:
+  /** \brief size of the text buffer, above which text is passed to the compressor
+   */
+  static const size_t INPUT_BUFFER_SIZE = 65536;
+
+private:
+  const Options m_options;
+  std::ofstream m_file;
+  unique_ptr<z_stream_s> m_stream;
+  std::vector<char> m_output;
+
+  std::string m_input;
+  boost::log::formatting_ostream m_formatter;
+  size_t m_nSinceSync; ///< uncompressed bytes since last sync point
+  time::steady_clock::TimePoint m_flushTime;
+  uint64_t m_nSyncPoints;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_syncerCv;
+  bool m_isSyncDeferred; ///< a flush() has been deferred until m_flushTime + flushInterval
+  bool m_shouldStop;
+  std::thread m_syncer;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_COMPRESSED_SINK_HPP
@@ -20,12 +20,56 @@
  */
 
 #include "logger-factory.hpp"
-#include <boost/log/expressions.hpp>
-#include <fstream>
+#include "logger-compressed-sink.hpp"
+#include "logger-mapped-file-sink.hpp"
+#include "logger-tlv-sink.hpp"
+
+#include <algorithm>
 
 namespace ndn {
 namespace util {
 
+/** \brief a LogSink that writes each record into the sink routed to its module
+ *
+ *  The backend serializes calls to write() and flush(), so that m_written needs no lock.
+ */
+class LoggerFactory::RoutingSink : public LogSink
+{
+public:
+  explicit
+  RoutingSink(shared_ptr<LogSink> defaultSink)
+    : m_defaultSink(std::move(defaultSink))
+  {
+  }
+
+  void
+  write(const LogRecord& record) NDN_CXX_DECL_OVERRIDE
+  {
+    LogSink* sink = record.getCallSite().getLogger().m_sink.load(std::memory_order_acquire);
+    if (sink == nullptr) {
+      sink = m_defaultSink.get();
+    }
+
+    sink->write(record);
+    if (std::find(m_written.begin(), m_written.end(), sink) == m_written.end()) {
+      m_written.push_back(sink);
+    }
+  }
+
+  void
+  flush() NDN_CXX_DECL_OVERRIDE
+  {
+    for (LogSink* sink : m_written) {
+      sink->flush();
+    }
+    m_written.clear();
+  }
+
+private:
+  shared_ptr<LogSink> m_defaultSink;
+  std::vector<LogSink*> m_written; ///< sinks written since last flush
+};
+
 LoggerFactory&
 LoggerFactory::get()
 {
@@ -35,57 +79,395 @@ LoggerFactory::get()
   return globalLoggerFactory;
 }
 
+const size_t LoggerFactory::DEFAULT_FLIGHT_RECORDER_CAPACITY;
+
+LoggerFactory::ThreadCount::ThreadCount()
+{
+  for (Shard& shard : m_shards) {
+    shard.count.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::atomic<int>&
+LoggerFactory::ThreadCount::getShard()
+{
+  static std::atomic<size_t> nThreads(0);
+  static thread_local size_t index = nThreads.fetch_add(1, std::memory_order_relaxed) % N_SHARDS;
+  return m_shards[index].count;
+}
+
+bool
+LoggerFactory::ThreadCount::isZero() const
+{
+  return std::all_of(m_shards.begin(), m_shards.end(),
+                     [] (const Shard& shard) { return shard.count.load() == 0; });
+}
+
 LoggerFactory::LoggerFactory()
+  : m_loggers(nullptr)
+  , m_nConfigReaders(0)
+  , m_currentFlightRecorder(nullptr)
 {
-  static std::ofstream nullOutputStream;
-  this->setDestinationImpl(nullOutputStream);
+  m_configs.push_back(make_unique<Config>());
+  m_currentConfig.store(m_configs.back().get());
+
+  m_sink = make_shared<NullLogSink>();
+  m_routingSink = make_shared<RoutingSink>(m_sink);
+  this->setBackendImpl(make_shared<BoostLoggerBackend>());
 
   const char* environ = std::getenv("NDN_CXX_LOG");
   if (environ != nullptr) {
     this->setSeverityLevelsImpl(environ);
   }
+
+  environ = std::getenv("NDN_CXX_LOG_FLIGHT_RECORDER");
+  if (environ != nullptr && *environ != '\0') {
+    this->enableFlightRecorderImpl(DEFAULT_FLIGHT_RECORDER_CAPACITY, LogLevel::ALL, environ);
+  }
 }
 
 void
 LoggerFactory::addLogger(const std::string& moduleName, Logger* logger)
 {
+  BOOST_ASSERT(logger->getModuleName() == moduleName);
+  LoggerFactory& lf = get();
+
+  Logger* head = lf.m_loggers.load(std::memory_order_relaxed);
+  do {
+    logger->m_nextLogger = head;
+  } while (!lf.m_loggers.compare_exchange_weak(head, logger));
+
+  // A concurrent change may publish a new Config after this thread has read the current one.
+  // That change applies its Config to this Logger if it can see this Logger in the list;
+  // otherwise, this thread sees the new Config after applying the old one, and applies again.
+  // The seq_cst fences pair with the one in updateConfig, so that either the change's writes
+  // into the Logger come last, or this thread sees the change's Config.
+  lf.m_nConfigReaders.fetch_add(1);
+  const Config* config = lf.m_currentConfig.load();
+  while (true) {
+    applyConfig(*logger, *config);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const Config* latestConfig = lf.m_currentConfig.load();
+    if (latestConfig == config) {
+      break;
+    }
+    config = latestConfig;
+  }
+  lf.m_nConfigReaders.fetch_sub(1, std::memory_order_release);
+}
+
+void
+LoggerFactory::applyConfig(Logger& logger, const Config& config)
+{
+  logger.setLevels(findSeverityLevel(config.levelRules, logger.getModuleName()),
+                   config.flightRecorderLevel);
+
+  auto it = config.routes.find(logger.getModuleName());
+  if (it == config.routes.end()) {
+    it = config.routes.find("*");
+  }
+  logger.m_sink.store(it == config.routes.end() ? nullptr : it->second.get(),
+                      std::memory_order_release);
+}
+
+LoggerFactory::Config::Config()
+  : flightRecorderLevel(LogLevel::NONE)
+{
+}
+
+void
+LoggerFactory::updateConfig(const function<void(Config&)>& modify)
+{
+  auto config = make_unique<Config>(*m_configs.back());
+  modify(*config);
+
+  m_configs.push_back(std::move(config));
+  m_currentConfig.store(m_configs.back().get());
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  for (Logger* logger = m_loggers.load(); logger != nullptr; logger = logger->m_nextLogger) {
+    applyConfig(*logger, *m_configs.back());
+  }
+
+  // a thread that starts reading after this point sees only the current Config
+  if (m_nConfigReaders.load() == 0) {
+    m_configs.erase(m_configs.begin(), m_configs.end() - 1);
+  }
+
+  this->retireBackends();
+}
+
+void
+LoggerFactory::addCallSite(LogCallSite& site)
+{
+  // obtaining the Logger may construct it, which calls addLogger
+  Logger& logger = site.m_getLogger();
+
   LoggerFactory& lf = get();
   std::lock_guard<std::mutex> lock(lf.m_mutex);
-  lf.m_loggers.insert({moduleName, logger});
+  if (site.m_state.load(std::memory_order_relaxed) != LogCallSite::STATE_UNREGISTERED) {
+    // registered concurrently by another thread
+    return;
+  }
 
-  auto levelIt = lf.m_enabledLevel.find(moduleName);
-  if (levelIt == lf.m_enabledLevel.end()) {
-    levelIt = lf.m_enabledLevel.find("*");
+  site.m_logger = &logger;
+  site.m_id = static_cast<uint32_t>(lf.m_callSites.size());
+  lf.m_callSites.push_back(&site);
+  lf.applyCallSiteRules(site);
+}
+
+void
+LoggerFactory::applyCallSiteRules(LogCallSite& site)
+{
+  int8_t state = LogCallSite::STATE_DEFAULT;
+  for (const auto& rule : m_callSiteRules) {
+    if (site.matches(rule.first)) {
+      state = rule.second ? LogCallSite::STATE_ENABLED : LogCallSite::STATE_DISABLED;
+    }
   }
-  LogLevel level = levelIt == lf.m_enabledLevel.end() ? LogLevel::INFO : levelIt->second;
-  logger->setLevel(level);
+  site.m_state.store(state, std::memory_order_release);
+}
+
+void
+LoggerFactory::setCallSiteEnabled(const std::string& location, bool isEnabled)
+{
+  size_t colon = location.rfind(':');
+  if (colon == std::string::npos || colon == 0 || colon + 1 == location.size() ||
+      location.find_first_not_of("0123456789", colon + 1) != std::string::npos) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("Call site location must be file:line"));
+  }
+
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+  lf.m_callSiteRules[location] = isEnabled;
+  for (LogCallSite* site : lf.m_callSites) {
+    if (site->matches(location)) {
+      lf.applyCallSiteRules(*site);
+    }
+  }
+}
+
+void
+LoggerFactory::resetCallSite(const std::string& location)
+{
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+  lf.m_callSiteRules.erase(location);
+  for (LogCallSite* site : lf.m_callSites) {
+    if (site->matches(location)) {
+      lf.applyCallSiteRules(*site);
+    }
+  }
+}
+
+std::vector<const LogCallSite*>
+LoggerFactory::getCallSites()
+{
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+  return std::vector<const LogCallSite*>(lf.m_callSites.begin(), lf.m_callSites.end());
 }
 
 void
 LoggerFactory::setSeverityLevel(const std::string& moduleName, LogLevel level)
 {
-  get().setSeverityLevel(moduleName, level);
+  get().setSeverityLevelImpl(moduleName, level);
 }
 
 void
 LoggerFactory::setSeverityLevelImpl(const std::string& moduleName, LogLevel level)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
-  if (moduleName == "*") {
-    m_enabledLevel.clear();
-    m_enabledLevel["*"] = level;
+  this->updateConfig([&] (Config& config) {
+    insertLevelRule(config.levelRules, moduleName, level);
+  });
+}
 
-    for (auto i = m_loggers.begin(); i != m_loggers.end(); ++i) {
-      i->second->setLevel(level);
+LoggerFactory::LevelRuleNode::LevelRuleNode()
+  : hasLevel(false)
+  , level(LogLevel::INFO)
+  , hasWildcardLevel(false)
+  , wildcardLevel(LogLevel::INFO)
+{
+}
+
+LoggerFactory::LevelRuleNode::LevelRuleNode(const LevelRuleNode& other)
+  : hasLevel(other.hasLevel)
+  , level(other.level)
+  , hasWildcardLevel(other.hasWildcardLevel)
+  , wildcardLevel(other.wildcardLevel)
+{
+  for (const auto& child : other.children) {
+    children[child.first] = make_unique<LevelRuleNode>(*child.second);
+  }
+}
+
+/** \return whether \p pattern is "*" or "Prefix.*"
+ *  \throw std::invalid_argument '*' appears other than as the last component of \p pattern
+ */
+static bool
+isWildcardPattern(const std::string& pattern)
+{
+  static const std::string WILDCARD_SUFFIX = ".*";
+  bool isWildcard = pattern == "*" ||
+                    (pattern.size() > WILDCARD_SUFFIX.size() &&
+                     pattern.compare(pattern.size() - WILDCARD_SUFFIX.size(),
+                                     WILDCARD_SUFFIX.size(), WILDCARD_SUFFIX) == 0);
+  if (pattern.find('*') < pattern.size() - (isWildcard ? 1 : 0)) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("'*' must be the last component of module name "
+                                                "pattern '" + pattern + "'"));
+  }
+  return isWildcard;
+}
+
+void
+LoggerFactory::insertLevelRule(LevelRuleNode& root, const std::string& pattern, LogLevel level)
+{
+  bool isWildcard = isWildcardPattern(pattern);
+
+  LevelRuleNode* node = &root;
+  if (pattern != "*") {
+    size_t nameEnd = isWildcard ? pattern.size() - 2 : pattern.size();
+    for (size_t begin = 0; begin <= nameEnd;) {
+      size_t end = std::min(pattern.find('.', begin), nameEnd);
+      unique_ptr<LevelRuleNode>& child = node->children[pattern.substr(begin, end - begin)];
+      if (child == nullptr) {
+        child.reset(new LevelRuleNode);
+      }
+      node = child.get();
+      begin = end + 1;
+    }
+  }
+
+  if (isWildcard) {
+    // rules under the wildcard are superseded, as "*" supersedes every rule
+    node->children.clear();
+    node->hasWildcardLevel = true;
+    node->wildcardLevel = level;
+  }
+  else {
+    node->hasLevel = true;
+    node->level = level;
+  }
+}
+
+LoggerFactory::LevelRuleNode*
+LoggerFactory::findLevelRuleNode(LevelRuleNode& root, const std::string& pattern)
+{
+  bool isWildcard = isWildcardPattern(pattern);
+  if (pattern == "*") {
+    return &root;
+  }
+
+  LevelRuleNode* node = &root;
+  size_t nameEnd = isWildcard ? pattern.size() - 2 : pattern.size();
+  for (size_t begin = 0; begin <= nameEnd;) {
+    size_t end = std::min(pattern.find('.', begin), nameEnd);
+    auto it = node->children.find(pattern.substr(begin, end - begin));
+    if (it == node->children.end()) {
+      return nullptr;
+    }
+    node = it->second.get();
+    begin = end + 1;
+  }
+  return node;
+}
+
+bool
+LoggerFactory::hasSeverityLevel(const std::string& moduleName)
+{
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+  const LevelRuleNode* node = findLevelRuleNode(lf.m_configs.back()->levelRules, moduleName);
+  if (node == nullptr) {
+    return false;
+  }
+  return isWildcardPattern(moduleName) ? node->hasWildcardLevel : node->hasLevel;
+}
+
+void
+LoggerFactory::resetSeverityLevel(const std::string& moduleName)
+{
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+  lf.updateConfig([&] (Config& config) {
+    LevelRuleNode* node = findLevelRuleNode(config.levelRules, moduleName);
+    if (node == nullptr) {
+      return;
+    }
+    if (isWildcardPattern(moduleName)) {
+      node->hasWildcardLevel = false;
+    }
+    else {
+      node->hasLevel = false;
+    }
+  });
+}
+
+LogLevel
+LoggerFactory::getSeverityLevel(const std::string& moduleName)
+{
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+  return findSeverityLevel(lf.m_configs.back()->levelRules, moduleName);
+}
+
+LogLevel
+LoggerFactory::findSeverityLevel(const LevelRuleNode& root, const std::string& moduleName)
+{
+  LogLevel level = root.hasWildcardLevel ? root.wildcardLevel : LogLevel::INFO;
+  const LevelRuleNode* node = &root;
+  for (size_t begin = 0;;) {
+    size_t end = std::min(moduleName.find('.', begin), moduleName.size());
+    if (end == moduleName.size() && moduleName.compare(begin, std::string::npos, "*") == 0) {
+      // pattern "Prefix.*" takes the wildcard level in effect for Prefix
+      return level;
+    }
+
+    auto it = node->children.find(moduleName.substr(begin, end - begin));
+    if (it == node->children.end()) {
+      return level;
+    }
+    node = it->second.get();
+
+    if (end == moduleName.size()) {
+      return node->hasLevel ? node->level : level;
+    }
+    if (node->hasWildcardLevel) {
+      level = node->wildcardLevel;
+    }
+    begin = end + 1;
+  }
+}
+
+std::vector<LoggerFactory::ModuleStatus>
+LoggerFactory::getModuleStatus()
+{
+  LoggerFactory& lf = get();
+  std::map<std::string, uint64_t> nDropped = getBackend()->getNDroppedByModule();
+
+  std::map<std::string, ModuleStatus> modules;
+  {
+    std::lock_guard<std::mutex> lock(lf.m_mutex);
+    const LevelRuleNode& levelRules = lf.m_configs.back()->levelRules;
+    for (Logger* logger = lf.m_loggers.load(); logger != nullptr; logger = logger->m_nextLogger) {
+      const std::string& moduleName = logger->getModuleName();
+      auto it = modules.find(moduleName);
+      if (it == modules.end()) {
+        ModuleStatus module{moduleName, findSeverityLevel(levelRules, moduleName),
+                            0, nDropped[moduleName]};
+        it = modules.insert({moduleName, module}).first;
+      }
+      it->second.nRecords += logger->getNRecords();
     }
-    return;
   }
 
-  m_enabledLevel[moduleName] = level;
-  auto range = m_loggers.equal_range(moduleName);
-  for (auto i = range.first; i != range.second; ++i) {
-    i->second->setLevel(level);
+  std::vector<ModuleStatus> status;
+  status.reserve(modules.size());
+  for (auto& module : modules) {
+    status.push_back(std::move(module.second));
   }
+  return status;
 }
 
 void
@@ -97,17 +479,56 @@ LoggerFactory::setSeverityLevels(const std::string& config)
 void
 LoggerFactory::setSeverityLevelsImpl(const std::string& config)
 {
+  std::vector<std::pair<std::string, LogLevel>> levelRules;
+  std::vector<std::pair<std::string, std::string>> routePaths;
+
   std::stringstream ss(config);
   std::string configModule;
   while (std::getline(ss, configModule, ':')) {
-    size_t ind = configModule.find('=');
-    if (ind == std::string::npos)
+    size_t ind = configModule.find_first_of("=>");
+    if (ind == std::string::npos || ind == 0)
       BOOST_THROW_EXCEPTION(std::invalid_argument("wrong log configuration"));
 
     std::string moduleName = configModule.substr(0, ind);
+    if (configModule[ind] == '>') {
+      routePaths.emplace_back(moduleName, configModule.substr(ind + 1));
+      continue;
+    }
+
     LogLevel level = parseLevel(configModule.substr(ind+1));
+    isWildcardPattern(moduleName); // validate before any rule is applied
+    levelRules.emplace_back(moduleName, level);
+  }
+
+  if (levelRules.empty() && routePaths.empty()) {
+    return;
+  }
 
-    this->setSeverityLevelImpl(moduleName, level);
+  // open the files only once the whole configuration is valid, and before anything is applied
+  std::vector<std::pair<std::string, shared_ptr<LogSink>>> routes;
+  for (const auto& route : routePaths) {
+    routes.emplace_back(route.first,
+                        route.second.empty() ? nullptr : this->getFileSink(route.second));
+  }
+
+  // compile all rules into the trie first, so that each Logger is updated once
+  std::lock_guard<std::mutex> lock(m_mutex);
+  this->updateConfig([&] (Config& config) {
+    for (const auto& route : routes) {
+      if (route.second == nullptr) {
+        config.routes.erase(route.first);
+      }
+      else {
+        config.routes[route.first] = route.second;
+      }
+    }
+    for (const auto& rule : levelRules) {
+      insertLevelRule(config.levelRules, rule.first, rule.second);
+    }
+  });
+
+  if (!routes.empty()) {
+    this->releaseRoutedSinks();
   }
 }
 
@@ -134,27 +555,233 @@ LoggerFactory::parseLevel(const std::string& levelStr)
   BOOST_THROW_EXCEPTION(std::invalid_argument("Unrecognized log level '" + levelStr + "'"));
 }
 
+shared_ptr<LogSink>
+LoggerFactory::makeFileSink(const std::string& path)
+{
+  auto hasExtension = [&path] (const std::string& extension) {
+    return path.size() > extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+  };
+
+  if (hasExtension(".tlv")) {
+    return make_shared<TlvLogSink>(path);
+  }
+  if (hasExtension(".gz")) {
+    return make_shared<CompressedLogSink>(path);
+  }
+  return make_shared<MappedFileLogSink>(path);
+}
+
+shared_ptr<LogSink>
+LoggerFactory::getFileSink(const std::string& path)
+{
+  // a second sink would truncate the file while the first one is still writing into it
+  std::lock_guard<std::mutex> lock(m_mutex);
+  weak_ptr<LogSink>& entry = m_fileSinks[path];
+  shared_ptr<LogSink> sink = entry.lock();
+  if (sink == nullptr) {
+    sink = makeFileSink(path);
+    entry = sink;
+  }
+  return sink;
+}
+
 void
 LoggerFactory::setDestination(std::ostream& os)
 {
-  get().setDestinationImpl(os);
+  get().setSinkImpl(make_shared<StreamLogSink>(os));
 }
 
 void
-LoggerFactory::setDestinationImpl(std::ostream& os)
+LoggerFactory::setSink(shared_ptr<LogSink> sink)
 {
+  get().setSinkImpl(std::move(sink));
+}
+
+void
+LoggerFactory::setSinkImpl(shared_ptr<LogSink> sink)
+{
+  BOOST_ASSERT(sink != nullptr);
   std::lock_guard<std::mutex> lock(m_mutex);
+  m_sink = sink;
+  m_routingSink = make_shared<RoutingSink>(std::move(sink));
+  m_backends.back()->setSink(m_routingSink);
+}
+
+shared_ptr<LogSink>
+LoggerFactory::getSink()
+{
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+  return lf.m_sink;
+}
 
-  auto backend = boost::make_shared<boost::log::sinks::text_ostream_backend>();
-  backend->auto_flush(true);
-  backend->add_stream(boost::shared_ptr<std::ostream>(&os, bind([]{})));
+void
+LoggerFactory::setModuleSink(const std::string& moduleName, shared_ptr<LogSink> sink)
+{
+  get().setModuleSinkImpl(moduleName, std::move(sink));
+}
 
-  boost::log::core::get()->remove_sink(m_sink);
-  m_sink.reset();
+void
+LoggerFactory::setModuleSinkImpl(const std::string& moduleName, shared_ptr<LogSink> sink)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  this->updateConfig([&] (Config& config) {
+    if (sink == nullptr) {
+      config.routes.erase(moduleName);
+    }
+    else {
+      config.routes[moduleName] = std::move(sink);
+    }
+  });
+  this->releaseRoutedSinks();
+}
+
+void
+LoggerFactory::releaseRoutedSinks()
+{
+  // A backend writes into the sink of a Logger while it is flushed, or in between flushes.
+  // Loggers no longer refer to unrouted sinks, so once every backend has been flushed,
+  // no record is being written into them.
+  for (const auto& backend : m_backends) {
+    backend->flush();
+  }
 
-  m_sink = boost::make_shared<Sink>(backend);
-  m_sink->set_formatter(boost::log::expressions::stream << boost::log::expressions::message);
-  boost::log::core::get()->add_sink(m_sink);
+  m_routedSinks.clear();
+  for (const auto& route : m_configs.back()->routes) {
+    if (std::find(m_routedSinks.begin(), m_routedSinks.end(), route.second) ==
+        m_routedSinks.end()) {
+      m_routedSinks.push_back(route.second);
+    }
+  }
+
+  for (auto it = m_fileSinks.begin(); it != m_fileSinks.end();) {
+    if (it->second.expired()) {
+      it = m_fileSinks.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+shared_ptr<LogSink>
+LoggerFactory::getModuleSink(const std::string& moduleName)
+{
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+  const auto& routes = lf.m_configs.back()->routes;
+  auto it = routes.find(moduleName);
+  return it == routes.end() ? nullptr : it->second;
+}
+
+void
+LoggerFactory::setBackend(shared_ptr<LoggerBackend> backend)
+{
+  get().setBackendImpl(std::move(backend));
+}
+
+void
+LoggerFactory::setBackendImpl(shared_ptr<LoggerBackend> backend)
+{
+  BOOST_ASSERT(backend != nullptr);
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  backend->setSink(m_routingSink);
+  m_backends.push_back(std::move(backend));
+  m_currentBackend.store(m_backends.back().get());
+  this->retireBackends();
+}
+
+void
+LoggerFactory::retireBackends()
+{
+  if (m_backends.size() <= 1) {
+    return;
+  }
+
+  // a thread that starts logging after this point sees only the current backend
+  if (m_backendUsers.isZero()) {
+    m_backends.erase(m_backends.begin(), m_backends.end() - 1);
+  }
+  else {
+    for (auto it = m_backends.begin(); it != m_backends.end() - 1; ++it) {
+      (*it)->flush();
+    }
+  }
+}
+
+shared_ptr<LoggerBackend>
+LoggerFactory::getBackend()
+{
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+  return lf.m_backends.back();
+}
+
+void
+LoggerFactory::enableFlightRecorder(size_t capacity, LogLevel level,
+                                    const std::string& crashDumpFile)
+{
+  get().enableFlightRecorderImpl(capacity, level, crashDumpFile);
+}
+
+void
+LoggerFactory::enableFlightRecorderImpl(size_t capacity, LogLevel level,
+                                        const std::string& crashDumpFile)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_flightRecorders.push_back(make_unique<FlightRecorder>(capacity, crashDumpFile));
+  FlightRecorder* recorder = m_flightRecorders.back().get();
+  m_currentFlightRecorder.store(recorder);
+  FlightRecorder::setCrashRecorder(crashDumpFile.empty() ? nullptr : recorder);
+  this->retireFlightRecorders();
+
+  this->updateConfig([level] (Config& config) {
+    config.flightRecorderLevel = level;
+  });
+}
+
+void
+LoggerFactory::retireFlightRecorders()
+{
+  // a thread that starts recording after this point sees only the current recorder
+  if (m_flightRecorderWriters.isZero()) {
+    bool isEnabled = m_currentFlightRecorder.load() != nullptr;
+    m_flightRecorders.erase(m_flightRecorders.begin(),
+                            isEnabled ? m_flightRecorders.end() - 1 : m_flightRecorders.end());
+  }
+}
+
+void
+LoggerFactory::disableFlightRecorder()
+{
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+
+  lf.updateConfig([] (Config& config) {
+    config.flightRecorderLevel = LogLevel::NONE;
+  });
+
+  lf.m_currentFlightRecorder.store(nullptr);
+  FlightRecorder::setCrashRecorder(nullptr);
+  lf.retireFlightRecorders();
+}
+
+void
+LoggerFactory::dumpFlightRecorder(const std::string& filename)
+{
+  LoggerFactory& lf = get();
+  std::lock_guard<std::mutex> lock(lf.m_mutex);
+
+  FlightRecorder* recorder = lf.m_currentFlightRecorder.load();
+  if (recorder == nullptr) {
+    BOOST_THROW_EXCEPTION(std::runtime_error("Flight recorder is disabled"));
+  }
+  if (!recorder->dumpToFile(filename.c_str())) {
+    BOOST_THROW_EXCEPTION(std::runtime_error("Cannot open " + filename));
+  }
 }
 
 } // namespace util
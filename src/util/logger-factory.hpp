@@ -24,32 +24,201 @@
 
 #include "../common.hpp"
 #include "logger.hpp"
+#include "logger-backend.hpp"
+#include "logger-flight-recorder.hpp"
 
+#include <array>
+#include <atomic>
+#include <map>
 #include <mutex>
 #include <unordered_map>
 
-#include <boost/log/sinks.hpp>
-
 namespace ndn {
 namespace util {
 
 class LoggerFactory : noncopyable
 {
 public:
+  /** \brief status of a module, as reported by getModuleStatus()
+   */
+  struct ModuleStatus
+  {
+    std::string moduleName;
+    LogLevel level;
+    uint64_t nRecords; ///< records passed to the backend, summed over Loggers of the module
+    uint64_t nDropped; ///< records dropped by the current backend
+  };
+
+public:
+  /** \brief register \p logger and apply the current configuration to it
+   *
+   *  This does not lock the mutex that serializes configuration changes, so that Loggers
+   *  can be constructed concurrently on any thread, even while the configuration changes.
+   */
   static void
   addLogger(const std::string& moduleName, Logger* logger);
 
-  /** @example *=INFO:Face=DEBUG:NfdController=WARN
+  /** \brief apply a configuration of module levels and routes
+   *
+   *  The configuration is a colon-separated list of rules, applied in order.
+   *  \li "Module=LEVEL" sets the level of a module; "Prefix.*=LEVEL" sets the level of all
+   *      modules whose names start with "Prefix.", and discards the levels set for them before;
+   *      "*=LEVEL" sets the level of all modules, and discards all levels set before.
+   *  \li "Module>path" routes a module to a log file at path, which is a structured log file
+   *      written by TlvLogSink if path ends with ".tlv", a compressed log file written by
+   *      CompressedLogSink if path ends with ".gz", or a MappedFileLogSink otherwise;
+   *      "*>path" routes all modules that do not have their own route;
+   *      "Module>" removes the route of a module.  Routes to the same path share one sink,
+   *      as long as a route or another owner keeps it alive.
+   *
+   *  Module names are hierarchical, with components separated by '.'.  A module takes the level
+   *  of the most specific rule that matches it: its own rule, otherwise the rule of the longest
+   *  matching prefix, otherwise "*", otherwise INFO.
+   *  The whole configuration is validated, and its log files are created, before any rule
+   *  takes effect; then its level rules and routes are applied in one pass over existing Loggers.
+   *
+   *  @example *=INFO:Face=DEBUG:NfdController=WARN
+   *  @example *=WARN:security.*=DEBUG:Face.Pit=TRACE
+   *  @example *=INFO:Face=TRACE:Face>face.tlv
+   *  \throw std::invalid_argument the configuration is malformed
+   *  \throw MappedFileLogSink::Error,TlvLogSink::Error,CompressedLogSink::Error
+   *         a log file cannot be created
    */
   static void
   setSeverityLevels(const std::string& config);
 
+  /** \brief set the level of \p moduleName
+   *  \param moduleName a module name, or a pattern "Prefix.*" or "*", as in setSeverityLevels
+   *  \throw std::invalid_argument '*' appears other than as the last component of \p moduleName
+   */
   static void
   setSeverityLevel(const std::string& moduleName, LogLevel level);
 
+  /** \return whether a rule sets the level of \p moduleName itself, rather than a rule of a
+   *          prefix or "*"
+   *  \param moduleName a module name, or a pattern "Prefix.*" or "*", as in setSeverityLevels
+   *  \throw std::invalid_argument '*' appears other than as the last component of \p moduleName
+   */
+  static bool
+  hasSeverityLevel(const std::string& moduleName);
+
+  /** \brief remove the rule that sets the level of \p moduleName itself, so that it takes the
+   *         level of its prefixes again
+   *  \param moduleName a module name, or a pattern "Prefix.*" or "*", as in setSeverityLevels
+   *  \throw std::invalid_argument '*' appears other than as the last component of \p moduleName
+   */
+  static void
+  resetSeverityLevel(const std::string& moduleName);
+
+  /** \return the level that applies to \p moduleName, according to the most specific rule;
+   *          if \p moduleName is a pattern "Prefix.*", the level that applies to modules under
+   *          Prefix that do not have a more specific rule
+   */
+  static LogLevel
+  getSeverityLevel(const std::string& moduleName);
+
+  /** \return status of every module that has a Logger, ordered by module name
+   */
+  static std::vector<ModuleStatus>
+  getModuleStatus();
+
+  /** \brief write records as text lines into \p os
+   *
+   *  This is equivalent to setSink(make_shared<StreamLogSink>(os)).
+   */
   static void
   setDestination(std::ostream& os);
 
+  /** \brief select where records are written
+   *
+   *  The default sink discards all records.
+   */
+  static void
+  setSink(shared_ptr<LogSink> sink);
+
+  static shared_ptr<LogSink>
+  getSink();
+
+  /** \brief route records of \p moduleName to \p sink instead of the default sink
+   *  \param moduleName a module name, or "*" for all modules that do not have their own route
+   *  \param sink the sink, or nullptr to remove the route
+   *
+   *  The route is resolved into each affected Logger when this is called, so that delivering
+   *  a record does not involve a lookup.  Records still pass through the active LoggerBackend,
+   *  which serializes writes to every sink.
+   *  A sink that no route refers to any more is released after the backends have written
+   *  the records already queued for it.
+   */
+  static void
+  setModuleSink(const std::string& moduleName, shared_ptr<LogSink> sink);
+
+  /** \return the sink routed to \p moduleName, or nullptr if there is none
+   */
+  static shared_ptr<LogSink>
+  getModuleSink(const std::string& moduleName);
+
+  /** \brief select the backend that delivers records to the sink
+   *
+   *  The current sink is transferred to \p backend.
+   *  The previous backend is released once no log statement on another thread is using it:
+   *  in this call if possible, otherwise in a later configuration change.  Until then it is
+   *  flushed with the current backend.  Releasing the last reference to a backend writes out
+   *  its remaining records and stops its threads.
+   *  The default backend is BoostLoggerBackend.
+   */
+  static void
+  setBackend(shared_ptr<LoggerBackend> backend);
+
+  static shared_ptr<LoggerBackend>
+  getBackend();
+
+  /** \brief enable or disable individual log statements regardless of their module's level
+   *  \param location "file:line", where file is either the full path as in __FILE__,
+   *                  or its trailing components, e.g. "face-impl.hpp:86"
+   *
+   *  The setting also applies to matching call sites that have not yet been executed.
+   */
+  static void
+  setCallSiteEnabled(const std::string& location, bool isEnabled);
+
+  /** \brief let log statements at \p location follow their module's level again
+   */
+  static void
+  resetCallSite(const std::string& location);
+
+  /** \return call sites of log statements that have been executed at least once,
+   *          indexed by LogCallSite::getId()
+   */
+  static std::vector<const LogCallSite*>
+  getCallSites();
+
+  /** \brief start capturing records into an in-memory FlightRecorder
+   *  \param capacity number of most recent records to keep
+   *  \param level records at this level and below are captured in every module,
+   *               independently of the level of the module
+   *  \param crashDumpFile if not empty, the history is written to this file upon a fatal
+   *                       signal and whenever a record is logged at FATAL level
+   *
+   *  A previously enabled flight recorder and its history are discarded.
+   *  Setting environ NDN_CXX_LOG_FLIGHT_RECORDER to a filename enables the flight recorder
+   *  at program start, with default capacity and level, using that file as crashDumpFile.
+   */
+  static void
+  enableFlightRecorder(size_t capacity = DEFAULT_FLIGHT_RECORDER_CAPACITY,
+                       LogLevel level = LogLevel::ALL,
+                       const std::string& crashDumpFile = "");
+
+  static void
+  disableFlightRecorder();
+
+  /** \brief write the history of the flight recorder to \p filename
+   *  \throw std::runtime_error the flight recorder is disabled, or the file cannot be opened
+   */
+  static void
+  dumpFlightRecorder(const std::string& filename);
+
+  static const size_t DEFAULT_FLIGHT_RECORDER_CAPACITY = 16384;
+
 private:
   static LoggerFactory&
   get();
@@ -62,19 +231,216 @@ private:
   void
   setSeverityLevelImpl(const std::string& moduleName, LogLevel level);
 
+  struct LevelRuleNode;
+
+  /** \brief add a level rule into the trie rooted at \p root
+   *  \throw std::invalid_argument \p pattern is malformed
+   */
+  static void
+  insertLevelRule(LevelRuleNode& root, const std::string& pattern, LogLevel level);
+
+  /** \return the node in the trie rooted at \p root whose rule is \p pattern, or nullptr if
+   *          there is no such node
+   *  \throw std::invalid_argument \p pattern is malformed
+   */
+  static LevelRuleNode*
+  findLevelRuleNode(LevelRuleNode& root, const std::string& pattern);
+
+  /** \brief look up the level of \p moduleName in the trie rooted at \p root
+   *
+   *  This takes O(depth of \p moduleName), regardless of the number of rules.
+   */
+  static LogLevel
+  findSeverityLevel(const LevelRuleNode& root, const std::string& moduleName);
+
   static LogLevel
   parseLevel(const std::string& levelStr);
 
+  /** \brief create a sink for the log file at \p path, according to its extension
+   */
+  static shared_ptr<LogSink>
+  makeFileSink(const std::string& path);
+
+  /** \return the sink for the log file at \p path, creating it if there is no live one
+   */
+  shared_ptr<LogSink>
+  getFileSink(const std::string& path);
+
+  void
+  setSinkImpl(shared_ptr<LogSink> sink);
+
+  void
+  setModuleSinkImpl(const std::string& moduleName, shared_ptr<LogSink> sink);
+
+  /** \brief release routed sinks that the current Config does not refer to
+   *  \pre m_mutex is locked
+   */
   void
-  setDestinationImpl(std::ostream& os);
+  releaseRoutedSinks();
+
+  struct Config;
+
+  /** \brief publish a modified copy of the current Config, and apply it to every Logger
+   *  \param modify modifies the copy; if it throws, the current Config is unchanged
+   *  \pre m_mutex is locked
+   */
+  void
+  updateConfig(const function<void(Config&)>& modify);
+
+  /** \brief set the levels and the route of \p logger according to \p config
+   */
+  static void
+  applyConfig(Logger& logger, const Config& config);
+
+  void
+  setBackendImpl(shared_ptr<LoggerBackend> backend);
+
+  /** \brief register \p site and assign its id
+   */
+  static void
+  addCallSite(LogCallSite& site);
+
+  /** \brief apply m_callSiteRules to \p site
+   *  \pre m_mutex is locked
+   */
+  void
+  applyCallSiteRules(LogCallSite& site);
+
+  void
+  enableFlightRecorderImpl(size_t capacity, LogLevel level, const std::string& crashDumpFile);
+
+  /** \brief delete replaced flight recorders if no thread is recording into them
+   *  \pre m_mutex is locked
+   */
+  void
+  retireFlightRecorders();
+
+  /** \brief release replaced backends if no thread is logging into them
+   *  \pre m_mutex is locked
+   */
+  void
+  retireBackends();
 
 private:
+  class RoutingSink;
+
+  /** \brief number of threads inside a section, such as recording into the flight recorder
+   *
+   *  The count is split into shards on separate cache lines.  Each thread enters and leaves
+   *  the section on its own shard, so that threads in the section do not contend on one line.
+   */
+  class ThreadCount
+  {
+  public:
+    ThreadCount();
+
+    /** \return the shard of the calling thread
+     *
+     *  A thread enters with a seq_cst fetch_add(1), and leaves with fetch_sub(1) with release
+     *  order, on the same shard.
+     */
+    std::atomic<int>&
+    getShard();
+
+    /** \return whether no thread is inside the section
+     */
+    bool
+    isZero() const;
+
+  private:
+    static const size_t N_SHARDS = 16;
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    struct Shard
+    {
+      std::atomic<int> count;
+      char padding[CACHE_LINE_SIZE - sizeof(std::atomic<int>)];
+    };
+
+    std::array<Shard, N_SHARDS> m_shards;
+  };
+
+  /** \brief a node in the trie of level rules, whose edges are components of module names
+   *
+   *  The rule "A.B=LEVEL" is the level of node A/B, and "A.B.*=LEVEL" is the wildcard level of
+   *  node A/B, which applies to modules under A.B without a more specific rule.
+   *  The rule "*=LEVEL" is the wildcard level of the root.
+   */
+  struct LevelRuleNode
+  {
+    LevelRuleNode();
+
+    /** \brief deep copy
+     */
+    LevelRuleNode(const LevelRuleNode& other);
+
+    bool hasLevel;
+    LogLevel level;
+    bool hasWildcardLevel;
+    LogLevel wildcardLevel;
+    std::unordered_map<std::string, unique_ptr<LevelRuleNode>> children;
+  };
+
+  /** \brief the configuration that applies to each Logger
+   *
+   *  A Config is never modified after it is published in m_currentConfig.  A change publishes
+   *  a modified copy instead, so that a Logger being constructed can read the current Config
+   *  without locking m_mutex.
+   */
+  struct Config
+  {
+    Config();
+
+    LevelRuleNode levelRules; ///< root of the trie of level rules
+    std::unordered_map<std::string, shared_ptr<LogSink>> routes; ///< module name => sink
+    LogLevel flightRecorderLevel;
+  };
+
+  /** \brief serializes configuration changes; not locked when a Logger is registered
+   */
   std::mutex m_mutex;
-  std::unordered_map<std::string, LogLevel> m_enabledLevel;
-  std::unordered_multimap<std::string, Logger*> m_loggers;
 
-  typedef boost::log::sinks::asynchronous_sink<boost::log::sinks::text_ostream_backend> Sink;
-  boost::shared_ptr<Sink> m_sink;
+  /** \brief head of the append-only list of Loggers, linked by Logger::m_nextLogger
+   */
+  std::atomic<Logger*> m_loggers;
+
+  /** \brief configurations, the current one being the last
+   *
+   *  Replaced configurations are deleted in the first change after no thread is reading
+   *  any configuration without m_mutex.
+   */
+  std::vector<unique_ptr<Config>> m_configs;
+  std::atomic<const Config*> m_currentConfig;
+  std::atomic<int> m_nConfigReaders; ///< threads reading m_currentConfig without m_mutex
+
+  std::vector<LogCallSite*> m_callSites;
+  std::map<std::string, bool> m_callSiteRules; ///< location => isEnabled
+
+  shared_ptr<LogSink> m_sink; ///< default sink
+  shared_ptr<RoutingSink> m_routingSink; ///< sink given to the backend, wrapping m_sink
+  std::vector<shared_ptr<LogSink>> m_routedSinks; ///< sinks that may be in use by a backend
+  std::map<std::string, weak_ptr<LogSink>> m_fileSinks; ///< path => sink created by getFileSink
+
+  /** \brief backends, the current one being the last
+   *
+   *  Replaced backends are released in the first change after no thread is logging into
+   *  any backend.
+   */
+  std::vector<shared_ptr<LoggerBackend>> m_backends;
+  std::atomic<LoggerBackend*> m_currentBackend;
+  ThreadCount m_backendUsers; ///< threads using m_currentBackend
+
+  /** \brief flight recorders, the current one being the last unless it is disabled
+   *
+   *  Replaced recorders are deleted in the first change after no thread is recording
+   *  into any recorder.
+   */
+  std::vector<unique_ptr<FlightRecorder>> m_flightRecorders;
+  std::atomic<FlightRecorder*> m_currentFlightRecorder;
+  ThreadCount m_flightRecorderWriters; ///< threads using m_currentFlightRecorder
+
+  friend class Logger;
+  friend class LogCallSite;
 };
 
 } // namespace util
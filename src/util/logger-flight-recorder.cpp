@@ -0,0 +1,635 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-flight-recorder.hpp"
+#include "logger.hpp"
+#include "logger-timestamp.hpp"
+#include "detail/spsc-ring-buffer.hpp"
+#include "../encoding/tlv.hpp"
+
+#include <cmath>
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+
+namespace ndn {
+namespace util {
+
+namespace {
+
+/** \brief an async-signal-safe formatter that writes into a fixed-size buffer
+ *
+ *  Output that does not fit into the buffer is discarded.
+ */
+class LineWriter
+{
+public:
+  LineWriter(char* buffer, size_t size)
+    : m_buffer(buffer)
+    , m_size(size)
+    , m_length(0)
+  {
+  }
+
+  size_t
+  getLength() const
+  {
+    return m_length;
+  }
+
+  void
+  append(char c)
+  {
+    if (m_length < m_size) {
+      m_buffer[m_length++] = c;
+    }
+  }
+
+  void
+  append(const char* str, size_t length)
+  {
+    length = std::min(length, m_size - m_length);
+    std::memcpy(m_buffer + m_length, str, length);
+    m_length += length;
+  }
+
+  void
+  append(const char* str)
+  {
+    this->append(str, std::strlen(str));
+  }
+
+  void
+  appendUnsigned(uint64_t value, int minDigits = 1)
+  {
+    char digits[20];
+    int nDigits = 0;
+    do {
+      digits[nDigits++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value != 0 || nDigits < minDigits);
+
+    while (nDigits > 0) {
+      this->append(digits[--nDigits]);
+    }
+  }
+
+  void
+  appendSigned(int64_t value)
+  {
+    if (value < 0) {
+      this->append('-');
+      this->appendUnsigned(0 - static_cast<uint64_t>(value));
+    }
+    else {
+      this->appendUnsigned(static_cast<uint64_t>(value));
+    }
+  }
+
+  /** \brief append \p value with up to six significant fractional digits
+   */
+  void
+  appendDouble(double value)
+  {
+    if (std::isnan(value)) {
+      this->append("nan");
+      return;
+    }
+    if (value < 0) {
+      this->append('-');
+      value = -value;
+    }
+    if (std::isinf(value)) {
+      this->append("inf");
+      return;
+    }
+
+    int exponent = 0;
+    if (value >= 1e15) {
+      while (value >= 10) {
+        value /= 10;
+        ++exponent;
+      }
+    }
+
+    uint64_t fraction = static_cast<uint64_t>(std::round((value - std::floor(value)) * 1e6));
+    uint64_t integral = static_cast<uint64_t>(std::floor(value));
+    if (fraction >= 1000000) {
+      ++integral;
+      fraction = 0;
+    }
+    this->appendUnsigned(integral);
+    if (fraction != 0) {
+      int nDigits = 6;
+      while (fraction % 10 == 0) {
+        fraction /= 10;
+        --nDigits;
+      }
+      this->append('.');
+      this->appendUnsigned(fraction, nDigits);
+    }
+    if (exponent != 0) {
+      this->append("e+");
+      this->appendUnsigned(static_cast<uint64_t>(exponent), 2);
+    }
+  }
+
+  /** \brief append the URI of a wire-encoded Name
+   */
+  void
+  appendName(const uint8_t* pos, const uint8_t* end)
+  {
+    uint64_t type = 0;
+    uint64_t length = 0;
+    if (!readTypeLength(pos, end, type, length) || type != tlv::Name) {
+      this->append("(malformed name)");
+      return;
+    }
+
+    end = pos + length;
+    if (pos == end) {
+      this->append('/');
+    }
+    while (pos < end) {
+      if (!readTypeLength(pos, end, type, length)) {
+        this->append("/(malformed component)");
+        return;
+      }
+      this->append('/');
+      if (type == tlv::ImplicitSha256DigestComponent) {
+        this->append("sha256digest=");
+        for (const uint8_t* i = pos; i != pos + length; ++i) {
+          this->appendHexOctet(*i, "0123456789abcdef");
+        }
+      }
+      else {
+        this->appendComponentValue(pos, pos + length);
+      }
+      pos += length;
+    }
+  }
+
+  /** \brief append the name of a wire-encoded Interest or Data, whose first element is the Name
+   */
+  void
+  appendPacketName(const uint8_t* pos, const uint8_t* end, uint32_t packetType)
+  {
+    uint64_t type = 0;
+    uint64_t length = 0;
+    if (!readTypeLength(pos, end, type, length) || type != packetType) {
+      this->append("(malformed packet)");
+      return;
+    }
+    this->appendName(pos, pos + length);
+  }
+
+private:
+  void
+  appendHexOctet(uint8_t octet, const char* hexDigits)
+  {
+    this->append(hexDigits[octet >> 4]);
+    this->append(hexDigits[octet & 0x0F]);
+  }
+
+  /** \brief append a name component value, escaped in the same way as name::Component::toUri
+   */
+  void
+  appendComponentValue(const uint8_t* begin, const uint8_t* end)
+  {
+    if (std::find_if(begin, end, [] (uint8_t x) { return x != '.'; }) == end) {
+      this->append("...");
+      this->append(reinterpret_cast<const char*>(begin), end - begin);
+      return;
+    }
+
+    for (const uint8_t* i = begin; i != end; ++i) {
+      uint8_t x = *i;
+      if ((x >= '0' && x <= '9') || (x >= 'A' && x <= 'Z') || (x >= 'a' && x <= 'z') ||
+          x == '+' || x == '-' || x == '.' || x == '_') {
+        this->append(static_cast<char>(x));
+      }
+      else {
+        this->append('%');
+        this->appendHexOctet(x, "0123456789ABCDEF");
+      }
+    }
+  }
+
+  static bool
+  readVarNumber(const uint8_t*& pos, const uint8_t* end, uint64_t& number)
+  {
+    if (pos >= end) {
+      return false;
+    }
+    uint8_t first = *pos++;
+    if (first < 253) {
+      number = first;
+      return true;
+    }
+
+    size_t size = first == 253 ? 2 : first == 254 ? 4 : 8;
+    if (static_cast<size_t>(end - pos) < size) {
+      return false;
+    }
+    number = 0;
+    for (size_t i = 0; i < size; ++i) {
+      number = (number << 8) | *pos++;
+    }
+    return true;
+  }
+
+  static bool
+  readTypeLength(const uint8_t*& pos, const uint8_t* end, uint64_t& type, uint64_t& length)
+  {
+    return readVarNumber(pos, end, type) && readVarNumber(pos, end, length) &&
+           length <= static_cast<uint64_t>(end - pos);
+  }
+
+private:
+  char* m_buffer;
+  size_t m_size;
+  size_t m_length;
+};
+
+/** \brief signals upon which the crash recorder is dumped
+ */
+const int CRASH_SIGNALS[] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};
+const size_t N_CRASH_SIGNALS = sizeof(CRASH_SIGNALS) / sizeof(CRASH_SIGNALS[0]);
+
+std::atomic<FlightRecorder*> g_crashRecorder(nullptr);
+struct sigaction g_previousActions[N_CRASH_SIGNALS];
+
+void
+handleCrashSignal(int signalNumber)
+{
+  // dump at most once, even if the dump itself crashes
+  FlightRecorder* recorder = g_crashRecorder.exchange(nullptr);
+  if (recorder != nullptr) {
+    recorder->dumpToCrashFile();
+  }
+
+  for (size_t i = 0; i < N_CRASH_SIGNALS; ++i) {
+    if (CRASH_SIGNALS[i] == signalNumber) {
+      ::sigaction(signalNumber, &g_previousActions[i], nullptr);
+    }
+  }
+  ::raise(signalNumber);
+}
+
+} // namespace
+
+FlightRecorder::FlightRecorder(size_t capacity, const std::string& crashDumpFile)
+  : m_slots(new Slot[detail::roundUpToPowerOfTwo(capacity)])
+  , m_mask(detail::roundUpToPowerOfTwo(capacity) - 1)
+  , m_crashDumpFile(crashDumpFile)
+  , m_nextTicket(0)
+  , m_nDropped(0)
+{
+  static_assert(sizeof(Slot) <= 256, "Slot should not exceed 256 octets");
+
+  for (uint64_t i = 0; i <= m_mask; ++i) {
+    // touch every slot now, so that recording does not incur page faults
+    m_slots[i].sequence.store(0, std::memory_order_relaxed);
+    std::memset(&m_slots[i].data, 0, sizeof(SlotData));
+  }
+}
+
+void
+FlightRecorder::record(const LogRecord& record)
+{
+  uint64_t ticket = m_nextTicket.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = m_slots[ticket & m_mask];
+
+  // claim the slot, unless another writer is still using it after the ring wrapped around
+  uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  if ((sequence & 1) != 0 || sequence > 2 * ticket ||
+      !slot.sequence.compare_exchange_strong(sequence, 2 * ticket + 1,
+                                             std::memory_order_relaxed)) {
+    m_nDropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.data.timestamp = LogTimestamp::toNanoseconds(record.getTimestamp());
+  slot.data.site = &record.getCallSite();
+  flatten(record, slot.data);
+
+  slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+}
+
+void
+FlightRecorder::flatten(const LogRecord& record, SlotData& data)
+{
+  typedef LogRecord::EntryType EntryType;
+
+  const uint8_t* pos = record.m_payload.data();
+  const uint8_t* end = pos + record.m_payload.size();
+  uint8_t* output = data.payload;
+  uint8_t* outputEnd = data.payload + sizeof(data.payload);
+  data.isTruncated = false;
+
+  while (pos < end) {
+    EntryType type = static_cast<EntryType>(*pos++);
+    size_t room = outputEnd - output;
+
+    switch (type) {
+    case EntryType::INTEREST:
+    case EntryType::INLINE_NAME:
+    case EntryType::INLINE_DATA: {
+      // already inlined as {length, octets}
+      uint32_t length;
+      std::memcpy(&length, pos, sizeof(length));
+      size_t entrySize = sizeof(length) + length;
+      if (room < 1 + entrySize) {
+        break;
+      }
+      if (type == EntryType::INLINE_NAME) {
+        type = EntryType::NAME;
+      }
+      else if (type == EntryType::INLINE_DATA) {
+        type = EntryType::DATA;
+      }
+      *output++ = static_cast<uint8_t>(type);
+      std::memcpy(output, pos, entrySize);
+      output += entrySize;
+      pos += entrySize;
+      continue;
+    }
+    case EntryType::NAME:
+    case EntryType::DATA: {
+      // a referenced wire encoding is inlined as {length, octets}
+      uint32_t fields[3]; // index, offset, length
+      std::memcpy(fields, pos, sizeof(fields));
+      pos += sizeof(fields);
+      if (room < 1 + sizeof(uint32_t) + fields[2]) {
+        break;
+      }
+      *output++ = static_cast<uint8_t>(type);
+      std::memcpy(output, &fields[2], sizeof(uint32_t));
+      output += sizeof(uint32_t);
+      std::memcpy(output, record.m_buffers[fields[0]]->data() + fields[1], fields[2]);
+      output += fields[2];
+      continue;
+    }
+    case EntryType::STRING: {
+      uint32_t length;
+      std::memcpy(&length, pos, sizeof(length));
+      pos += sizeof(length);
+      if (room < 1 + sizeof(length)) {
+        break;
+      }
+      // keep the beginning of a long string
+      uint32_t outputLength = static_cast<uint32_t>(std::min<size_t>(length,
+                                                                     room - 1 - sizeof(length)));
+      *output++ = static_cast<uint8_t>(type);
+      std::memcpy(output, &outputLength, sizeof(outputLength));
+      output += sizeof(outputLength);
+      std::memcpy(output, pos, outputLength);
+      output += outputLength;
+      pos += length;
+      if (outputLength < length) {
+        break;
+      }
+      continue;
+    }
+    default: {
+      size_t valueSize = 0;
+      switch (type) {
+      case EntryType::CHAR:
+      case EntryType::BOOL:
+        valueSize = 1;
+        break;
+      case EntryType::LITERAL:
+        valueSize = sizeof(const char*);
+        break;
+      case EntryType::MANIPULATOR:
+        valueSize = sizeof(std::ostream& (*)(std::ostream&));
+        break;
+      case EntryType::IOS_MANIPULATOR:
+      case EntryType::FORMAT:
+        // a dump ignores formatting, so that the slot is not spent on it
+        pos += type == EntryType::FORMAT ? sizeof(LogRecord::FormatChange) :
+                                           sizeof(std::ios_base& (*)(std::ios_base&));
+        continue;
+      default: // INT, UINT, DOUBLE
+        valueSize = 8;
+        break;
+      }
+      if (room < 1 + valueSize) {
+        break;
+      }
+      *output++ = static_cast<uint8_t>(type);
+      std::memcpy(output, pos, valueSize);
+      output += valueSize;
+      pos += valueSize;
+      continue;
+    }
+    }
+
+    // the entry does not fit
+    data.isTruncated = true;
+    break;
+  }
+
+  data.payloadSize = static_cast<uint16_t>(output - data.payload);
+}
+
+size_t
+FlightRecorder::render(const SlotData& data, char* buffer, size_t bufferSize)
+{
+  typedef LogRecord::EntryType EntryType;
+
+  BOOST_ASSERT(bufferSize > 0);
+  LineWriter line(buffer, bufferSize - 1); // reserve room for line terminator
+
+  int64_t microseconds = data.timestamp / 1000;
+  line.appendSigned(microseconds / 1000000);
+  line.append('.');
+  line.appendUnsigned(static_cast<uint64_t>(microseconds % 1000000), 6);
+  line.append(' ');
+  line.append(getLevelLabel(data.site->getLevel()));
+  line.append(": [");
+  const std::string& moduleName = data.site->getLogger().getModuleName();
+  line.append(moduleName.data(), moduleName.size());
+  line.append("] ");
+
+  const uint8_t* pos = data.payload;
+  const uint8_t* end = data.payload + data.payloadSize;
+  while (pos < end) {
+    EntryType type = static_cast<EntryType>(*pos++);
+    switch (type) {
+    case EntryType::INT: {
+      int64_t value;
+      std::memcpy(&value, pos, sizeof(value));
+      pos += sizeof(value);
+      line.appendSigned(value);
+      break;
+    }
+    case EntryType::UINT: {
+      uint64_t value;
+      std::memcpy(&value, pos, sizeof(value));
+      pos += sizeof(value);
+      line.appendUnsigned(value);
+      break;
+    }
+    case EntryType::DOUBLE: {
+      double value;
+      std::memcpy(&value, pos, sizeof(value));
+      pos += sizeof(value);
+      line.appendDouble(value);
+      break;
+    }
+    case EntryType::CHAR:
+      line.append(static_cast<char>(*pos++));
+      break;
+    case EntryType::BOOL:
+      line.append(*pos++ != 0 ? '1' : '0');
+      break;
+    case EntryType::LITERAL: {
+      const char* literal;
+      std::memcpy(&literal, pos, sizeof(literal));
+      pos += sizeof(literal);
+      line.append(literal);
+      break;
+    }
+    case EntryType::STRING:
+    case EntryType::NAME:
+    case EntryType::INTEREST:
+    case EntryType::DATA: {
+      uint32_t length;
+      std::memcpy(&length, pos, sizeof(length));
+      pos += sizeof(length);
+      if (type == EntryType::STRING) {
+        line.append(reinterpret_cast<const char*>(pos), length);
+      }
+      else if (type == EntryType::NAME) {
+        line.appendName(pos, pos + length);
+      }
+      else {
+        line.appendPacketName(pos, pos + length, type == EntryType::INTEREST ?
+                                                 tlv::Interest : tlv::Data);
+      }
+      pos += length;
+      break;
+    }
+    case EntryType::MANIPULATOR:
+      // std::flush and similar manipulators do not produce text
+      pos += sizeof(std::ostream& (*)(std::ostream&));
+      break;
+    case EntryType::IOS_MANIPULATOR:
+    case EntryType::FORMAT:
+      // omitted by flatten
+      break;
+    case EntryType::INLINE_NAME:
+    case EntryType::INLINE_DATA:
+      // stored as NAME and DATA by flatten
+      break;
+    }
+  }
+
+  if (data.isTruncated) {
+    line.append("...");
+  }
+
+  size_t length = line.getLength();
+  buffer[length++] = '\n';
+  return length;
+}
+
+void
+FlightRecorder::dump(int fd) const
+{
+  uint64_t last = m_nextTicket.load(std::memory_order_acquire);
+  uint64_t first = last > this->getCapacity() ? last - this->getCapacity() : 0;
+
+  SlotData data;
+  char line[1024];
+  for (uint64_t ticket = first; ticket < last; ++ticket) {
+    const Slot& slot = m_slots[ticket & m_mask];
+    uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * ticket + 2) {
+      // still being written, dropped, or already overwritten
+      continue;
+    }
+    std::memcpy(&data, &slot.data, sizeof(data));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+
+    size_t length = render(data, line, sizeof(line));
+    const char* pos = line;
+    while (length > 0) {
+      ssize_t nWritten = ::write(fd, pos, length);
+      if (nWritten < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return;
+      }
+      pos += nWritten;
+      length -= static_cast<size_t>(nWritten);
+    }
+  }
+}
+
+bool
+FlightRecorder::dumpToFile(const char* filename) const
+{
+  int fd = ::open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  this->dump(fd);
+  ::close(fd);
+  return true;
+}
+
+void
+FlightRecorder::dumpToCrashFile() const
+{
+  if (!m_crashDumpFile.empty()) {
+    this->dumpToFile(m_crashDumpFile.c_str());
+  }
+}
+
+void
+FlightRecorder::setCrashRecorder(FlightRecorder* recorder)
+{
+  static bool hasHandlers = false;
+  g_crashRecorder.store(recorder);
+  if (recorder == nullptr || hasHandlers) {
+    return;
+  }
+
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_handler = &handleCrashSignal;
+  sigemptyset(&action.sa_mask);
+  for (size_t i = 0; i < N_CRASH_SIGNALS; ++i) {
+    ::sigaction(CRASH_SIGNALS[i], &action, &g_previousActions[i]);
+  }
+  hasHandlers = true;
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_FLIGHT_RECORDER_HPP
+#define NDN_UTIL_LOGGER_FLIGHT_RECORDER_HPP
+
+#include "logger-record.hpp"
+
+#include <atomic>
+
+namespace ndn {
+namespace util {
+
+/** \brief an in-memory history of the most recent log records
+ *
+ *  The flight recorder keeps the last \p capacity records in a preallocated ring of fixed-size
+ *  slots.  Recording a record copies its binary payload into a slot without formatting it,
+ *  without allocating memory beyond what the LogRecord itself has allocated for its payload,
+ *  and without taking a lock, so that it can capture every level at a small fraction of the
+ *  cost of a text sink.
+ *
+ *  Messages are rendered only when the history is dumped.  Dumping is async-signal-safe,
+ *  which allows the history to be saved from a handler of a fatal signal.  In a dump, an
+ *  Interest is rendered by its name, stream manipulators such as std::hex are ignored, and a
+ *  message that did not fit into a slot ends with "...".
+ */
+class FlightRecorder : noncopyable
+{
+public:
+  /** \param capacity number of records to keep, rounded up to a power of two
+   *  \param crashDumpFile where dumpToCrashFile() writes the history; empty to disable
+   */
+  explicit
+  FlightRecorder(size_t capacity, const std::string& crashDumpFile = "");
+
+  size_t
+  getCapacity() const
+  {
+    return m_mask + 1;
+  }
+
+  const std::string&
+  getCrashDumpFile() const
+  {
+    return m_crashDumpFile;
+  }
+
+  /** \return number of records that have been recorded, including overwritten ones
+   */
+  uint64_t
+  getNRecorded() const
+  {
+    return m_nextTicket.load(std::memory_order_relaxed) - this->getNDropped();
+  }
+
+  /** \return number of records lost because their slot was being written by another thread
+   */
+  uint64_t
+  getNDropped() const
+  {
+    return m_nDropped.load(std::memory_order_relaxed);
+  }
+
+  /** \brief copy \p record into the ring, overwriting the oldest record
+   *  \note This function is thread-safe and lock-free.
+   */
+  void
+  record(const LogRecord& record);
+
+  /** \brief write the recorded history as text lines to file descriptor \p fd
+   *
+   *  The format of each line is the same as with the default LoggerBackend.
+   *  \note This function is async-signal-safe.
+   */
+  void
+  dump(int fd) const;
+
+  /** \brief write the recorded history to \p filename, replacing an existing file
+   *  \return whether the file could be opened
+   *  \note This function is async-signal-safe.
+   */
+  bool
+  dumpToFile(const char* filename) const;
+
+  /** \brief write the recorded history to the crash dump file, if one is set
+   *  \note This function is async-signal-safe.
+   */
+  void
+  dumpToCrashFile() const;
+
+  /** \brief dump the history of \p recorder to its crash dump file when the process receives
+   *         SIGSEGV, SIGBUS, SIGILL, SIGFPE, or SIGABRT
+   *  \param recorder the recorder to dump, or nullptr to disable dumping
+   *
+   *  The signal handlers are installed upon the first call with a recorder.  After dumping,
+   *  a handler restores the previous disposition and raises the signal again.
+   */
+  static void
+  setCrashRecorder(FlightRecorder* recorder);
+
+private:
+  /** \brief fixed-size part of a slot
+   */
+  struct SlotData
+  {
+    int64_t timestamp; ///< nanoseconds since epoch
+    const LogCallSite* site;
+    uint16_t payloadSize;
+    bool isTruncated;
+    uint8_t payload[229];
+  };
+
+  /** \brief a slot guarded by a sequence lock
+   *
+   *  While the record of ticket t is being written, sequence is 2t+1; afterwards it is 2t+2.
+   */
+  struct Slot
+  {
+    std::atomic<uint64_t> sequence;
+    SlotData data;
+  };
+
+  /** \brief copy the payload of \p record into \p data, inlining referenced wire encodings
+   */
+  static void
+  flatten(const LogRecord& record, SlotData& data);
+
+  /** \brief render \p data as a line of text into \p buffer
+   *  \return length of the line
+   */
+  static size_t
+  render(const SlotData& data, char* buffer, size_t bufferSize);
+
+private:
+  std::unique_ptr<Slot[]> m_slots;
+  const uint64_t m_mask;
+  const std::string m_crashDumpFile;
+  std::atomic<uint64_t> m_nextTicket;
+  std::atomic<uint64_t> m_nDropped;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_FLIGHT_RECORDER_HPP
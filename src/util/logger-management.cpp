@@ -0,0 +1,311 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-management.hpp"
+#include "logger-tlv.hpp"
+#include "../encoding/block-helpers.hpp"
+#include "../encoding/encoding-buffer.hpp"
+#include "../encoding/tlv-nfd.hpp"
+
+namespace ndn {
+namespace util {
+
+static uint64_t
+encodeLevel(LogLevel level)
+{
+  return static_cast<uint64_t>(static_cast<int>(level) + 1);
+}
+
+static LogLevel
+decodeLevel(const Block& block)
+{
+  uint64_t value = readNonNegativeInteger(block);
+  switch (value) {
+  case 0:
+  case 1:
+  case 2:
+  case 3:
+  case 4:
+  case 5:
+  case 6:
+  case 256:
+    return static_cast<LogLevel>(static_cast<int>(value) - 1);
+  default:
+    BOOST_THROW_EXCEPTION(tlv::Error("invalid Level " + to_string(value)));
+  }
+}
+
+LoggerControlParameters::LoggerControlParameters()
+  : m_hasModuleName(false)
+  , m_hasLevel(false)
+  , m_level(LogLevel::NONE)
+  , m_hasDuration(false)
+{
+}
+
+LoggerControlParameters::LoggerControlParameters(const Block& wire)
+{
+  this->wireDecode(wire);
+}
+
+Block
+LoggerControlParameters::wireEncode() const
+{
+  EncodingBuffer encoder;
+  size_t totalLength = 0;
+
+  if (m_hasDuration) {
+    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::logging::Duration,
+                                                  m_duration.count());
+  }
+  if (m_hasLevel) {
+    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::logging::Level,
+                                                  encodeLevel(m_level));
+  }
+  if (m_hasModuleName) {
+    totalLength += prependStringBlock(encoder, tlv::logging::ModuleName, m_moduleName);
+  }
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::nfd::ControlParameters);
+  return encoder.block();
+}
+
+void
+LoggerControlParameters::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::nfd::ControlParameters) {
+    BOOST_THROW_EXCEPTION(Error("expecting ControlParameters block"));
+  }
+  wire.parse();
+
+  Block::element_const_iterator val = wire.find(tlv::logging::ModuleName);
+  m_hasModuleName = val != wire.elements_end();
+  if (m_hasModuleName) {
+    m_moduleName = readString(*val);
+  }
+
+  val = wire.find(tlv::logging::Level);
+  m_hasLevel = val != wire.elements_end();
+  m_level = m_hasLevel ? decodeLevel(*val) : LogLevel::NONE;
+
+  val = wire.find(tlv::logging::Duration);
+  m_hasDuration = val != wire.elements_end();
+  if (m_hasDuration) {
+    m_duration = time::milliseconds(readNonNegativeInteger(*val));
+  }
+}
+
+LoggerControlParameters&
+LoggerControlParameters::setModuleName(const std::string& moduleName)
+{
+  m_hasModuleName = true;
+  m_moduleName = moduleName;
+  return *this;
+}
+
+LoggerControlParameters&
+LoggerControlParameters::setLevel(LogLevel level)
+{
+  m_hasLevel = true;
+  m_level = level;
+  return *this;
+}
+
+LoggerControlParameters&
+LoggerControlParameters::setDuration(time::milliseconds duration)
+{
+  m_hasDuration = true;
+  m_duration = duration;
+  return *this;
+}
+
+LoggerModuleStatus::LoggerModuleStatus(const LoggerFactory::ModuleStatus& status)
+  : m_status(status)
+{
+}
+
+LoggerModuleStatus::LoggerModuleStatus(const Block& wire)
+{
+  this->wireDecode(wire);
+}
+
+Block
+LoggerModuleStatus::wireEncode() const
+{
+  EncodingBuffer encoder;
+  size_t totalLength = 0;
+
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::logging::DropCount,
+                                                m_status.nDropped);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::logging::RecordCount,
+                                                m_status.nRecords);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::logging::Level,
+                                                encodeLevel(m_status.level));
+  totalLength += prependStringBlock(encoder, tlv::logging::ModuleName, m_status.moduleName);
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::logging::ModuleStatus);
+  return encoder.block();
+}
+
+void
+LoggerModuleStatus::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::logging::ModuleStatus) {
+    BOOST_THROW_EXCEPTION(Error("expecting ModuleStatus block"));
+  }
+  wire.parse();
+
+  Block::element_const_iterator val = wire.elements_begin();
+  auto expect = [&] (uint32_t type, const char* field) {
+    if (val == wire.elements_end() || val->type() != type) {
+      BOOST_THROW_EXCEPTION(Error(std::string("missing required ") + field + " field"));
+    }
+    return *val++;
+  };
+
+  m_status.moduleName = readString(expect(tlv::logging::ModuleName, "ModuleName"));
+  m_status.level = decodeLevel(expect(tlv::logging::Level, "Level"));
+  m_status.nRecords = readNonNegativeInteger(expect(tlv::logging::RecordCount, "RecordCount"));
+  m_status.nDropped = readNonNegativeInteger(expect(tlv::logging::DropCount, "DropCount"));
+}
+
+LoggerManagement::PendingRestore::PendingRestore(Scheduler& scheduler)
+  : previousLevel(LogLevel::NONE)
+  , hadLevel(false)
+  , event(scheduler)
+{
+}
+
+LoggerManagement::LoggerManagement(Face& face, mgmt::Dispatcher& dispatcher,
+                                   const mgmt::Authorization& authorization,
+                                   const PartialName& relPrefix)
+  : m_scheduler(face.getIoService())
+{
+  dispatcher.addControlCommand<LoggerControlParameters>(
+    PartialName(relPrefix).append("set-level"), authorization,
+    &LoggerManagement::validateSetLevel,
+    [this] (const Name&, const Interest&, const mgmt::ControlParameters& parameters,
+            const mgmt::CommandContinuation& done) {
+      this->setLevel(parameters, done);
+    });
+
+  dispatcher.addStatusDataset(PartialName(relPrefix).append("modules"), authorization,
+    [this] (const Name&, const Interest&, mgmt::StatusDatasetContext& context) {
+      this->listModules(context);
+    });
+}
+
+/** \return length of the prefix matched by a wildcard \p moduleName "*" or "Prefix.*",
+ *          including the trailing '.'; or std::string::npos if \p moduleName is not a wildcard
+ */
+static size_t
+getWildcardPrefixLength(const std::string& moduleName)
+{
+  if (moduleName == "*") {
+    return 0;
+  }
+  if (moduleName.size() > 2 && moduleName.compare(moduleName.size() - 2, 2, ".*") == 0) {
+    return moduleName.size() - 1;
+  }
+  return std::string::npos;
+}
+
+bool
+LoggerManagement::validateSetLevel(const mgmt::ControlParameters& parameters)
+{
+  const auto& params = static_cast<const LoggerControlParameters&>(parameters);
+  if (!params.hasModuleName() || params.getModuleName().empty() || !params.hasLevel()) {
+    return false;
+  }
+
+  // '*' is allowed only as the last component
+  const std::string& moduleName = params.getModuleName();
+  size_t prefixLength = getWildcardPrefixLength(moduleName);
+  if (moduleName.find('*') < std::min(prefixLength, moduleName.size())) {
+    return false;
+  }
+
+  if (params.hasDuration()) {
+    return prefixLength == std::string::npos && params.getDuration() > time::milliseconds::zero();
+  }
+  return true;
+}
+
+void
+LoggerManagement::setLevel(const mgmt::ControlParameters& parameters,
+                           const mgmt::CommandContinuation& done)
+{
+  const auto& params = static_cast<const LoggerControlParameters&>(parameters);
+  const std::string& moduleName = params.getModuleName();
+
+  size_t prefixLength = getWildcardPrefixLength(moduleName);
+  if (prefixLength != std::string::npos) {
+    // a wildcard discards the individual levels of matching modules, including those to be
+    // restored
+    auto it = m_pendingRestores.lower_bound(moduleName.substr(0, prefixLength));
+    while (it != m_pendingRestores.end() &&
+           it->first.compare(0, prefixLength, moduleName, 0, prefixLength) == 0) {
+      it = m_pendingRestores.erase(it);
+    }
+  }
+  else if (params.hasDuration()) {
+    auto it = m_pendingRestores.find(moduleName);
+    if (it == m_pendingRestores.end()) {
+      // if a temporary level is already in effect, the level before it is restored
+      it = m_pendingRestores.emplace(std::piecewise_construct, std::forward_as_tuple(moduleName),
+                                     std::forward_as_tuple(m_scheduler)).first;
+      it->second.previousLevel = LoggerFactory::getSeverityLevel(moduleName);
+      it->second.hadLevel = LoggerFactory::hasSeverityLevel(moduleName);
+    }
+    it->second.event = m_scheduler.scheduleEvent(params.getDuration(), [this, moduleName] {
+      auto restore = m_pendingRestores.find(moduleName);
+      if (restore->second.hadLevel) {
+        LoggerFactory::setSeverityLevel(moduleName, restore->second.previousLevel);
+      }
+      else {
+        // the module takes the level of its prefixes again, including changes made meanwhile
+        LoggerFactory::resetSeverityLevel(moduleName);
+      }
+      m_pendingRestores.erase(restore);
+    });
+  }
+  else {
+    m_pendingRestores.erase(moduleName);
+  }
+
+  LoggerFactory::setSeverityLevel(moduleName, params.getLevel());
+  done(mgmt::ControlResponse(200, "OK").setBody(params.wireEncode()));
+}
+
+void
+LoggerManagement::listModules(mgmt::StatusDatasetContext& context)
+{
+  for (const LoggerFactory::ModuleStatus& status : LoggerFactory::getModuleStatus()) {
+    context.append(LoggerModuleStatus(status).wireEncode());
+  }
+  context.end();
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_MANAGEMENT_HPP
+#define NDN_UTIL_LOGGER_MANAGEMENT_HPP
+
+#include "logger-factory.hpp"
+#include "scheduler.hpp"
+#include "scheduler-scoped-event-id.hpp"
+#include "../mgmt/dispatcher.hpp"
+
+namespace ndn {
+namespace util {
+
+/** \brief parameters of the set-level command of LoggerManagement
+ */
+class LoggerControlParameters : public mgmt::ControlParameters
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : tlv::Error(what)
+    {
+    }
+  };
+
+  LoggerControlParameters();
+
+  explicit
+  LoggerControlParameters(const Block& wire);
+
+  Block
+  wireEncode() const NDN_CXX_DECL_OVERRIDE;
+
+  void
+  wireDecode(const Block& wire) NDN_CXX_DECL_OVERRIDE;
+
+public: // getters & setters
+  bool
+  hasModuleName() const
+  {
+    return m_hasModuleName;
+  }
+
+  const std::string&
+  getModuleName() const
+  {
+    BOOST_ASSERT(m_hasModuleName);
+    return m_moduleName;
+  }
+
+  LoggerControlParameters&
+  setModuleName(const std::string& moduleName);
+
+  bool
+  hasLevel() const
+  {
+    return m_hasLevel;
+  }
+
+  LogLevel
+  getLevel() const
+  {
+    BOOST_ASSERT(m_hasLevel);
+    return m_level;
+  }
+
+  LoggerControlParameters&
+  setLevel(LogLevel level);
+
+  bool
+  hasDuration() const
+  {
+    return m_hasDuration;
+  }
+
+  /** \return how long the level applies before the previous level is restored
+   */
+  time::milliseconds
+  getDuration() const
+  {
+    BOOST_ASSERT(m_hasDuration);
+    return m_duration;
+  }
+
+  LoggerControlParameters&
+  setDuration(time::milliseconds duration);
+
+private:
+  bool m_hasModuleName;
+  std::string m_moduleName;
+  bool m_hasLevel;
+  LogLevel m_level;
+  bool m_hasDuration;
+  time::milliseconds m_duration;
+};
+
+/** \brief an entry of the module status dataset of LoggerManagement
+ */
+class LoggerModuleStatus
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : tlv::Error(what)
+    {
+    }
+  };
+
+  explicit
+  LoggerModuleStatus(const LoggerFactory::ModuleStatus& status);
+
+  explicit
+  LoggerModuleStatus(const Block& wire);
+
+  Block
+  wireEncode() const;
+
+  void
+  wireDecode(const Block& wire);
+
+  const LoggerFactory::ModuleStatus&
+  get() const
+  {
+    return m_status;
+  }
+
+private:
+  LoggerFactory::ModuleStatus m_status;
+};
+
+/** \brief allows controlling module levels and reading module status through a Dispatcher
+ *
+ *  This registers the following under the top prefixes of the Dispatcher:
+ *  \li relPrefix/set-level: a control command with LoggerControlParameters that sets the level
+ *      of a module, or of all matching modules if the module name is a pattern "Prefix.*" or "*",
+ *      as in LoggerFactory::setSeverityLevels.  If a Duration is given, the previous level of
+ *      the module is restored when it elapses, or its level is removed if it took the level of
+ *      a pattern; this is not allowed for a pattern.
+ *  \li relPrefix/modules: a status dataset of LoggerModuleStatus entries, one per module.
+ *
+ *  The LoggerManagement must outlive the Dispatcher, which keeps references to it.
+ */
+class LoggerManagement : noncopyable
+{
+public:
+  /** \brief register the command and the dataset with \p dispatcher
+   *  \param face the Face of \p dispatcher, whose io_service runs the level restore timers
+   *  \pre no top prefix has been added to \p dispatcher
+   */
+  LoggerManagement(Face& face, mgmt::Dispatcher& dispatcher,
+                   const mgmt::Authorization& authorization,
+                   const PartialName& relPrefix = "log");
+
+private:
+  static bool
+  validateSetLevel(const mgmt::ControlParameters& parameters);
+
+  void
+  setLevel(const mgmt::ControlParameters& parameters, const mgmt::CommandContinuation& done);
+
+  void
+  listModules(mgmt::StatusDatasetContext& context);
+
+private:
+  /** \brief a temporary level that will be reverted
+   */
+  struct PendingRestore
+  {
+    explicit
+    PendingRestore(Scheduler& scheduler);
+
+    LogLevel previousLevel;
+    bool hadLevel; ///< whether previousLevel was set for the module itself
+    scheduler::ScopedEventId event;
+  };
+
+  Scheduler m_scheduler;
+  std::map<std::string, PendingRestore> m_pendingRestores; ///< module name => restore
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_MANAGEMENT_HPP
@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-mapped-file-sink.hpp"
+#include "logger-timestamp.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+namespace ndn {
+namespace util {
+
+MappedFileLogSink::Options::Options()
+  : fileSize(64 * 1024 * 1024)
+  , rotationInterval(0)
+  , nRotatedFiles(4)
+  , durability(Durability::NONE)
+  , syncInterval(1000)
+{
+}
+
+MappedFileLogSink::MappedFileLogSink(const std::string& path, const Options& options)
+  : m_path(path)
+  , m_options(options)
+  , m_fd(-1)
+  , m_map(nullptr)
+  , m_offset(0)
+  , m_syncedOffset(0)
+  , m_nDropped(0)
+  , m_formatter(m_line)
+  , m_shouldStop(false)
+{
+  if (m_options.fileSize == 0) {
+    BOOST_THROW_EXCEPTION(Error("Log file size must be positive"));
+  }
+  if (!this->openFile()) {
+    BOOST_THROW_EXCEPTION(Error("Cannot create log file " + m_path + ": " + std::strerror(errno)));
+  }
+
+  if (m_options.durability == Durability::PERIODIC_SYNC) {
+    m_syncer = std::thread(&MappedFileLogSink::runSyncer, this);
+  }
+}
+
+MappedFileLogSink::~MappedFileLogSink()
+{
+  if (m_syncer.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_shouldStop = true;
+    }
+    m_syncerCv.notify_one();
+    m_syncer.join();
+  }
+
+  this->closeFile();
+}
+
+void
+MappedFileLogSink::write(const LogRecord& record)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const time::system_clock::TimePoint& timestamp = record.getTimestamp();
+  if (timestamp >= m_rotationTime) {
+    this->rotateFile();
+  }
+
+  m_line.clear();
+  m_formatter.stream() << record << '\n';
+  m_formatter.flush();
+
+  if (m_map != nullptr && m_offset + m_line.size() > m_options.fileSize && m_offset > 0) {
+    this->rotateFile();
+  }
+  if (m_map == nullptr) {
+    ++m_nDropped;
+    return;
+  }
+
+  // a line longer than the whole file is truncated
+  size_t length = std::min(m_line.size(), m_options.fileSize - m_offset);
+  std::memcpy(m_map + m_offset, m_line.data(), length);
+  m_offset += length;
+
+  switch (m_options.durability) {
+  case Durability::NONE:
+    break;
+  case Durability::PERIODIC_SYNC:
+    this->syncIfDue(timestamp);
+    break;
+  case Durability::SYNC_ON_ERROR:
+    if (record.getLevel() <= LogLevel::ERROR) {
+      this->sync();
+    }
+    break;
+  }
+}
+
+void
+MappedFileLogSink::flush()
+{
+  if (m_options.durability == Durability::PERIODIC_SYNC) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    this->syncIfDue(LogTimestamp::now());
+  }
+}
+
+size_t
+MappedFileLogSink::getSyncedSize() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_syncedOffset;
+}
+
+void
+MappedFileLogSink::rotate()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  this->rotateFile();
+}
+
+void
+MappedFileLogSink::rotateFile()
+{
+  // after a failure to create the file, there is nothing to rename
+  if (m_fd >= 0) {
+    this->closeFile();
+
+    if (m_options.nRotatedFiles == 0) {
+      std::remove(m_path.data());
+    }
+    else {
+      for (size_t i = m_options.nRotatedFiles - 1; i > 0; --i) {
+        std::rename((m_path + '.' + to_string(i)).data(),
+                    (m_path + '.' + to_string(i + 1)).data());
+      }
+      std::rename(m_path.data(), (m_path + ".1").data());
+    }
+  }
+
+  this->openFile();
+}
+
+bool
+MappedFileLogSink::openFile()
+{
+  BOOST_ASSERT(m_fd < 0);
+  m_offset = m_syncedOffset = 0;
+  // same clock as record timestamps, which are compared against the deadlines
+  time::system_clock::TimePoint now = LogTimestamp::now();
+  m_syncTime = now + m_options.syncInterval;
+  if (m_options.rotationInterval > time::seconds::zero()) {
+    m_rotationTime = now + m_options.rotationInterval;
+  }
+  else {
+    m_rotationTime = time::system_clock::TimePoint::max();
+  }
+
+  m_fd = ::open(m_path.data(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (m_fd >= 0) {
+    int result = -1;
+#ifdef __linux__
+    // allocate blocks upfront, so that writing into the mapping cannot fail for lack of space
+    result = ::posix_fallocate(m_fd, 0, m_options.fileSize);
+#endif // __linux__
+    if (result != 0) {
+      result = ::ftruncate(m_fd, m_options.fileSize);
+    }
+
+    if (result == 0) {
+      void* map = ::mmap(nullptr, m_options.fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+      if (map != MAP_FAILED) {
+        m_map = static_cast<char*>(map);
+        return true;
+      }
+    }
+
+    int error = errno;
+    ::close(m_fd);
+    m_fd = -1;
+    errno = error;
+  }
+
+  // try again later
+  m_rotationTime = now + time::seconds(1);
+  return false;
+}
+
+void
+MappedFileLogSink::closeFile()
+{
+  if (m_map != nullptr) {
+    if (m_options.durability != Durability::NONE) {
+      this->sync();
+    }
+    ::munmap(m_map, m_options.fileSize);
+    m_map = nullptr;
+  }
+
+  if (m_fd >= 0) {
+    // discard the unused part of the preallocated file; if this fails, the remainder reads as
+    // NUL characters, as after abnormal termination
+    int result = ::ftruncate(m_fd, m_offset);
+    static_cast<void>(result);
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+void
+MappedFileLogSink::sync()
+{
+  if (m_offset == m_syncedOffset) {
+    return;
+  }
+
+  static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  size_t begin = m_syncedOffset / pageSize * pageSize;
+  ::msync(m_map + begin, m_offset - begin, MS_SYNC);
+  m_syncedOffset = m_offset;
+}
+
+void
+MappedFileLogSink::syncIfDue(const time::system_clock::TimePoint& now)
+{
+  if (now >= m_syncTime) {
+    this->sync();
+    m_syncTime = now + m_options.syncInterval;
+  }
+}
+
+void
+MappedFileLogSink::runSyncer()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_shouldStop) {
+    m_syncerCv.wait_for(lock, std::chrono::milliseconds(m_options.syncInterval.count()));
+    if (!m_shouldStop) {
+      this->syncIfDue(LogTimestamp::now());
+    }
+  }
+}
+
+} // namespace util
+} // namespace ndn
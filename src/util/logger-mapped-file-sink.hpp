@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_MAPPED_FILE_SINK_HPP
+#define NDN_UTIL_LOGGER_MAPPED_FILE_SINK_HPP
+
+#include "logger-sink.hpp"
+
+#include <boost/log/utility/formatting_ostream.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ndn {
+namespace util {
+
+/** \brief a LogSink that writes text lines into a memory-mapped log file
+ *
+ *  The log file is preallocated to a fixed size and mapped into memory, so that writing a record
+ *  is a memory copy, and no system call is made per record.  Writeback is left to the operating
+ *  system, unless a stronger Durability is selected.
+ *
+ *  The file is rotated when the next record does not fit, when the rotation interval has
+ *  elapsed, or upon rotate().  The current file is then truncated to its written size and
+ *  renamed to path.1, while existing path.1 is renamed to path.2 and so on.
+ *  If the process terminates abnormally, the current file retains its preallocated size,
+ *  and the unwritten remainder reads as NUL characters.
+ */
+class MappedFileLogSink : public LogSink
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  enum class Durability {
+    NONE,           ///< leave writeback to the operating system
+    /** \brief synchronize written records with the file every syncInterval
+     *
+     *  Records are synchronized when a record is written or flush() is invoked after the
+     *  interval has elapsed, and otherwise by a thread of the sink, so that the last records
+     *  of a burst are not left unsynchronized.
+     */
+    PERIODIC_SYNC,
+    SYNC_ON_ERROR   ///< synchronize written records with the file after an ERROR or FATAL record
+  };
+
+  struct Options
+  {
+    Options();
+
+    size_t fileSize;                  ///< size of each log file
+    time::seconds rotationInterval;   ///< maximum age of a log file; zero means unlimited
+    size_t nRotatedFiles;             ///< number of rotated files to keep
+    Durability durability;
+    time::milliseconds syncInterval;  ///< interval of PERIODIC_SYNC
+  };
+
+  /** \brief create or replace the log file at \p path
+   *  \throw Error the file cannot be created or mapped
+   */
+  explicit
+  MappedFileLogSink(const std::string& path, const Options& options = Options());
+
+  ~MappedFileLogSink() NDN_CXX_DECL_OVERRIDE;
+
+  void
+  write(const LogRecord& record) NDN_CXX_DECL_OVERRIDE;
+
+  /** \brief synchronize written records with the file if PERIODIC_SYNC is due
+   *
+   *  Written records are already visible in the file without flushing.
+   */
+  void
+  flush() NDN_CXX_DECL_OVERRIDE;
+
+  /** \brief close the current log file and start a new one
+   *  \note Like write(), this must not be invoked concurrently with other methods.
+   */
+  void
+  rotate();
+
+  const std::string&
+  getPath() const
+  {
+    return m_path;
+  }
+
+  /** \return number of records that could not be written, because the log file could not be
+   *          recreated during rotation
+   */
+  uint64_t
+  getNDropped() const
+  {
+    return m_nDropped;
+  }
+
+  /** \return number of octets at the beginning of the current log file that have been
+   *          synchronized with the file
+   */
+  size_t
+  getSyncedSize() const;
+
+private:
+  /** \return whether the file has been created and mapped
+   */
+  bool
+  openFile();
+
+  void
+  closeFile();
+
+  /** \pre m_mutex is locked
+   */
+  void
+  rotateFile();
+
+  /** \brief write back records that have not been synchronized
+   */
+  void
+  sync();
+
+  /** \brief sync() if syncInterval has elapsed since the last time
+   *  \pre m_mutex is locked
+   */
+  void
+  syncIfDue(const time::system_clock::TimePoint& now);
+
+  /** \brief invoke syncIfDue() every syncInterval, until m_shouldStop
+   */
+  void
+  runSyncer();
+
+private:
+  const std::string m_path;
+  const Options m_options;
+
+  int m_fd;
+  char* m_map;
+  size_t m_offset; ///< end of written records
+  size_t m_syncedOffset; ///< end of synchronized records
+  time::system_clock::TimePoint m_rotationTime;
+  time::system_clock::TimePoint m_syncTime;
+  uint64_t m_nDropped;
+
+  std::string m_line;
+  boost::log::formatting_ostream m_formatter;
+
+  /** \brief serializes the methods with the syncer thread, which exists with PERIODIC_SYNC
+   */
+  mutable std::mutex m_mutex;
+  std::condition_variable m_syncerCv;
+  bool m_shouldStop;
+  std::thread m_syncer;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_MAPPED_FILE_SINK_HPP
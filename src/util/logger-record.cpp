@@ -0,0 +1,264 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-record.hpp"
+#include "logger.hpp"
+#include "logger-timestamp.hpp"
+#include "../interest.hpp"
+#include "../data.hpp"
+
+#include <boost/io/ios_state.hpp>
+
+namespace ndn {
+namespace util {
+
+/** \brief initial payload capacity, sufficient for most log statements
+ */
+static const size_t INITIAL_PAYLOAD_CAPACITY = 64;
+
+LogRecord::LogRecord(const LogCallSite& site)
+  : m_site(&site)
+  , m_timestamp(LogTimestamp::now())
+{
+  m_payload.reserve(INITIAL_PAYLOAD_CAPACITY);
+}
+
+Logger&
+LogRecord::getLogger() const
+{
+  return m_site->getLogger();
+}
+
+LogLevel
+LogRecord::getLevel() const
+{
+  return m_site->getLevel();
+}
+
+void
+LogRecord::appendString(const char* str, size_t length)
+{
+  uint32_t length32 = static_cast<uint32_t>(length);
+  this->appendValue(EntryType::STRING, length32);
+  m_payload.insert(m_payload.end(), str, str + length32);
+}
+
+void
+LogRecord::appendFormat(const function<void(std::ostream&)>& manipulate)
+{
+  // apply the manipulator to streams in a known state, and see what it changes
+  std::ostringstream setter;
+  setter.flags(std::ios_base::fmtflags());
+  setter.width(-1);
+  setter.precision(-1);
+  setter.fill('\0');
+  manipulate(setter);
+
+  std::ostringstream clearer;
+  clearer.flags(~std::ios_base::fmtflags());
+  manipulate(clearer);
+
+  FormatChange change;
+  change.setFlags = setter.flags();
+  change.clearedFlags = ~clearer.flags();
+  change.width = setter.width();
+  change.precision = setter.precision();
+  change.fill = setter.fill();
+  this->appendValue(EntryType::FORMAT, change);
+}
+
+void
+LogRecord::appendWire(EntryType type, const Block& wire)
+{
+  const ConstBufferPtr& buffer = wire.getBuffer();
+  if (buffer->size() != wire.size()) {
+    // the Name of a Data, or a packet received by StreamTransport, is part of a larger buffer,
+    // which a queued record would keep alive
+    this->appendValue(type == EntryType::NAME ? EntryType::INLINE_NAME : EntryType::INLINE_DATA,
+                      static_cast<uint32_t>(wire.size()));
+    m_payload.insert(m_payload.end(), wire.begin(), wire.end());
+    return;
+  }
+
+  uint32_t fields[] = {
+    static_cast<uint32_t>(m_buffers.size()),
+    static_cast<uint32_t>(wire.begin() - buffer->begin()),
+    static_cast<uint32_t>(wire.size())
+  };
+  this->appendEntry(type, fields, sizeof(fields));
+  m_buffers.push_back(buffer);
+}
+
+void
+LogRecord::capture(const Name& name)
+{
+  if (!name.hasWire()) {
+    this->capture<Name>(name);
+    return;
+  }
+
+  this->appendWire(EntryType::NAME, name.wireEncode());
+}
+
+void
+LogRecord::capture(const Interest& interest)
+{
+  if (!interest.hasWire()) {
+    this->capture<Interest>(interest);
+    return;
+  }
+
+  // the wire encoding is copied, because a later setNonce would modify it in place
+  const Block& wire = interest.wireEncode();
+  this->appendValue(EntryType::INTEREST, static_cast<uint32_t>(wire.size()));
+  m_payload.insert(m_payload.end(), wire.begin(), wire.end());
+}
+
+void
+LogRecord::capture(const Data& data)
+{
+  if (!data.hasWire()) {
+    this->capture<Data>(data);
+    return;
+  }
+
+  this->appendWire(EntryType::DATA, data.wireEncode());
+}
+
+template<typename T>
+static T
+readValue(const uint8_t*& pos)
+{
+  T value;
+  std::memcpy(&value, pos, sizeof(value));
+  pos += sizeof(value);
+  return value;
+}
+
+void
+LogRecord::printMessage(std::ostream& os) const
+{
+  // manipulators do not affect text after the message
+  boost::io::ios_all_saver saver(os);
+
+  const uint8_t* pos = m_payload.data();
+  const uint8_t* end = pos + m_payload.size();
+  while (pos < end) {
+    EntryType type = static_cast<EntryType>(*pos++);
+    switch (type) {
+    case EntryType::INT:
+      os << readValue<int64_t>(pos);
+      break;
+    case EntryType::UINT:
+      os << readValue<uint64_t>(pos);
+      break;
+    case EntryType::DOUBLE:
+      os << readValue<double>(pos);
+      break;
+    case EntryType::CHAR:
+      os << readValue<char>(pos);
+      break;
+    case EntryType::BOOL:
+      os << readValue<bool>(pos);
+      break;
+    case EntryType::LITERAL:
+      os << readValue<const char*>(pos);
+      break;
+    case EntryType::STRING: {
+      uint32_t length = readValue<uint32_t>(pos);
+      if (os.width() > 0) {
+        // std::setw applies to the string
+        os << std::string(reinterpret_cast<const char*>(pos), length);
+      }
+      else {
+        os.write(reinterpret_cast<const char*>(pos), length);
+      }
+      pos += length;
+      break;
+    }
+    case EntryType::INTEREST:
+    case EntryType::INLINE_NAME:
+    case EntryType::INLINE_DATA: {
+      uint32_t length = readValue<uint32_t>(pos);
+      Block wire(pos, length);
+      if (type == EntryType::INTEREST) {
+        os << Interest(wire);
+      }
+      else if (type == EntryType::INLINE_NAME) {
+        os << Name(wire);
+      }
+      else {
+        os << Data(wire);
+      }
+      pos += length;
+      break;
+    }
+    case EntryType::NAME:
+    case EntryType::DATA: {
+      uint32_t index = readValue<uint32_t>(pos);
+      uint32_t offset = readValue<uint32_t>(pos);
+      uint32_t length = readValue<uint32_t>(pos);
+      const ConstBufferPtr& buffer = m_buffers[index];
+      Block wire(buffer, buffer->begin() + offset, buffer->begin() + offset + length);
+      if (type == EntryType::NAME) {
+        os << Name(wire);
+      }
+      else {
+        os << Data(wire);
+      }
+      break;
+    }
+    case EntryType::MANIPULATOR:
+      os << readValue<std::ostream& (*)(std::ostream&)>(pos);
+      break;
+    case EntryType::IOS_MANIPULATOR:
+      os << readValue<std::ios_base& (*)(std::ios_base&)>(pos);
+      break;
+    case EntryType::FORMAT: {
+      FormatChange change = readValue<FormatChange>(pos);
+      os.unsetf(change.clearedFlags);
+      os.setf(change.setFlags);
+      if (change.width >= 0) {
+        os.width(change.width);
+      }
+      if (change.precision >= 0) {
+        os.precision(change.precision);
+      }
+      if (change.fill != '\0') {
+        os.fill(change.fill);
+      }
+      break;
+    }
+    }
+  }
+}
+
+std::string
+LogRecord::getMessage() const
+{
+  std::ostringstream os;
+  this->printMessage(os);
+  return os.str();
+}
+
+} // namespace util
+} // namespace ndn
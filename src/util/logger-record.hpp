@@ -0,0 +1,420 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_RECORD_HPP
+#define NDN_UTIL_LOGGER_RECORD_HPP
+
+#include "../common.hpp"
+#include "../encoding/buffer.hpp"
+#include "time.hpp"
+
+#include <boost/log/utility/formatting_ostream.hpp>
+
+#include <iomanip>
+
+namespace ndn {
+
+class Name;
+class Interest;
+class Data;
+class Block;
+
+namespace util {
+
+class Logger;
+class LogCallSite;
+class FlightRecorder;
+class TlvLogSink;
+enum class LogLevel;
+
+/** \brief a string literal that LogRecord references by pointer
+ *  \sa NDN_CXX_LOG_LITERAL
+ */
+class LogLiteral
+{
+public:
+  /** \pre \p str has static storage duration
+   */
+  explicit constexpr
+  LogLiteral(const char* str)
+    : m_str(str)
+  {
+  }
+
+  const char*
+  get() const
+  {
+    return m_str;
+  }
+
+private:
+  const char* m_str;
+};
+
+/** \brief mark a string literal to be referenced by pointer in a LogRecord, instead of copied
+ *
+ *  The argument must be a string literal; anything else fails to compile.
+ *  \code
+ *  NDN_CXX_LOG_DEBUG(NDN_CXX_LOG_LITERAL("onInterest ") << interest);
+ *  \endcode
+ */
+#define NDN_CXX_LOG_LITERAL(str) ::ndn::util::LogLiteral("" str)
+
+/** \brief a log message captured on the thread that executes a log statement
+ *
+ *  A LogRecord refers to the static LogCallSite of its log statement, which supplies the module
+ *  and level, so that the record itself carries only a timestamp and the message payload.
+ *
+ *  Arguments streamed into a LogRecord are not formatted on the logging thread whenever that
+ *  can be avoided.  Instead, their raw values are appended to a compact binary payload:
+ *  \li integers, floating point numbers, characters, and booleans are copied;
+ *  \li string literals marked with NDN_CXX_LOG_LITERAL are referenced by pointer;
+ *  \li other strings, including char arrays, are copied;
+ *  \li a Name or Data that has a wire encoding is referenced by sharing its wire buffer, so
+ *      that no URI escaping happens on the logging thread.  If the wire encoding occupies
+ *      only part of its buffer, as the Name of a Data or a large packet received by
+ *      StreamTransport does, its octets are copied into the payload instead, so that a queued
+ *      record does not pin the larger buffer;
+ *  \li the wire encoding of an Interest is copied, because Interest::setNonce and
+ *      Interest::refreshNonce modify it in place.
+ *
+ *  The message text is rendered by printMessage(), which a LoggerBackend may invoke on another
+ *  thread, or not at all if the record is dropped.  Arguments of any other type, and a packet
+ *  without wire encoding, are formatted immediately with their operator<<.
+ *
+ *  Stream manipulators, such as std::hex, std::setw, and std::setprecision, are recorded and
+ *  applied to the following arguments when the message is rendered.  They do not affect
+ *  arguments that are formatted immediately, nor text after the message.
+ *
+ *  A record keeps the referenced wire buffers alive until it is destroyed.
+ */
+class LogRecord
+{
+public:
+  /** \pre \p site has been registered
+   */
+  explicit
+  LogRecord(const LogCallSite& site);
+
+  const LogCallSite&
+  getCallSite() const
+  {
+    return *m_site;
+  }
+
+  Logger&
+  getLogger() const;
+
+  LogLevel
+  getLevel() const;
+
+  /** \return the time when the record was created, from the clock selected with
+   *          LogTimestamp::setSource
+   */
+  const time::system_clock::TimePoint&
+  getTimestamp() const
+  {
+    return m_timestamp;
+  }
+
+  /** \brief append an argument to the message
+   */
+  template<typename T>
+  LogRecord&
+  operator<<(T&& arg)
+  {
+    this->capture(std::forward<T>(arg));
+    return *this;
+  }
+
+  /** \brief append a copy of a char array, which may be a buffer that does not outlive the record
+   *
+   *  This overload is preferred over capture(const char*), so that the length of the array
+   *  bounds the copy.
+   */
+  template<size_t N>
+  LogRecord&
+  operator<<(const char (&str)[N])
+  {
+    this->appendString(str, std::find(str, str + N, '\0') - str);
+    return *this;
+  }
+
+  LogRecord&
+  operator<<(std::ostream& (*manipulator)(std::ostream&))
+  {
+    this->appendEntry(EntryType::MANIPULATOR, &manipulator, sizeof(manipulator));
+    return *this;
+  }
+
+  LogRecord&
+  operator<<(std::ios_base& (*manipulator)(std::ios_base&))
+  {
+    this->appendEntry(EntryType::IOS_MANIPULATOR, &manipulator, sizeof(manipulator));
+    return *this;
+  }
+
+  /** \brief render the message text, excluding timestamp, level and module name
+   */
+  void
+  printMessage(std::ostream& os) const;
+
+  /** \return the message text, excluding timestamp, level and module name
+   */
+  std::string
+  getMessage() const;
+
+private:
+  enum class EntryType : uint8_t {
+    INT,
+    UINT,
+    DOUBLE,
+    CHAR,
+    BOOL,
+    LITERAL,
+    STRING,
+    NAME,     ///< {buffer index, offset, length}
+    INTEREST, ///< {length, wire encoding}
+    DATA,     ///< {buffer index, offset, length}
+    MANIPULATOR,
+    IOS_MANIPULATOR,
+    FORMAT,     ///< FormatChange
+    INLINE_NAME, ///< {length, wire encoding}
+    INLINE_DATA  ///< {length, wire encoding}
+  };
+
+  /** \brief stream state set by a parametric manipulator such as std::setw
+   */
+  struct FormatChange
+  {
+    std::ios_base::fmtflags setFlags;
+    std::ios_base::fmtflags clearedFlags;
+    std::streamsize width;     ///< -1 if unchanged
+    std::streamsize precision; ///< -1 if unchanged
+    char fill;                 ///< '\0' if unchanged
+  };
+
+  /** \brief whether T is the return type of a manipulator declared in <iomanip>
+   */
+  template<typename T>
+  struct IsParametricManipulator
+    : std::integral_constant<bool,
+        std::is_same<T, decltype(std::setw(0))>::value ||
+        std::is_same<T, decltype(std::setprecision(0))>::value ||
+        std::is_same<T, decltype(std::setfill('\0'))>::value ||
+        std::is_same<T, decltype(std::setbase(0))>::value ||
+        std::is_same<T, decltype(std::setiosflags(std::ios_base::fmtflags()))>::value ||
+        std::is_same<T, decltype(std::resetiosflags(std::ios_base::fmtflags()))>::value>
+  {
+  };
+
+  void
+  appendEntry(EntryType type, const void* value, size_t size)
+  {
+    m_payload.push_back(static_cast<uint8_t>(type));
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(value);
+    m_payload.insert(m_payload.end(), bytes, bytes + size);
+  }
+
+  template<typename T>
+  void
+  appendValue(EntryType type, T value)
+  {
+    this->appendEntry(type, &value, sizeof(value));
+  }
+
+  void
+  appendString(const char* str, size_t length);
+
+  /** \brief append the stream state changes made by \p manipulate
+   */
+  void
+  appendFormat(const function<void(std::ostream&)>& manipulate);
+
+  /** \brief append a reference to a wire-encoded Name or Data, or a copy of it if it does not
+   *         span its buffer
+   */
+  void
+  appendWire(EntryType type, const Block& wire);
+
+private: // capture overloads, selected according to the argument type
+  void
+  capture(const LogLiteral& literal)
+  {
+    this->appendValue(EntryType::LITERAL, literal.get());
+  }
+
+  template<size_t N>
+  void
+  capture(char (&str)[N])
+  {
+    this->appendString(str, std::find(str, str + N, '\0') - str);
+  }
+
+  void
+  capture(const char* str)
+  {
+    this->appendString(str, std::strlen(str));
+  }
+
+  void
+  capture(const std::string& str)
+  {
+    this->appendString(str.data(), str.size());
+  }
+
+  void
+  capture(char value)
+  {
+    this->appendValue(EntryType::CHAR, value);
+  }
+
+  void
+  capture(signed char value)
+  {
+    this->appendValue(EntryType::CHAR, static_cast<char>(value));
+  }
+
+  void
+  capture(unsigned char value)
+  {
+    this->appendValue(EntryType::CHAR, static_cast<char>(value));
+  }
+
+  void
+  capture(bool value)
+  {
+    this->appendValue(EntryType::BOOL, value);
+  }
+
+  void
+  capture(short value)
+  {
+    this->appendValue(EntryType::INT, static_cast<int64_t>(value));
+  }
+
+  void
+  capture(int value)
+  {
+    this->appendValue(EntryType::INT, static_cast<int64_t>(value));
+  }
+
+  void
+  capture(long value)
+  {
+    this->appendValue(EntryType::INT, static_cast<int64_t>(value));
+  }
+
+  void
+  capture(long long value)
+  {
+    this->appendValue(EntryType::INT, static_cast<int64_t>(value));
+  }
+
+  void
+  capture(unsigned short value)
+  {
+    this->appendValue(EntryType::UINT, static_cast<uint64_t>(value));
+  }
+
+  void
+  capture(unsigned int value)
+  {
+    this->appendValue(EntryType::UINT, static_cast<uint64_t>(value));
+  }
+
+  void
+  capture(unsigned long value)
+  {
+    this->appendValue(EntryType::UINT, static_cast<uint64_t>(value));
+  }
+
+  void
+  capture(unsigned long long value)
+  {
+    this->appendValue(EntryType::UINT, static_cast<uint64_t>(value));
+  }
+
+  void
+  capture(float value)
+  {
+    this->appendValue(EntryType::DOUBLE, static_cast<double>(value));
+  }
+
+  void
+  capture(double value)
+  {
+    this->appendValue(EntryType::DOUBLE, value);
+  }
+
+  void
+  capture(const Name& name);
+
+  void
+  capture(const Interest& interest);
+
+  void
+  capture(const Data& data);
+
+  template<typename T>
+  void
+  capture(const T& value)
+  {
+    this->captureOther(value, IsParametricManipulator<T>());
+  }
+
+  template<typename T>
+  void
+  captureOther(const T& manipulator, std::true_type)
+  {
+    this->appendFormat([&manipulator] (std::ostream& os) { os << manipulator; });
+  }
+
+  /** \brief format an argument of any other type immediately
+   */
+  template<typename T>
+  void
+  captureOther(const T& value, std::false_type)
+  {
+    std::string str;
+    {
+      boost::log::formatting_ostream os(str);
+      os << value;
+    }
+    this->appendString(str.data(), str.size());
+  }
+
+private:
+  const LogCallSite* m_site;
+  time::system_clock::TimePoint m_timestamp;
+
+  std::vector<uint8_t> m_payload;
+  std::vector<ConstBufferPtr> m_buffers; ///< wire buffers referenced by NAME and DATA entries
+
+  friend class FlightRecorder;
+  friend class TlvLogSink;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_RECORD_HPP
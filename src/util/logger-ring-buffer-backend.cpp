@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-ring-buffer-backend.hpp"
+#include "detail/spsc-ring-buffer.hpp"
+
+namespace ndn {
+namespace util {
+
+class RingBufferLoggerBackend::Ring : public detail::SpscRingBuffer<LogRecord>
+{
+public:
+  explicit
+  Ring(size_t capacity)
+    : SpscRingBuffer(capacity)
+    , nQueued(0)
+    , nDropped(0)
+  {
+  }
+
+  /** \brief increment a counter that is written only by the producer
+   *
+   *  This avoids a locked read-modify-write on the logging thread.
+   */
+  static void
+  increment(std::atomic<uint64_t>& counter)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+public:
+  std::atomic<uint64_t> nQueued;
+  std::atomic<uint64_t> nDropped;
+};
+
+RingBufferLoggerBackend::RingBufferLoggerBackend(size_t ringCapacity,
+                                                 const time::milliseconds& drainInterval)
+  : m_ringCapacity(ringCapacity)
+  , m_drainInterval(drainInterval)
+  , m_nQueuedRetired(0)
+  , m_nDroppedRetired(0)
+  , m_nWritten(0)
+  , m_shouldStop(false)
+{
+  m_sink = make_shared<NullLogSink>();
+
+  m_drainer = std::thread(&RingBufferLoggerBackend::runDrainer, this);
+}
+
+RingBufferLoggerBackend::~RingBufferLoggerBackend()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_drainerMutex);
+    m_shouldStop = true;
+  }
+  m_drainerCv.notify_one();
+  m_drainer.join();
+
+  std::lock_guard<std::mutex> lock(m_drainMutex);
+  this->drain();
+}
+
+RingBufferLoggerBackend::Ring&
+RingBufferLoggerBackend::getRing()
+{
+  shared_ptr<Ring>* ring = m_threadRing.get();
+  if (ring == nullptr) {
+    // first record from this thread; the holder is deleted when the thread exits,
+    // after which the drainer removes the ring once it is empty
+    auto newRing = make_shared<Ring>(m_ringCapacity);
+    {
+      std::lock_guard<std::mutex> lock(m_ringsMutex);
+      m_rings.push_back(newRing);
+    }
+    ring = new shared_ptr<Ring>(std::move(newRing));
+    m_threadRing.reset(ring);
+  }
+  return **ring;
+}
+
+void
+RingBufferLoggerBackend::log(LogRecord&& record)
+{
+  Ring& ring = this->getRing();
+  if (ring.tryPush(std::move(record))) {
+    Ring::increment(ring.nQueued);
+  }
+  else {
+    Ring::increment(ring.nDropped);
+  }
+}
+
+void
+RingBufferLoggerBackend::setSink(shared_ptr<LogSink> sink)
+{
+  std::lock_guard<std::mutex> lock(m_drainMutex);
+  this->drain();
+  m_sink = std::move(sink);
+}
+
+void
+RingBufferLoggerBackend::flush()
+{
+  std::lock_guard<std::mutex> lock(m_drainMutex);
+  this->drain();
+}
+
+RingBufferLoggerBackend::Statistics
+RingBufferLoggerBackend::getStatistics() const
+{
+  Statistics st;
+  std::lock_guard<std::mutex> lock(m_ringsMutex);
+  st.nQueued = m_nQueuedRetired;
+  st.nDropped = m_nDroppedRetired;
+  for (const auto& ring : m_rings) {
+    st.nQueued += ring->nQueued.load(std::memory_order_relaxed);
+    st.nDropped += ring->nDropped.load(std::memory_order_relaxed);
+  }
+  st.nWritten = m_nWritten.load(std::memory_order_relaxed);
+  st.nRings = m_rings.size();
+  return st;
+}
+
+void
+RingBufferLoggerBackend::runDrainer()
+{
+  std::unique_lock<std::mutex> lock(m_drainerMutex);
+  while (!m_shouldStop) {
+    m_drainerCv.wait_for(lock, std::chrono::milliseconds(m_drainInterval.count()));
+
+    lock.unlock();
+    {
+      std::lock_guard<std::mutex> drainLock(m_drainMutex);
+      this->drain();
+    }
+    lock.lock();
+  }
+}
+
+size_t
+RingBufferLoggerBackend::drain()
+{
+  std::vector<shared_ptr<Ring>> rings;
+  {
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    rings = m_rings;
+  }
+
+  for (const auto& ring : rings) {
+    ring->consume([this] (LogRecord& record) { m_batch.push_back(std::move(record)); });
+  }
+
+  // each ring is already in order; merge them into a single timeline
+  std::stable_sort(m_batch.begin(), m_batch.end(),
+                   [] (const LogRecord& a, const LogRecord& b) {
+                     return a.getTimestamp() < b.getTimestamp();
+                   });
+
+  size_t nWritten = m_batch.size();
+  if (nWritten > 0) {
+    for (const LogRecord& record : m_batch) {
+      m_sink->write(record);
+    }
+    m_sink->flush();
+    m_batch.clear();
+    m_nWritten.fetch_add(nWritten, std::memory_order_relaxed);
+  }
+
+  // remove rings of exited threads, which are held only by m_rings and the local copy
+  std::lock_guard<std::mutex> lock(m_ringsMutex);
+  for (const auto& ring : rings) {
+    if (ring.use_count() == 2 && ring->empty()) {
+      m_nQueuedRetired += ring->nQueued.load(std::memory_order_relaxed);
+      m_nDroppedRetired += ring->nDropped.load(std::memory_order_relaxed);
+      m_rings.erase(std::find(m_rings.begin(), m_rings.end(), ring));
+    }
+  }
+
+  return nWritten;
+}
+
+} // namespace util
+} // namespace ndn
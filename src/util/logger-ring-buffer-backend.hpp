@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_RING_BUFFER_BACKEND_HPP
+#define NDN_UTIL_LOGGER_RING_BUFFER_BACKEND_HPP
+
+#include "logger-backend.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+
+#include <boost/thread/tss.hpp>
+
+namespace ndn {
+namespace util {
+
+/** \brief a LoggerBackend that gives each logging thread its own lock-free queue
+ *
+ *  Every thread that executes a log statement owns a bounded single-producer single-consumer
+ *  ring of records, so that logging threads never contend with each other.
+ *  A single drainer thread periodically collects records from all rings, merges them in
+ *  timestamp order, formats them, and writes them to the destination.
+ *  When a thread's ring is full, new records from that thread are dropped and counted.
+ */
+class RingBufferLoggerBackend : public LoggerBackend
+{
+public:
+  /** \brief counters of a RingBufferLoggerBackend
+   */
+  struct Statistics
+  {
+    uint64_t nQueued;  ///< records accepted into a ring
+    uint64_t nDropped; ///< records dropped because a ring was full
+    uint64_t nWritten; ///< records written to the destination
+    size_t nRings;     ///< rings of live threads, or with unwritten records
+  };
+
+  /** \param ringCapacity capacity of each per-thread ring, in records
+   *  \param drainInterval how often the drainer collects records from the rings
+   */
+  explicit
+  RingBufferLoggerBackend(size_t ringCapacity = 4096,
+                          const time::milliseconds& drainInterval = time::milliseconds(10));
+
+  ~RingBufferLoggerBackend() NDN_CXX_DECL_OVERRIDE;
+
+  void
+  log(LogRecord&& record) NDN_CXX_DECL_OVERRIDE;
+
+  void
+  setSink(shared_ptr<LogSink> sink) NDN_CXX_DECL_OVERRIDE;
+
+  void
+  flush() NDN_CXX_DECL_OVERRIDE;
+
+  Statistics
+  getStatistics() const;
+
+private:
+  class Ring;
+
+  Ring&
+  getRing();
+
+  void
+  runDrainer();
+
+  /** \brief move records from all rings to the sink
+   *  \pre m_drainMutex is locked
+   *  \return number of records written
+   */
+  size_t
+  drain();
+
+private:
+  const size_t m_ringCapacity;
+  const time::milliseconds m_drainInterval;
+
+  boost::thread_specific_ptr<shared_ptr<Ring>> m_threadRing;
+
+  mutable std::mutex m_ringsMutex;
+  std::vector<shared_ptr<Ring>> m_rings;
+  uint64_t m_nQueuedRetired; ///< nQueued of rings that have been removed
+  uint64_t m_nDroppedRetired; ///< nDropped of rings that have been removed
+
+  std::mutex m_drainMutex; ///< serializes consumers of the rings
+  std::vector<LogRecord> m_batch;
+  shared_ptr<LogSink> m_sink;
+  std::atomic<uint64_t> m_nWritten;
+
+  std::mutex m_drainerMutex;
+  std::condition_variable m_drainerCv;
+  bool m_shouldStop;
+  std::thread m_drainer;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_RING_BUFFER_BACKEND_HPP
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-sink.hpp"
+
+namespace ndn {
+namespace util {
+
+LogSink::~LogSink() = default;
+
+void
+NullLogSink::write(const LogRecord&)
+{
+}
+
+void
+NullLogSink::flush()
+{
+}
+
+const size_t StreamLogSink::MAX_BUFFER_SIZE;
+
+StreamLogSink::StreamLogSink(std::ostream& os)
+  : m_os(os)
+{
+}
+
+void
+StreamLogSink::write(const LogRecord& record)
+{
+  m_buffer << record << '\n';
+  if (static_cast<size_t>(m_buffer.tellp()) >= MAX_BUFFER_SIZE) {
+    this->writeBuffer();
+  }
+}
+
+void
+StreamLogSink::flush()
+{
+  this->writeBuffer();
+  m_os.flush();
+}
+
+void
+StreamLogSink::writeBuffer()
+{
+  if (m_buffer.tellp() <= 0) {
+    return;
+  }
+
+  const std::string& buffer = m_buffer.str();
+  m_os.write(buffer.data(), buffer.size());
+  m_buffer.str("");
+}
+
+} // namespace util
+} // namespace ndn
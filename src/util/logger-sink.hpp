@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_SINK_HPP
+#define NDN_UTIL_LOGGER_SINK_HPP
+
+#include "logger.hpp"
+
+#include <sstream>
+
+namespace ndn {
+namespace util {
+
+/** \brief writes log records to their final destination
+ *
+ *  A sink is selected with LoggerFactory::setSink, and is driven by the active LoggerBackend.
+ *  The backend serializes calls to write() and flush(), which usually happen on a thread
+ *  other than the one that executed the log statement.
+ */
+class LogSink : noncopyable
+{
+public:
+  virtual
+  ~LogSink();
+
+  /** \brief write \p record
+   */
+  virtual void
+  write(const LogRecord& record) = 0;
+
+  /** \brief pass written records to the operating system
+   *
+   *  A backend invokes this after writing one or more records.
+   */
+  virtual void
+  flush() = 0;
+};
+
+/** \brief a LogSink that discards records without rendering them
+ *
+ *  This is the default sink of logger backends, until a real sink is set.
+ */
+class NullLogSink : public LogSink
+{
+public:
+  void
+  write(const LogRecord& record) NDN_CXX_DECL_OVERRIDE;
+
+  void
+  flush() NDN_CXX_DECL_OVERRIDE;
+};
+
+/** \brief a LogSink that writes records as text lines into a std::ostream
+ *
+ *  Records are formatted into an internal buffer, which is passed to the stream in a single
+ *  write upon flush(), or earlier if it exceeds MAX_BUFFER_SIZE.  Therefore, a batch of records
+ *  costs one system call even if the stream is unbuffered, such as std::clog.
+ */
+class StreamLogSink : public LogSink
+{
+public:
+  /** \param os the stream, which must remain valid while the sink is in use
+   */
+  explicit
+  StreamLogSink(std::ostream& os);
+
+  void
+  write(const LogRecord& record) NDN_CXX_DECL_OVERRIDE;
+
+  void
+  flush() NDN_CXX_DECL_OVERRIDE;
+
+  static const size_t MAX_BUFFER_SIZE = 65536;
+
+private:
+  void
+  writeBuffer();
+
+private:
+  std::ostream& m_os;
+  std::ostringstream m_buffer;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_SINK_HPP
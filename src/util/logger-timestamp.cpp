@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-timestamp.hpp"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstring>
+#include <stdio.h>
+#include <time.h>
+
+#include <boost/thread/tss.hpp>
+
+namespace ndn {
+namespace util {
+
+std::ostream&
+operator<<(std::ostream& os, TimestampSource source)
+{
+  switch (source) {
+  case TimestampSource::SYSTEM:
+    return os << "system";
+  case TimestampSource::REALTIME_COARSE:
+    return os << "coarse";
+  case TimestampSource::STEADY:
+    return os << "steady";
+  case TimestampSource::PROCESS_RELATIVE:
+    return os << "relative";
+  }
+  return os << static_cast<int>(source);
+}
+
+static TimestampSource
+getInitialSource()
+{
+  const char* environ = std::getenv("NDN_CXX_LOG_TIMESTAMP");
+  if (environ != nullptr) {
+    for (TimestampSource source : {TimestampSource::SYSTEM, TimestampSource::REALTIME_COARSE,
+                                   TimestampSource::STEADY, TimestampSource::PROCESS_RELATIVE}) {
+      std::ostringstream os;
+      os << source;
+      if (os.str() == environ) {
+        return source;
+      }
+    }
+  }
+  return TimestampSource::SYSTEM;
+}
+
+static std::atomic<TimestampSource> g_source(getInitialSource());
+static const time::steady_clock::TimePoint g_processStart = time::steady_clock::now();
+
+const size_t LogTimestamp::MAX_FORMATTED_LENGTH;
+
+void
+LogTimestamp::setSource(TimestampSource source)
+{
+  g_source.store(source, std::memory_order_relaxed);
+}
+
+TimestampSource
+LogTimestamp::getSource()
+{
+  return g_source.load(std::memory_order_relaxed);
+}
+
+LogTimestamp::TimePoint
+LogTimestamp::now()
+{
+  switch (g_source.load(std::memory_order_relaxed)) {
+  case TimestampSource::SYSTEM:
+    break;
+  case TimestampSource::REALTIME_COARSE: {
+#ifdef CLOCK_REALTIME_COARSE
+    struct timespec ts;
+    if (::clock_gettime(CLOCK_REALTIME_COARSE, &ts) == 0) {
+      return TimePoint(time::duration_cast<time::system_clock::Duration>(
+                         time::seconds(ts.tv_sec) + time::nanoseconds(ts.tv_nsec)));
+    }
+#endif // CLOCK_REALTIME_COARSE
+    break;
+  }
+  case TimestampSource::STEADY:
+    return TimePoint(time::duration_cast<time::system_clock::Duration>(
+                       time::steady_clock::now().time_since_epoch()));
+  case TimestampSource::PROCESS_RELATIVE:
+    return TimePoint(time::duration_cast<time::system_clock::Duration>(
+                       time::steady_clock::now() - g_processStart));
+  }
+  return time::system_clock::now();
+}
+
+/** \brief formatted whole seconds of the most recent timestamp on a thread
+ */
+struct FormattedSeconds
+{
+  int64_t seconds = -1;
+  char text[LogTimestamp::MAX_FORMATTED_LENGTH + 1]; ///< whole seconds followed by '.'
+  size_t length = 0;
+};
+
+static boost::thread_specific_ptr<FormattedSeconds> g_formattedSeconds;
+
+size_t
+LogTimestamp::format(const TimePoint& timestamp, char* buffer)
+{
+  static const int64_t ONE_SECOND = 1000000;
+  int64_t microsecondsSinceEpoch = time::duration_cast<time::microseconds>(
+                                     timestamp.time_since_epoch()).count();
+  int64_t seconds = microsecondsSinceEpoch / ONE_SECOND;
+  int64_t fraction = microsecondsSinceEpoch % ONE_SECOND;
+  if (fraction < 0) {
+    --seconds;
+    fraction += ONE_SECOND;
+  }
+
+  FormattedSeconds* cache = g_formattedSeconds.get();
+  if (cache == nullptr) {
+    cache = new FormattedSeconds;
+    g_formattedSeconds.reset(cache);
+  }
+  if (cache->seconds != seconds) {
+    // - std::snprintf not found in some environments
+    //   http://redmine.named-data.net/issues/2299 for more information
+    int length = snprintf(cache->text, sizeof(cache->text), "%" PRId64 ".", seconds);
+    cache->length = static_cast<size_t>(std::max(length, 0));
+    cache->seconds = seconds;
+  }
+
+  std::memcpy(buffer, cache->text, cache->length);
+  char* fractionEnd = buffer + cache->length + 6;
+  for (char* pos = fractionEnd; pos != buffer + cache->length;) {
+    *--pos = static_cast<char>('0' + fraction % 10);
+    fraction /= 10;
+  }
+  *fractionEnd = '\0';
+  return cache->length + 6;
+}
+
+std::ostream&
+LogTimestamp::print(std::ostream& os, const TimePoint& timestamp)
+{
+  char buffer[MAX_FORMATTED_LENGTH + 1];
+  size_t length = format(timestamp, buffer);
+  return os.write(buffer, length);
+}
+
+} // namespace util
+} // namespace ndn
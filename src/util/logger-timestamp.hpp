@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_TIMESTAMP_HPP
+#define NDN_UTIL_LOGGER_TIMESTAMP_HPP
+
+#include "../common.hpp"
+#include "time.hpp"
+
+namespace ndn {
+namespace util {
+
+/** \brief indicates the clock that timestamps log records
+ */
+enum class TimestampSource {
+  /** \brief time::system_clock, in seconds since UNIX epoch
+   */
+  SYSTEM,
+  /** \brief CLOCK_REALTIME_COARSE, in seconds since UNIX epoch
+   *
+   *  This clock is cheaper to read than SYSTEM, at the resolution of the kernel tick.
+   *  It is the same as SYSTEM where CLOCK_REALTIME_COARSE is unavailable, and it is not affected
+   *  by a mock system clock in unit tests.
+   */
+  REALTIME_COARSE,
+  /** \brief time::steady_clock, in seconds since an unspecified epoch such as system boot
+   */
+  STEADY,
+  /** \brief time::steady_clock, in seconds since the process started
+   */
+  PROCESS_RELATIVE
+};
+
+std::ostream&
+operator<<(std::ostream& os, TimestampSource source);
+
+/** \brief obtains and formats timestamps of log records
+ *
+ *  A timestamp is represented as a time::system_clock::TimePoint, whose epoch depends on the
+ *  TimestampSource that produced it.
+ */
+class LogTimestamp
+{
+public:
+  typedef time::system_clock::TimePoint TimePoint;
+
+  /** \brief select the clock for subsequent timestamps
+   *
+   *  Setting environ NDN_CXX_LOG_TIMESTAMP to "system", "coarse", "steady", or "relative"
+   *  selects the clock at program start.  The default is SYSTEM.
+   */
+  static void
+  setSource(TimestampSource source);
+
+  static TimestampSource
+  getSource();
+
+  /** \return the current time of the selected clock
+   *  \note This function is thread-safe.
+   */
+  static TimePoint
+  now();
+
+  /** \return \p timestamp as integer nanoseconds since the epoch of its clock
+   *
+   *  Binary sinks should store this value instead of formatting the timestamp.
+   */
+  static int64_t
+  toNanoseconds(const TimePoint& timestamp)
+  {
+    return time::duration_cast<time::nanoseconds>(timestamp.time_since_epoch()).count();
+  }
+
+  /** \brief write \p timestamp as seconds with six fractional digits, such as "1466000000.123456"
+   *  \return number of characters written, excluding the terminating null character
+   *  \param buffer a buffer of at least MAX_FORMATTED_LENGTH + 1 characters
+   *
+   *  The formatted whole seconds are cached per thread, so that usually only the fractional
+   *  digits are rendered.
+   *  \note This function is thread-safe.
+   */
+  static size_t
+  format(const TimePoint& timestamp, char* buffer);
+
+  /** \brief write \p timestamp to \p os in the same format as format()
+   */
+  static std::ostream&
+  print(std::ostream& os, const TimePoint& timestamp);
+
+  /** \brief maximum length of a formatted timestamp: 20 (whole seconds) + '.' + 6 (fraction)
+   */
+  static const size_t MAX_FORMATTED_LENGTH = 27;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_TIMESTAMP_HPP
@@ -0,0 +1,295 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "logger-tlv-sink.hpp"
+#include "logger-timestamp.hpp"
+#include "../encoding/block-helpers.hpp"
+#include "../encoding/encoding-buffer.hpp"
+
+#include <cstring>
+
+namespace ndn {
+namespace util {
+
+TlvLogSink::TlvLogSink(std::ostream& os)
+  : m_os(os)
+{
+}
+
+TlvLogSink::TlvLogSink(const std::string& path)
+  : m_file(path, std::ios::binary | std::ios::trunc)
+  , m_os(m_file)
+{
+  if (!m_file) {
+    BOOST_THROW_EXCEPTION(Error("Cannot create log file " + path));
+  }
+}
+
+void
+TlvLogSink::write(const LogRecord& record)
+{
+  const Logger* logger = &record.getLogger();
+  auto it = m_moduleIds.find(logger);
+  if (it == m_moduleIds.end()) {
+    it = m_moduleIds.insert({logger, m_moduleIds.size()}).first;
+
+    EncodingBuffer declaration;
+    size_t length = prependStringBlock(declaration, tlv::logging::ModuleName,
+                                       logger->getModuleName());
+    length += prependNonNegativeIntegerBlock(declaration, tlv::logging::ModuleId, it->second);
+    declaration.prependVarNumber(length);
+    declaration.prependVarNumber(tlv::logging::ModuleDeclaration);
+    m_os.write(reinterpret_cast<const char*>(declaration.buf()), declaration.size());
+  }
+
+  EncodingEstimator estimator;
+  size_t estimatedSize = encodeRecord(estimator, record, it->second);
+
+  EncodingBuffer buffer(estimatedSize, 0);
+  encodeRecord(buffer, record, it->second);
+  m_os.write(reinterpret_cast<const char*>(buffer.buf()), buffer.size());
+}
+
+void
+TlvLogSink::flush()
+{
+  m_os.flush();
+}
+
+Block
+TlvLogSink::encode(const LogRecord& record, uint64_t moduleId)
+{
+  EncodingEstimator estimator;
+  size_t estimatedSize = encodeRecord(estimator, record, moduleId);
+
+  EncodingBuffer buffer(estimatedSize, 0);
+  encodeRecord(buffer, record, moduleId);
+  return buffer.block();
+}
+
+template<encoding::Tag TAG>
+size_t
+TlvLogSink::encodeRecord(EncodingImpl<TAG>& encoder, const LogRecord& record, uint64_t moduleId)
+{
+  // LogRecord ::= LOG-RECORD-TYPE TLV-LENGTH
+  //                 Timestamp
+  //                 ModuleId
+  //                 Level
+  //                 field*
+
+  // payload entries can only be walked forward, but fields are prepended in reverse order
+  std::vector<const uint8_t*> entries;
+  const uint8_t* end = record.m_payload.data() + record.m_payload.size();
+  for (const uint8_t* pos = record.m_payload.data(); pos < end; pos = skipEntry(pos)) {
+    entries.push_back(pos);
+  }
+
+  size_t totalLength = 0;
+  for (auto i = entries.rbegin(); i != entries.rend(); ++i) {
+    totalLength += encodeField(encoder, record, *i);
+  }
+
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::logging::Level,
+                                                static_cast<int>(record.getLevel()) + 1);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::logging::ModuleId, moduleId);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::logging::Timestamp,
+                   LogTimestamp::toNanoseconds(record.getTimestamp()));
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::logging::LogRecord);
+  return totalLength;
+}
+
+/** \return the first element in the value of \p wire, as {begin, length}
+ */
+static std::pair<const uint8_t*, size_t>
+getFirstElement(const uint8_t* wire, const uint8_t* end)
+{
+  tlv::readType(wire, end);
+  tlv::readVarNumber(wire, end);
+
+  const uint8_t* element = wire;
+  tlv::readType(wire, end);
+  uint64_t length = tlv::readVarNumber(wire, end);
+  return {element, wire - element + length};
+}
+
+/** \return the first element of \p type in the value of \p wire, as {begin, length};
+ *          {nullptr, 0} if there is none
+ */
+static std::pair<const uint8_t*, size_t>
+findElement(const uint8_t* wire, const uint8_t* end, uint32_t type)
+{
+  tlv::readType(wire, end);
+  tlv::readVarNumber(wire, end);
+
+  while (wire < end) {
+    const uint8_t* element = wire;
+    uint32_t elementType = tlv::readType(wire, end);
+    uint64_t length = tlv::readVarNumber(wire, end);
+    if (elementType == type) {
+      return {element, wire - element + length};
+    }
+    wire += length;
+  }
+  return {nullptr, 0};
+}
+
+template<encoding::Tag TAG>
+size_t
+TlvLogSink::encodeField(EncodingImpl<TAG>& encoder, const LogRecord& record, const uint8_t* entry)
+{
+  typedef LogRecord::EntryType EntryType;
+
+  EntryType type = static_cast<EntryType>(*entry++);
+  switch (type) {
+  case EntryType::INT: {
+    int64_t value;
+    std::memcpy(&value, entry, sizeof(value));
+    uint64_t networkValue = htobe64(static_cast<uint64_t>(value));
+    return encoder.prependByteArrayBlock(tlv::logging::SignedIntegerField,
+                                         reinterpret_cast<const uint8_t*>(&networkValue),
+                                         sizeof(networkValue));
+  }
+  case EntryType::UINT: {
+    uint64_t value;
+    std::memcpy(&value, entry, sizeof(value));
+    return prependNonNegativeIntegerBlock(encoder, tlv::logging::UnsignedIntegerField, value);
+  }
+  case EntryType::DOUBLE: {
+    static_assert(sizeof(double) == sizeof(uint64_t), "double must be IEEE 754 binary64");
+    uint64_t value;
+    std::memcpy(&value, entry, sizeof(value));
+    uint64_t networkValue = htobe64(value);
+    return encoder.prependByteArrayBlock(tlv::logging::DoubleField,
+                                         reinterpret_cast<const uint8_t*>(&networkValue),
+                                         sizeof(networkValue));
+  }
+  case EntryType::CHAR:
+    return encoder.prependByteArrayBlock(tlv::logging::TextField, entry, 1);
+  case EntryType::BOOL: {
+    bool value;
+    std::memcpy(&value, entry, sizeof(value));
+    return prependNonNegativeIntegerBlock(encoder, tlv::logging::BooleanField, value ? 1 : 0);
+  }
+  case EntryType::LITERAL: {
+    const char* literal;
+    std::memcpy(&literal, entry, sizeof(literal));
+    return encoder.prependByteArrayBlock(tlv::logging::TextField,
+                                         reinterpret_cast<const uint8_t*>(literal),
+                                         std::strlen(literal));
+  }
+  case EntryType::STRING: {
+    uint32_t length;
+    std::memcpy(&length, entry, sizeof(length));
+    return encoder.prependByteArrayBlock(tlv::logging::TextField, entry + sizeof(length), length);
+  }
+  case EntryType::NAME:
+  case EntryType::INTEREST:
+  case EntryType::DATA:
+  case EntryType::INLINE_NAME:
+  case EntryType::INLINE_DATA: {
+    const uint8_t* wire = nullptr;
+    uint32_t wireLength = 0;
+    if (type != EntryType::NAME && type != EntryType::DATA) {
+      // {length, wire encoding}
+      std::memcpy(&wireLength, entry, sizeof(wireLength));
+      wire = entry + sizeof(wireLength);
+    }
+    else {
+      uint32_t fields[3]; // index, offset, length
+      std::memcpy(fields, entry, sizeof(fields));
+      wire = record.m_buffers[fields[0]]->data() + fields[1];
+      wireLength = fields[2];
+    }
+    if (type == EntryType::NAME || type == EntryType::INLINE_NAME) {
+      return encoder.prependByteArray(wire, wireLength);
+    }
+
+    size_t length = 0;
+    if (type == EntryType::INTEREST) {
+      std::pair<const uint8_t*, size_t> nonce = findElement(wire, wire + wireLength, tlv::Nonce);
+      length += encoder.prependByteArray(nonce.first, nonce.second);
+    }
+    std::pair<const uint8_t*, size_t> name = getFirstElement(wire, wire + wireLength);
+    length += encoder.prependByteArray(name.first, name.second);
+    length += encoder.prependVarNumber(length);
+    length += encoder.prependVarNumber(type == EntryType::INTEREST ?
+                                       tlv::logging::InterestField : tlv::logging::DataField);
+    return length;
+  }
+  case EntryType::MANIPULATOR:
+  case EntryType::IOS_MANIPULATOR:
+  case EntryType::FORMAT:
+    // manipulators do not produce text, and fields are not formatted text
+    return 0;
+  }
+  return 0;
+}
+
+const uint8_t*
+TlvLogSink::skipEntry(const uint8_t* entry)
+{
+  typedef LogRecord::EntryType EntryType;
+
+  EntryType type = static_cast<EntryType>(*entry++);
+  switch (type) {
+  case EntryType::INT:
+    return entry + sizeof(int64_t);
+  case EntryType::UINT:
+    return entry + sizeof(uint64_t);
+  case EntryType::DOUBLE:
+    return entry + sizeof(double);
+  case EntryType::CHAR:
+    return entry + sizeof(char);
+  case EntryType::BOOL:
+    return entry + sizeof(bool);
+  case EntryType::LITERAL:
+    return entry + sizeof(const char*);
+  case EntryType::STRING: {
+    uint32_t length;
+    std::memcpy(&length, entry, sizeof(length));
+    return entry + sizeof(length) + length;
+  }
+  case EntryType::NAME:
+  case EntryType::DATA:
+    return entry + 3 * sizeof(uint32_t);
+  case EntryType::INTEREST:
+  case EntryType::INLINE_NAME:
+  case EntryType::INLINE_DATA: {
+    uint32_t length;
+    std::memcpy(&length, entry, sizeof(length));
+    return entry + sizeof(length) + length;
+  }
+  case EntryType::MANIPULATOR:
+    return entry + sizeof(std::ostream& (*)(std::ostream&));
+  case EntryType::IOS_MANIPULATOR:
+    return entry + sizeof(std::ios_base& (*)(std::ios_base&));
+  case EntryType::FORMAT:
+    return entry + sizeof(LogRecord::FormatChange);
+  }
+  BOOST_ASSERT(false);
+  return entry;
+}
+
+} // namespace util
+} // namespace ndn
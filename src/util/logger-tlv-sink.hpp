@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_TLV_SINK_HPP
+#define NDN_UTIL_LOGGER_TLV_SINK_HPP
+
+#include "logger-sink.hpp"
+#include "logger-tlv.hpp"
+#include "../encoding/block.hpp"
+#include "../encoding/encoding-buffer-fwd.hpp"
+
+#include <fstream>
+#include <unordered_map>
+
+namespace ndn {
+namespace util {
+
+/** \brief a LogSink that writes records as TLV elements into a structured log file
+ *
+ *  Each record is encoded as a LogRecord element, whose fields carry the arguments of the log
+ *  statement with their types, as defined in logger-tlv.hpp.  A Name is written as its wire
+ *  encoding, an Interest as its Name and Nonce, and a Data as its Name, so that neither URI
+ *  escaping nor number formatting happens when writing.  A ModuleDeclaration is written before
+ *  the first record of each module.
+ *
+ *  The ndnlogcat tool decodes, filters, and prints structured log files.
+ */
+class TlvLogSink : public LogSink
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /** \param os the stream, which should be opened in binary mode, and must remain valid while
+   *            the sink is in use
+   */
+  explicit
+  TlvLogSink(std::ostream& os);
+
+  /** \brief create or replace the structured log file at \p path
+   *  \throw Error the file cannot be created
+   */
+  explicit
+  TlvLogSink(const std::string& path);
+
+  void
+  write(const LogRecord& record) NDN_CXX_DECL_OVERRIDE;
+
+  void
+  flush() NDN_CXX_DECL_OVERRIDE;
+
+  /** \brief encode \p record as a LogRecord element
+   */
+  static Block
+  encode(const LogRecord& record, uint64_t moduleId);
+
+private:
+  template<encoding::Tag TAG>
+  static size_t
+  encodeRecord(EncodingImpl<TAG>& encoder, const LogRecord& record, uint64_t moduleId);
+
+  template<encoding::Tag TAG>
+  static size_t
+  encodeField(EncodingImpl<TAG>& encoder, const LogRecord& record, const uint8_t* entry);
+
+  /** \return the entry that follows \p entry in the payload of a LogRecord
+   */
+  static const uint8_t*
+  skipEntry(const uint8_t* entry);
+
+private:
+  std::ofstream m_file;
+  std::ostream& m_os;
+  std::unordered_map<const Logger*, uint64_t> m_moduleIds;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_TLV_SINK_HPP
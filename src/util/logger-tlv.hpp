@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_LOGGER_TLV_HPP
+#define NDN_UTIL_LOGGER_TLV_HPP
+
+#include "../encoding/tlv.hpp"
+
+namespace ndn {
+namespace tlv {
+namespace logging {
+
+/** \brief TLV-TYPE numbers of structured log files written by TlvLogSink
+ *
+ *  A structured log file is a sequence of LogRecord and ModuleDeclaration elements:
+ *
+ *      LogRecord ::= LOG-RECORD-TYPE TLV-LENGTH
+ *                      Timestamp
+ *                      ModuleId
+ *                      Level
+ *                      (TextField | SignedIntegerField | UnsignedIntegerField | DoubleField |
+ *                       BooleanField | Name | InterestField | DataField)*
+ *
+ *      ModuleDeclaration ::= MODULE-DECLARATION-TYPE TLV-LENGTH
+ *                              ModuleId
+ *                              ModuleName
+ *
+ *  A ModuleDeclaration precedes the first LogRecord that refers to its ModuleId.
+ *  The fields of a LogRecord are the arguments of the log statement in order, so that the
+ *  message text is the concatenation of the fields rendered as text.
+ *
+ *  The same numbers are used by the management protocol of LoggerManagement:
+ *
+ *      ControlParameters ::= CONTROL-PARAMETERS-TYPE TLV-LENGTH
+ *                              ModuleName?
+ *                              Level?
+ *                              Duration?
+ *
+ *      ModuleStatus ::= MODULE-STATUS-TYPE TLV-LENGTH
+ *                         ModuleName
+ *                         Level
+ *                         RecordCount
+ *                         DropCount
+ *
+ *  CONTROL-PARAMETERS-TYPE is tlv::nfd::ControlParameters, as in NFD management commands.
+ *  This header does not depend on the logging facility, so that log files can be processed by
+ *  programs built without it.
+ */
+enum {
+  LogRecord            = 128,
+  Timestamp            = 129, ///< NonNegativeInteger, nanoseconds since the epoch of TimestampSource
+  ModuleId             = 130, ///< NonNegativeInteger, unique within the file
+  Level                = 131, ///< NonNegativeInteger, LogLevel value plus one, so that FATAL is 0
+
+  ModuleDeclaration    = 132,
+  ModuleName           = 133, ///< UTF-8 text
+
+  ModuleStatus         = 134,
+  RecordCount          = 135, ///< NonNegativeInteger
+  DropCount            = 136, ///< NonNegativeInteger
+  Duration             = 137, ///< NonNegativeInteger, milliseconds
+
+  TextField            = 140, ///< UTF-8 text
+  SignedIntegerField   = 141, ///< 8-octet two's complement, big endian
+  UnsignedIntegerField = 142, ///< NonNegativeInteger
+  DoubleField          = 143, ///< 8-octet IEEE 754 binary64, big endian
+  BooleanField         = 144, ///< NonNegativeInteger, 0 or 1
+  InterestField        = 145, ///< Name, Nonce
+  DataField            = 146  ///< Name
+};
+
+} // namespace logging
+} // namespace tlv
+} // namespace ndn
+
+#endif // NDN_UTIL_LOGGER_TLV_HPP
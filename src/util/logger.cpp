@@ -21,45 +21,128 @@
 
 #include "logger.hpp"
 #include "logger-factory.hpp"
+#include "logger-flight-recorder.hpp"
+#include "logger-timestamp.hpp"
 #include "time.hpp"
 
-#include <cinttypes>
-#include <stdio.h>
-#include <type_traits>
+#include <cstring>
 
 namespace ndn {
 namespace util {
 
 Logger::Logger(const std::string& name)
   : m_moduleName(name)
+  , m_flightRecorderLevel(LogLevel::NONE)
+  , m_sink(nullptr)
+  , m_nRecords(0)
+  , m_nextLogger(nullptr)
 {
   this->setLevel(LogLevel::NONE);
   LoggerFactory::addLogger(name, this);
 }
 
-std::ostream&
-operator<<(std::ostream& os, const LoggerTimestamp&)
+void
+Logger::log(LogRecord&& record)
 {
-  using namespace ndn::time;
+  LoggerFactory& lf = LoggerFactory::get();
+  LogLevel level = record.getLevel();
+
+  if (level <= m_flightRecorderLevel.load(std::memory_order_relaxed) &&
+      lf.m_currentFlightRecorder.load(std::memory_order_relaxed) != nullptr) {
+    // the seq_cst operations pair with LoggerFactory::retireFlightRecorders, so that the
+    // recorder is not deleted until this thread leaves it
+    std::atomic<int>& nWriters = lf.m_flightRecorderWriters.getShard();
+    nWriters.fetch_add(1);
+    FlightRecorder* flightRecorder = lf.m_currentFlightRecorder.load();
+    if (flightRecorder != nullptr) {
+      flightRecorder->record(record);
+      if (level == LogLevel::FATAL) {
+        flightRecorder->dumpToCrashFile();
+      }
+    }
+    nWriters.fetch_sub(1, std::memory_order_release);
+  }
+
+  if (level <= m_backendLevel.load(std::memory_order_relaxed) ||
+      record.getCallSite().m_state.load(std::memory_order_relaxed) == LogCallSite::STATE_ENABLED) {
+    m_nRecords.fetch_add(1, std::memory_order_relaxed);
+    // the seq_cst operations pair with LoggerFactory::retireBackends, so that the backend is
+    // not released until this thread leaves it
+    std::atomic<int>& nUsers = lf.m_backendUsers.getShard();
+    nUsers.fetch_add(1);
+    lf.m_currentBackend.load()->log(std::move(record));
+    nUsers.fetch_sub(1, std::memory_order_release);
+  }
+}
 
-  static const microseconds::rep ONE_SECOND = 1000000;
-  microseconds::rep microsecondsSinceEpoch = duration_cast<microseconds>(
-                                             system_clock::now().time_since_epoch()).count();
+bool
+LogCallSite::isEnabledSlow(int8_t state)
+{
+  if (state == STATE_UNREGISTERED) {
+    LoggerFactory::addCallSite(*this);
+    state = m_state.load(std::memory_order_acquire);
+    if (state == STATE_DEFAULT) {
+      return m_logger->isLevelEnabled(m_level);
+    }
+  }
+  return state == STATE_ENABLED;
+}
 
-  // 10 (whole seconds) + '.' + 6 (fraction) + '\0'
-  char buffer[10 + 1 + 6 + 1];
-  BOOST_ASSERT_MSG(microsecondsSinceEpoch / ONE_SECOND <= 9999999999L,
-                   "whole seconds cannot fit in 10 characters");
+bool
+LogCallSite::matches(const std::string& location) const
+{
+  size_t colon = location.rfind(':');
+  if (colon == std::string::npos || location.compare(colon + 1, std::string::npos,
+                                                     to_string(m_line)) != 0) {
+    return false;
+  }
 
-  static_assert(std::is_same<microseconds::rep, int_least64_t>::value,
-                "PRIdLEAST64 is incompatible with microseconds::rep");
-  // - std::snprintf not found in some environments
-  //   http://redmine.named-data.net/issues/2299 for more information
-  snprintf(buffer, sizeof(buffer), "%" PRIdLEAST64 ".%06" PRIdLEAST64,
-           microsecondsSinceEpoch / ONE_SECOND,
-           microsecondsSinceEpoch % ONE_SECOND);
+  size_t fileLength = std::strlen(m_file);
+  if (colon > fileLength || location.compare(0, colon, m_file + fileLength - colon) != 0) {
+    return false;
+  }
+  // the location must cover whole path components
+  return colon == fileLength || m_file[fileLength - colon - 1] == '/';
+}
 
-  return os << buffer;
+const char*
+getLevelLabel(LogLevel level)
+{
+  switch (level) {
+  case LogLevel::FATAL:
+    return "FATAL";
+  case LogLevel::NONE:
+    return "NONE";
+  case LogLevel::ERROR:
+    return "ERROR";
+  case LogLevel::WARN:
+    return "WARNING";
+  case LogLevel::INFO:
+    return "INFO";
+  case LogLevel::DEBUG:
+    return "DEBUG";
+  case LogLevel::TRACE:
+    return "TRACE";
+  case LogLevel::ALL:
+    return "ALL";
+  }
+  return "";
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LogRecord& record)
+{
+  LogTimestamp::print(os, record.getTimestamp());
+  os << ' ' << getLevelLabel(record.getLevel()) << ": "
+     << '[' << record.getLogger().getModuleName() << "] ";
+  record.printMessage(os);
+  return os;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LoggerTimestamp&)
+{
+  return LogTimestamp::print(os, LogTimestamp::now());
 }
 
 } // namespace util
@@ -26,14 +26,19 @@
 
 #ifdef NDN_CXX_ENABLE_LOGGING
 
+#include "logger-record.hpp"
+
 #include <boost/log/common.hpp>
 #include <boost/log/sources/logger.hpp>
 
 #include <atomic>
+#include <mutex>
 
 namespace ndn {
 namespace util {
 
+class LogSink;
+
 /** \brief indicates the severity level of a log message
  */
 enum class LogLevel {
@@ -59,23 +64,353 @@ public:
     return m_moduleName;
   }
 
+  /** \return whether a record at \p level would be accepted by either the active
+   *          LoggerBackend or the flight recorder
+   */
   bool
   isLevelEnabled(LogLevel level) const
   {
     return m_currentLevel.load(std::memory_order_relaxed) >= level;
   }
 
+  /** \return the level of the module, excluding the level of the flight recorder
+   */
+  LogLevel
+  getLevel() const
+  {
+    return m_backendLevel.load(std::memory_order_relaxed);
+  }
+
+  /** \brief set the level of records delivered to the active LoggerBackend
+   */
   void
   setLevel(LogLevel level)
   {
-    m_currentLevel.store(level, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(m_levelMutex);
+    m_backendLevel.store(level, std::memory_order_relaxed);
+    this->updateCurrentLevel();
+  }
+
+  /** \brief set the level of records captured by the flight recorder
+   */
+  void
+  setFlightRecorderLevel(LogLevel level)
+  {
+    std::lock_guard<std::mutex> lock(m_levelMutex);
+    m_flightRecorderLevel.store(level, std::memory_order_relaxed);
+    this->updateCurrentLevel();
+  }
+
+  /** \brief deliver \p record to the flight recorder and the active LoggerBackend,
+   *         according to their levels
+   */
+  void
+  log(LogRecord&& record);
+
+  /** \return number of records passed to the LoggerBackend
+   */
+  uint64_t
+  getNRecords() const
+  {
+    return m_nRecords.load(std::memory_order_relaxed);
+  }
+
+private:
+  /** \brief set both levels at once, as LoggerFactory does when it applies a configuration
+   */
+  void
+  setLevels(LogLevel backendLevel, LogLevel flightRecorderLevel)
+  {
+    std::lock_guard<std::mutex> lock(m_levelMutex);
+    m_backendLevel.store(backendLevel, std::memory_order_relaxed);
+    m_flightRecorderLevel.store(flightRecorderLevel, std::memory_order_relaxed);
+    this->updateCurrentLevel();
+  }
+
+  /** \pre m_levelMutex is locked
+   */
+  void
+  updateCurrentLevel()
+  {
+    m_currentLevel.store(std::max(m_backendLevel.load(std::memory_order_relaxed),
+                                  m_flightRecorderLevel.load(std::memory_order_relaxed)),
+                         std::memory_order_relaxed);
   }
 
 private:
   const std::string m_moduleName;
-  std::atomic<LogLevel> m_currentLevel;
+  std::atomic<LogLevel> m_currentLevel; ///< the more verbose of the two levels below
+  std::atomic<LogLevel> m_backendLevel;
+  std::atomic<LogLevel> m_flightRecorderLevel;
+
+  /** \brief serializes changes of the levels, so that m_currentLevel is derived from the
+   *         levels stored last, even if a configuration is applied by several threads at once
+   */
+  std::mutex m_levelMutex;
+
+  /** \brief sink routed to this module, or nullptr to use the default sink
+   *
+   *  This is resolved by LoggerFactory when a route changes, not per record.
+   */
+  std::atomic<LogSink*> m_sink;
+  std::atomic<uint64_t> m_nRecords;
+
+  /** \brief next Logger in the registry of LoggerFactory, set before this Logger is registered
+   */
+  Logger* m_nextLogger;
+
+  friend class LoggerFactory;
+};
+
+/** \return the label of \p level as it appears in log output
+ */
+const char*
+getLevelLabel(LogLevel level);
+
+/** \brief static descriptor of a log statement
+ *
+ *  Each NDN_CXX_LOG_* statement owns a LogCallSite with static storage duration.
+ *  The constructor is constexpr, so that the descriptor is constant-initialized and checking
+ *  whether the statement is enabled does not involve a function-static guard.
+ *  The descriptor registers itself with LoggerFactory when the statement is first executed,
+ *  and is assigned an id that is unique within the process.
+ *
+ *  A call site follows the level of its module, unless it has been individually enabled or
+ *  disabled with LoggerFactory::setCallSiteEnabled.
+ */
+class LogCallSite
+{
+public:
+  constexpr
+  LogCallSite(Logger& (*getLogger)(), LogLevel level,
+              const char* file, int line, const char* format)
+    : m_getLogger(getLogger)
+    , m_logger(nullptr)
+    , m_level(level)
+    , m_file(file)
+    , m_line(line)
+    , m_format(format)
+    , m_id(0)
+    , m_state(STATE_UNREGISTERED)
+  {
+  }
+
+  LogCallSite(const LogCallSite&) = delete;
+
+  LogCallSite&
+  operator=(const LogCallSite&) = delete;
+
+  /** \brief determine whether the log statement should create a record
+   */
+  bool
+  isEnabled()
+  {
+    int8_t state = m_state.load(std::memory_order_acquire);
+    if (state == STATE_DEFAULT) {
+      return m_logger->isLevelEnabled(m_level);
+    }
+    return this->isEnabledSlow(state);
+  }
+
+  /** \pre the call site has been registered
+   */
+  Logger&
+  getLogger() const
+  {
+    return *m_logger;
+  }
+
+  LogLevel
+  getLevel() const
+  {
+    return m_level;
+  }
+
+  const char*
+  getFile() const
+  {
+    return m_file;
+  }
+
+  int
+  getLine() const
+  {
+    return m_line;
+  }
+
+  /** \return the log expression as written in the source code
+   */
+  const char*
+  getFormat() const
+  {
+    return m_format;
+  }
+
+  /** \pre the call site has been registered
+   */
+  uint32_t
+  getId() const
+  {
+    return m_id;
+  }
+
+  /** \return whether the call site matches \p location
+   *  \param location "file:line", where file is either the full path as in __FILE__,
+   *                  or its trailing components such as "face-impl.hpp"
+   */
+  bool
+  matches(const std::string& location) const;
+
+private:
+  bool
+  isEnabledSlow(int8_t state);
+
+private:
+  enum : int8_t {
+    STATE_UNREGISTERED = -1,
+    STATE_DEFAULT = 0,  ///< follow the level of the module
+    STATE_ENABLED = 1,  ///< forced on
+    STATE_DISABLED = 2  ///< forced off
+  };
+
+  Logger& (*m_getLogger)();
+  Logger* m_logger;
+  const LogLevel m_level;
+  const char* const m_file;
+  const int m_line;
+  const char* const m_format;
+  uint32_t m_id;
+  std::atomic<int8_t> m_state;
+
+  friend class Logger;
+  friend class LoggerFactory;
+};
+
+/** \brief per-call-site state of NDN_CXX_LOG_*_EVERY_N statements
+ *
+ *  The first execution and every n-th execution after it are logged.
+ */
+class LogEveryN
+{
+public:
+  constexpr explicit
+  LogEveryN(uint64_t n)
+    : m_n(n > 0 ? n : 1)
+    , m_count(0)
+  {
+  }
+
+  /** \return whether the current execution should be logged
+   *  \param[out] nSuppressed if returning true, the number of executions suppressed since the
+   *                          previous logged one
+   */
+  bool
+  shouldLog(uint64_t& nSuppressed)
+  {
+    uint64_t count = m_count.fetch_add(1, std::memory_order_relaxed);
+    if (count % m_n != 0) {
+      return false;
+    }
+    nSuppressed = count == 0 ? 0 : m_n - 1;
+    return true;
+  }
+
+private:
+  const uint64_t m_n;
+  std::atomic<uint64_t> m_count;
 };
 
+/** \brief per-call-site state of NDN_CXX_LOG_*_EVERY_MS statements
+ *
+ *  An execution is logged if at least the interval has elapsed since the previous logged one.
+ */
+class LogEveryMs
+{
+public:
+  constexpr explicit
+  LogEveryMs(int64_t milliseconds)
+    : m_interval(milliseconds * 1000000)
+    , m_nextTime(0)
+    , m_nSuppressed(0)
+  {
+  }
+
+  /** \return whether the current execution should be logged
+   *  \param[out] nSuppressed if returning true, the number of executions suppressed since the
+   *                          previous logged one
+   */
+  bool
+  shouldLog(uint64_t& nSuppressed)
+  {
+    int64_t now = time::steady_clock::now().time_since_epoch().count();
+    int64_t nextTime = m_nextTime.load(std::memory_order_relaxed);
+    if (now < nextTime ||
+        !m_nextTime.compare_exchange_strong(nextTime, now + m_interval,
+                                            std::memory_order_relaxed)) {
+      m_nSuppressed.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    nSuppressed = m_nSuppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+private:
+  const int64_t m_interval; ///< in nanoseconds
+  std::atomic<int64_t> m_nextTime;
+  std::atomic<uint64_t> m_nSuppressed;
+};
+
+/** \brief per-call-site state of NDN_CXX_LOG_*_RATE statements
+ *
+ *  This is a token bucket that admits \p rate executions per second on average, and bursts of
+ *  up to \p burst executions.  It is implemented as the generic cell rate algorithm, whose
+ *  state is a single timestamp: the theoretical time when the bucket would be full again.
+ */
+class LogTokenBucket
+{
+public:
+  constexpr
+  LogTokenBucket(double rate, uint64_t burst)
+    : m_interval(static_cast<int64_t>(1e9 / rate))
+    , m_tolerance(static_cast<int64_t>(1e9 / rate * (burst > 0 ? burst - 1 : 0)))
+    , m_fullTime(0)
+    , m_nSuppressed(0)
+  {
+  }
+
+  /** \return whether the current execution should be logged
+   *  \param[out] nSuppressed if returning true, the number of executions suppressed since the
+   *                          previous logged one
+   */
+  bool
+  shouldLog(uint64_t& nSuppressed)
+  {
+    int64_t now = time::steady_clock::now().time_since_epoch().count();
+    int64_t fullTime = m_fullTime.load(std::memory_order_relaxed);
+    if (now < fullTime - m_tolerance ||
+        !m_fullTime.compare_exchange_strong(fullTime, std::max(fullTime, now) + m_interval,
+                                            std::memory_order_relaxed)) {
+      m_nSuppressed.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    nSuppressed = m_nSuppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+private:
+  const int64_t m_interval; ///< nanoseconds per token
+  const int64_t m_tolerance; ///< nanoseconds worth of burst tokens beyond the first one
+  std::atomic<int64_t> m_fullTime;
+  std::atomic<uint64_t> m_nSuppressed;
+};
+
+/** \brief write \p record as a single line of text, without line terminator
+ *
+ *  The format is "<timestamp> <LEVEL>: [<module>] <message>".
+ */
+std::ostream&
+operator<<(std::ostream& os, const LogRecord& record);
+
 /** \brief declare a log module
  */
 #define NDN_CXX_LOG_INIT(name) \
@@ -89,6 +424,8 @@ private:
   struct ndn_cxx__allow_trailing_semicolon
 
 /** \brief a tag that writes a timestamp upon stream output
+ *
+ *  The timestamp is obtained and formatted by LogTimestamp.
  *  \example std::clog << LoggerTimestamp()
  */
 struct LoggerTimestamp
@@ -101,45 +438,158 @@ struct LoggerTimestamp
 std::ostream&
 operator<<(std::ostream& os, const LoggerTimestamp&);
 
-#define NDN_CXX_LOG(lvl, lvlstr, expression) \
+#define NDN_CXX_LOG(lvl, expression) \
   do { \
-    if (getNdnCxxLogger().isLevelEnabled(::ndn::util::LogLevel::lvl)) { \
-      BOOST_LOG(getNdnCxxLogger()) << "" << ::ndn::util::LoggerTimestamp{} \
-                                   << " " BOOST_STRINGIZE(lvlstr) ": " \
-                                   << "[" << getNdnCxxLogger().getModuleName() << "] " \
-                                   << expression; \
+    static ::ndn::util::LogCallSite ndn_cxx__site(&getNdnCxxLogger, ::ndn::util::LogLevel::lvl, \
+                                                  __FILE__, __LINE__, BOOST_STRINGIZE(expression)); \
+    if (ndn_cxx__site.isEnabled()) { \
+      ::ndn::util::LogRecord ndn_cxx__record(ndn_cxx__site); \
+      ndn_cxx__record << expression; \
+      ndn_cxx__site.getLogger().log(std::move(ndn_cxx__record)); \
     } \
   } while (false)
 
+/** \brief log a statement that is executed only if \p limiter admits it
+ *  \param limiterType LogEveryN, LogEveryMs, or LogTokenBucket
+ *  \param limiterArgs parenthesized constructor arguments of the limiter
+ *
+ *  The limiter is a static object next to the LogCallSite, and is consulted only if the call
+ *  site is enabled.  A logged message is followed by "[suppressed N messages]" if the limiter
+ *  rejected N executions since the previous logged one.
+ *
+ *  \note The count is reported only by the next execution that the limiter admits.  No summary
+ *        is emitted when the interval elapses on its own, so the count of the last suppressed
+ *        executions of a flood is not logged until the statement is executed again.
+ */
+#define NDN_CXX_LOG_LIMITED(lvl, limiterType, limiterArgs, expression) \
+  do { \
+    static ::ndn::util::LogCallSite ndn_cxx__site(&getNdnCxxLogger, ::ndn::util::LogLevel::lvl, \
+                                                  __FILE__, __LINE__, BOOST_STRINGIZE(expression)); \
+    static ::ndn::util::limiterType ndn_cxx__limiter limiterArgs; \
+    uint64_t ndn_cxx__nSuppressed = 0; \
+    if (ndn_cxx__site.isEnabled() && ndn_cxx__limiter.shouldLog(ndn_cxx__nSuppressed)) { \
+      ::ndn::util::LogRecord ndn_cxx__record(ndn_cxx__site); \
+      ndn_cxx__record << expression; \
+      if (ndn_cxx__nSuppressed > 0) { \
+        ndn_cxx__record << NDN_CXX_LOG_LITERAL(" [suppressed ") << ndn_cxx__nSuppressed \
+                        << NDN_CXX_LOG_LITERAL(" messages]"); \
+      } \
+      ndn_cxx__site.getLogger().log(std::move(ndn_cxx__record)); \
+    } \
+  } while (false)
+
+/** \def NDN_CXX_LOG_LEVEL_FLOOR
+ *  \brief numeric value of the least severe LogLevel whose log statements are compiled
+ *
+ *  Log statements less severe than the floor expand to nothing, so that they cost neither a
+ *  runtime check nor code size; they cannot be enabled with LoggerFactory::setSeverityLevels.
+ *  The floor is set with `./waf configure --with-log-level-floor=LEVEL`.
+ *  FATAL statements are always compiled.
+ */
+#ifndef NDN_CXX_LOG_LEVEL_FLOOR
+#define NDN_CXX_LOG_LEVEL_FLOOR 5
+#endif
+
+#if NDN_CXX_LOG_LEVEL_FLOOR >= 5
 /** \brief log at TRACE level
  *  \pre A log module must be declared in the same translation unit.
+ *
+ *  Each level also has rate-limited variants, see NDN_CXX_LOG_LIMITED:
+ *  \li NDN_CXX_LOG_TRACE_EVERY_N(n, expression) logs every n-th execution;
+ *  \li NDN_CXX_LOG_TRACE_EVERY_MS(ms, expression) logs at most once every ms milliseconds;
+ *  \li NDN_CXX_LOG_TRACE_RATE(rate, burst, expression) logs at most rate messages per second
+ *      on average, with bursts of up to burst messages.
  */
-#define NDN_CXX_LOG_TRACE(expression) NDN_CXX_LOG(TRACE, TRACE, expression)
+#define NDN_CXX_LOG_TRACE(expression) NDN_CXX_LOG(TRACE, expression)
+#define NDN_CXX_LOG_TRACE_EVERY_N(n, expression) \
+  NDN_CXX_LOG_LIMITED(TRACE, LogEveryN, (n), expression)
+#define NDN_CXX_LOG_TRACE_EVERY_MS(ms, expression) \
+  NDN_CXX_LOG_LIMITED(TRACE, LogEveryMs, (ms), expression)
+#define NDN_CXX_LOG_TRACE_RATE(rate, burst, expression) \
+  NDN_CXX_LOG_LIMITED(TRACE, LogTokenBucket, (rate, burst), expression)
+#else
+#define NDN_CXX_LOG_TRACE(expression) do { } while (false)
+#define NDN_CXX_LOG_TRACE_EVERY_N(n, expression) do { } while (false)
+#define NDN_CXX_LOG_TRACE_EVERY_MS(ms, expression) do { } while (false)
+#define NDN_CXX_LOG_TRACE_RATE(rate, burst, expression) do { } while (false)
+#endif
 
+#if NDN_CXX_LOG_LEVEL_FLOOR >= 4
 /** \brief log at DEBUG level
  *  \pre A log module must be declared in the same translation unit.
  */
-#define NDN_CXX_LOG_DEBUG(expression) NDN_CXX_LOG(DEBUG, DEBUG, expression)
+#define NDN_CXX_LOG_DEBUG(expression) NDN_CXX_LOG(DEBUG, expression)
+#define NDN_CXX_LOG_DEBUG_EVERY_N(n, expression) \
+  NDN_CXX_LOG_LIMITED(DEBUG, LogEveryN, (n), expression)
+#define NDN_CXX_LOG_DEBUG_EVERY_MS(ms, expression) \
+  NDN_CXX_LOG_LIMITED(DEBUG, LogEveryMs, (ms), expression)
+#define NDN_CXX_LOG_DEBUG_RATE(rate, burst, expression) \
+  NDN_CXX_LOG_LIMITED(DEBUG, LogTokenBucket, (rate, burst), expression)
+#else
+#define NDN_CXX_LOG_DEBUG(expression) do { } while (false)
+#define NDN_CXX_LOG_DEBUG_EVERY_N(n, expression) do { } while (false)
+#define NDN_CXX_LOG_DEBUG_EVERY_MS(ms, expression) do { } while (false)
+#define NDN_CXX_LOG_DEBUG_RATE(rate, burst, expression) do { } while (false)
+#endif
 
+#if NDN_CXX_LOG_LEVEL_FLOOR >= 3
 /** \brief log at INFO level
  *  \pre A log module must be declared in the same translation unit.
  */
-#define NDN_CXX_LOG_INFO(expression) NDN_CXX_LOG(INFO, INFO, expression)
+#define NDN_CXX_LOG_INFO(expression) NDN_CXX_LOG(INFO, expression)
+#define NDN_CXX_LOG_INFO_EVERY_N(n, expression) \
+  NDN_CXX_LOG_LIMITED(INFO, LogEveryN, (n), expression)
+#define NDN_CXX_LOG_INFO_EVERY_MS(ms, expression) \
+  NDN_CXX_LOG_LIMITED(INFO, LogEveryMs, (ms), expression)
+#define NDN_CXX_LOG_INFO_RATE(rate, burst, expression) \
+  NDN_CXX_LOG_LIMITED(INFO, LogTokenBucket, (rate, burst), expression)
+#else
+#define NDN_CXX_LOG_INFO(expression) do { } while (false)
+#define NDN_CXX_LOG_INFO_EVERY_N(n, expression) do { } while (false)
+#define NDN_CXX_LOG_INFO_EVERY_MS(ms, expression) do { } while (false)
+#define NDN_CXX_LOG_INFO_RATE(rate, burst, expression) do { } while (false)
+#endif
 
+#if NDN_CXX_LOG_LEVEL_FLOOR >= 2
 /** \brief log at WARN level
  *  \pre A log module must be declared in the same translation unit.
  */
-#define NDN_CXX_LOG_WARN(expression) NDN_CXX_LOG(WARN, WARNING, expression)
+#define NDN_CXX_LOG_WARN(expression) NDN_CXX_LOG(WARN, expression)
+#define NDN_CXX_LOG_WARN_EVERY_N(n, expression) \
+  NDN_CXX_LOG_LIMITED(WARN, LogEveryN, (n), expression)
+#define NDN_CXX_LOG_WARN_EVERY_MS(ms, expression) \
+  NDN_CXX_LOG_LIMITED(WARN, LogEveryMs, (ms), expression)
+#define NDN_CXX_LOG_WARN_RATE(rate, burst, expression) \
+  NDN_CXX_LOG_LIMITED(WARN, LogTokenBucket, (rate, burst), expression)
+#else
+#define NDN_CXX_LOG_WARN(expression) do { } while (false)
+#define NDN_CXX_LOG_WARN_EVERY_N(n, expression) do { } while (false)
+#define NDN_CXX_LOG_WARN_EVERY_MS(ms, expression) do { } while (false)
+#define NDN_CXX_LOG_WARN_RATE(rate, burst, expression) do { } while (false)
+#endif
 
+#if NDN_CXX_LOG_LEVEL_FLOOR >= 1
 /** \brief log at ERROR level
  *  \pre A log module must be declared in the same translation unit.
  */
-#define NDN_CXX_LOG_ERROR(expression) NDN_CXX_LOG(ERROR, ERROR, expression)
+#define NDN_CXX_LOG_ERROR(expression) NDN_CXX_LOG(ERROR, expression)
+#define NDN_CXX_LOG_ERROR_EVERY_N(n, expression) \
+  NDN_CXX_LOG_LIMITED(ERROR, LogEveryN, (n), expression)
+#define NDN_CXX_LOG_ERROR_EVERY_MS(ms, expression) \
+  NDN_CXX_LOG_LIMITED(ERROR, LogEveryMs, (ms), expression)
+#define NDN_CXX_LOG_ERROR_RATE(rate, burst, expression) \
+  NDN_CXX_LOG_LIMITED(ERROR, LogTokenBucket, (rate, burst), expression)
+#else
+#define NDN_CXX_LOG_ERROR(expression) do { } while (false)
+#define NDN_CXX_LOG_ERROR_EVERY_N(n, expression) do { } while (false)
+#define NDN_CXX_LOG_ERROR_EVERY_MS(ms, expression) do { } while (false)
+#define NDN_CXX_LOG_ERROR_RATE(rate, burst, expression) do { } while (false)
+#endif
 
 /** \brief log at FATAL level
  *  \pre A log module must be declared in the same translation unit.
  */
-#define NDN_CXX_LOG_FATAL(expression) NDN_CXX_LOG(FATAL, FATAL, expression)
+#define NDN_CXX_LOG_FATAL(expression) NDN_CXX_LOG(FATAL, expression)
 
 } // namespace util
 } // namespace ndn
@@ -149,10 +599,25 @@ operator<<(std::ostream& os, const LoggerTimestamp&);
 #define NDN_CXX_LOG_INIT(name) struct ndn_cxx__allow_trailing_semicolon
 
 #define NDN_CXX_LOG_TRACE(expression) do { } while (false)
+#define NDN_CXX_LOG_TRACE_EVERY_N(n, expression) do { } while (false)
+#define NDN_CXX_LOG_TRACE_EVERY_MS(ms, expression) do { } while (false)
+#define NDN_CXX_LOG_TRACE_RATE(rate, burst, expression) do { } while (false)
 #define NDN_CXX_LOG_DEBUG(expression) do { } while (false)
+#define NDN_CXX_LOG_DEBUG_EVERY_N(n, expression) do { } while (false)
+#define NDN_CXX_LOG_DEBUG_EVERY_MS(ms, expression) do { } while (false)
+#define NDN_CXX_LOG_DEBUG_RATE(rate, burst, expression) do { } while (false)
 #define NDN_CXX_LOG_INFO(expression) do { } while (false)
+#define NDN_CXX_LOG_INFO_EVERY_N(n, expression) do { } while (false)
+#define NDN_CXX_LOG_INFO_EVERY_MS(ms, expression) do { } while (false)
+#define NDN_CXX_LOG_INFO_RATE(rate, burst, expression) do { } while (false)
 #define NDN_CXX_LOG_WARN(expression) do { } while (false)
+#define NDN_CXX_LOG_WARN_EVERY_N(n, expression) do { } while (false)
+#define NDN_CXX_LOG_WARN_EVERY_MS(ms, expression) do { } while (false)
+#define NDN_CXX_LOG_WARN_RATE(rate, burst, expression) do { } while (false)
 #define NDN_CXX_LOG_ERROR(expression) do { } while (false)
+#define NDN_CXX_LOG_ERROR_EVERY_N(n, expression) do { } while (false)
+#define NDN_CXX_LOG_ERROR_EVERY_MS(ms, expression) do { } while (false)
+#define NDN_CXX_LOG_ERROR_RATE(rate, burst, expression) do { } while (false)
 #define NDN_CXX_LOG_FATAL(expression) do { } while (false)
 
 #endif // NDN_CXX_ENABLE_LOGGING
@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "packet-capture.hpp"
+
+namespace ndn {
+namespace util {
+
+namespace {
+
+const uint32_t PCAP_MAGIC = 0xa1b2c3d4; // microsecond timestamps, in host byte order
+const uint16_t PCAP_VERSION_MAJOR = 2;
+const uint16_t PCAP_VERSION_MINOR = 4;
+const uint32_t PCAP_SNAPLEN = 262144;
+const uint32_t LINKTYPE_ETHERNET = 1;
+
+const size_t ETHERNET_HEADER_SIZE = 14;
+const uint8_t LOCAL_ADDRESS[] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+const uint8_t REMOTE_ADDRESS[] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x02};
+const uint16_t ETHERTYPE_NDN = 0x8624;
+
+template<typename T>
+void
+writeValue(std::ostream& os, T value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+} // namespace
+
+PacketCapture::Options::Options()
+  : capacity(65536)
+{
+}
+
+PacketCapture::PacketCapture(std::ostream& os, const Options& options)
+  : m_options(options)
+  , m_os(os)
+  , m_nCaptured(0)
+  , m_nDropped(0)
+  , m_nWritten(0)
+  , m_shouldStop(false)
+{
+  BOOST_ASSERT(m_options.capacity > 0);
+
+  this->writeFileHeader();
+  m_writer = std::thread(&PacketCapture::runWriter, this);
+}
+
+PacketCapture::PacketCapture(const std::string& path, const Options& options)
+  : m_options(options)
+  , m_file(path, std::ios::binary | std::ios::trunc)
+  , m_os(m_file)
+  , m_nCaptured(0)
+  , m_nDropped(0)
+  , m_nWritten(0)
+  , m_shouldStop(false)
+{
+  BOOST_ASSERT(m_options.capacity > 0);
+
+  if (!m_file) {
+    BOOST_THROW_EXCEPTION(Error("Cannot create capture file " + path));
+  }
+
+  this->writeFileHeader();
+  m_writer = std::thread(&PacketCapture::runWriter, this);
+}
+
+PacketCapture::~PacketCapture()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_shouldStop = true;
+  }
+  m_hasPackets.notify_one();
+  m_writer.join();
+
+  this->flush();
+}
+
+bool
+PacketCapture::wantsPacket(const Name& name) const
+{
+  if (m_options.prefixes.empty()) {
+    return true;
+  }
+  return std::any_of(m_options.prefixes.begin(), m_options.prefixes.end(),
+                     [&name] (const Name& prefix) { return prefix.isPrefixOf(name); });
+}
+
+void
+PacketCapture::capture(Direction direction, const Block& wire)
+{
+  Entry entry{time::system_clock::now(), direction, wire};
+  if (wire.getBuffer()->size() != wire.size()) {
+    // a received packet refers to a whole receive buffer of StreamTransport, which the queue
+    // would keep from being reused; the packet is copied into a buffer of its own size
+    entry.wire = Block(wire.wire(), wire.size());
+  }
+
+  std::unique_lock<std::mutex> lock(m_queueMutex);
+  if (m_queue.size() >= m_options.capacity) {
+    m_queue.pop_front();
+    ++m_nDropped;
+  }
+  m_queue.push_back(std::move(entry));
+  ++m_nCaptured;
+
+  bool wasEmpty = m_queue.size() == 1;
+  lock.unlock();
+  if (wasEmpty) {
+    m_hasPackets.notify_one();
+  }
+}
+
+void
+PacketCapture::flush()
+{
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  this->drain();
+  m_os.flush();
+}
+
+PacketCapture::Statistics
+PacketCapture::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(m_queueMutex);
+  Statistics st;
+  st.nCaptured = m_nCaptured;
+  st.nDropped = m_nDropped;
+  st.nWritten = m_nWritten;
+  return st;
+}
+
+void
+PacketCapture::writeFileHeader()
+{
+  writeValue(m_os, PCAP_MAGIC);
+  writeValue(m_os, PCAP_VERSION_MAJOR);
+  writeValue(m_os, PCAP_VERSION_MINOR);
+  writeValue<int32_t>(m_os, 0); // thiszone
+  writeValue<uint32_t>(m_os, 0); // sigfigs
+  writeValue(m_os, PCAP_SNAPLEN);
+  writeValue(m_os, LINKTYPE_ETHERNET);
+  m_os.flush();
+}
+
+void
+PacketCapture::runWriter()
+{
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_queueMutex);
+      m_hasPackets.wait(lock, [this] { return !m_queue.empty() || m_shouldStop; });
+      if (m_shouldStop) {
+        return;
+      }
+    }
+
+    std::lock_guard<std::mutex> writeLock(m_writeMutex);
+    this->drain();
+  }
+}
+
+void
+PacketCapture::drain()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_batch.swap(m_queue);
+  }
+
+  if (m_batch.empty()) {
+    return;
+  }
+
+  for (const Entry& entry : m_batch) {
+    this->writeEntry(entry);
+  }
+  m_os.flush();
+
+  std::lock_guard<std::mutex> lock(m_queueMutex);
+  m_nWritten += m_batch.size();
+  m_batch.clear();
+}
+
+void
+PacketCapture::writeEntry(const Entry& entry)
+{
+  auto sinceEpoch = time::duration_cast<time::microseconds>(entry.timestamp.time_since_epoch());
+  uint32_t length = static_cast<uint32_t>(ETHERNET_HEADER_SIZE + entry.wire.size());
+  uint32_t capturedLength = std::min(length, PCAP_SNAPLEN);
+
+  writeValue(m_os, static_cast<uint32_t>(sinceEpoch.count() / 1000000));
+  writeValue(m_os, static_cast<uint32_t>(sinceEpoch.count() % 1000000));
+  writeValue(m_os, capturedLength);
+  writeValue(m_os, length);
+
+  bool isOutgoing = entry.direction == Direction::OUTGOING;
+  m_os.write(reinterpret_cast<const char*>(isOutgoing ? REMOTE_ADDRESS : LOCAL_ADDRESS),
+             sizeof(LOCAL_ADDRESS));
+  m_os.write(reinterpret_cast<const char*>(isOutgoing ? LOCAL_ADDRESS : REMOTE_ADDRESS),
+             sizeof(LOCAL_ADDRESS));
+  m_os.put(static_cast<char>(ETHERTYPE_NDN >> 8));
+  m_os.put(static_cast<char>(ETHERTYPE_NDN & 0xFF));
+  m_os.write(reinterpret_cast<const char*>(entry.wire.wire()),
+             capturedLength - ETHERNET_HEADER_SIZE);
+}
+
+} // namespace util
+} // namespace ndn
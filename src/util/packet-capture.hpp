@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_PACKET_CAPTURE_HPP
+#define NDN_UTIL_PACKET_CAPTURE_HPP
+
+#include "../encoding/block.hpp"
+#include "../name.hpp"
+#include "time.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace ndn {
+namespace util {
+
+/** \brief captures wire-encoded packets into a pcap file
+ *
+ *  Each captured packet is written as an Ethernet frame with the NDN EtherType, so that the
+ *  capture can be inspected with Wireshark or replayed.  The direction of a packet is encoded
+ *  in the MAC addresses: an outgoing packet is sent from 02:00:00:00:00:01 to
+ *  02:00:00:00:00:02, and an incoming packet in the opposite direction.
+ *
+ *  capture() keeps a reference to the buffer of the Block in a queue of limited capacity.
+ *  A Block that occupies only part of its buffer, such as a packet received by StreamTransport
+ *  into a MAX_NDN_PACKET_SIZE receive buffer, is copied into a buffer of its own size instead,
+ *  so that the queue pins only the captured octets.  A writer thread takes all queued packets
+ *  at once, writes them to the stream, and flushes it once per batch.  When the queue is full,
+ *  the oldest queued packet is dropped.
+ */
+class PacketCapture : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  enum class Direction {
+    INCOMING,
+    OUTGOING
+  };
+
+  struct Options
+  {
+    Options();
+
+    size_t capacity;            ///< maximum number of queued packets
+    std::vector<Name> prefixes; ///< capture only packets under these prefixes; empty means all
+  };
+
+  /** \brief counters of a PacketCapture
+   */
+  struct Statistics
+  {
+    uint64_t nCaptured; ///< packets accepted into the queue
+    uint64_t nDropped;  ///< packets dropped due to overflow
+    uint64_t nWritten;  ///< packets written to the stream
+  };
+
+  /** \brief write the capture to \p os
+   *  \note The stream must outlive the PacketCapture.
+   */
+  explicit
+  PacketCapture(std::ostream& os, const Options& options = Options());
+
+  /** \brief create or replace the capture file at \p path
+   *  \throw Error the file cannot be created
+   */
+  explicit
+  PacketCapture(const std::string& path, const Options& options = Options());
+
+  /** \brief write all queued packets and stop the writer thread
+   */
+  ~PacketCapture();
+
+  /** \return whether a packet named \p name passes the prefix filter
+   */
+  bool
+  wantsPacket(const Name& name) const;
+
+  /** \brief enqueue a wire-encoded NDNLPv2 packet, Interest, or Data
+   *
+   *  The capture holds a reference to the buffer of \p wire until the packet is written, or
+   *  to a copy if \p wire does not span its entire buffer.
+   *  The prefix filter is not applied; call wantsPacket() first.
+   */
+  void
+  capture(Direction direction, const Block& wire);
+
+  /** \brief write all queued packets and flush the stream
+   */
+  void
+  flush();
+
+  Statistics
+  getStatistics() const;
+
+private:
+  struct Entry
+  {
+    time::system_clock::TimePoint timestamp;
+    Direction direction;
+    Block wire;
+  };
+
+  void
+  writeFileHeader();
+
+  void
+  runWriter();
+
+  /** \brief write all queued packets to the stream, and flush it
+   *  \pre m_writeMutex is locked
+   */
+  void
+  drain();
+
+  void
+  writeEntry(const Entry& entry);
+
+private:
+  const Options m_options;
+  std::ofstream m_file;
+  std::ostream& m_os;
+
+  mutable std::mutex m_queueMutex;
+  std::condition_variable m_hasPackets;
+  std::deque<Entry> m_queue;
+  uint64_t m_nCaptured;
+  uint64_t m_nDropped;
+  uint64_t m_nWritten;
+  bool m_shouldStop;
+
+  std::mutex m_writeMutex; ///< serializes access to the stream
+  std::deque<Entry> m_batch;
+
+  std::thread m_writer;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_PACKET_CAPTURE_HPP
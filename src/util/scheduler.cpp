@@ -23,6 +23,9 @@
 
 #include "scheduler.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace ndn {
 namespace util {
 namespace scheduler {
@@ -32,6 +35,19 @@ struct EventIdImpl
   EventIdImpl(const Scheduler::EventQueue::iterator& event)
     : m_event(event)
     , m_isValid(true)
+    , m_node(std::numeric_limits<uint32_t>::max())
+    , m_generation(0)
+  {
+  }
+
+  /**
+   * \brief refers to an event in the node pool of a WheelEngine
+   */
+  EventIdImpl(uint32_t node, uint32_t generation)
+    : m_event()
+    , m_isValid(true)
+    , m_node(node)
+    , m_generation(generation)
   {
   }
 
@@ -62,6 +78,10 @@ struct EventIdImpl
 private:
   Scheduler::EventQueue::iterator m_event;
   bool m_isValid;
+
+public:
+  uint32_t m_node; ///< index of the event node in a WheelEngine, or NIL for a MULTISET event
+  uint32_t m_generation; ///< generation of the node when the event was scheduled
 };
 
 Scheduler::EventInfo::EventInfo(const time::nanoseconds& after,
@@ -90,17 +110,487 @@ Scheduler::EventInfo::expiresFromNow() const
 }
 
 
-Scheduler::Scheduler(boost::asio::io_service& ioService)
+/**
+ * \brief the TIMING_WHEEL engine
+ *
+ * Events live in a pool of nodes, and an EventId refers to a node by index and generation.
+ * The generation of a node is incremented whenever its event fires or is cancelled, so that
+ * stale EventIds are ignored.  An event due within NSLOTS ticks is put in the slot of its tick,
+ * in a doubly linked list of nodes; a later event is put in a 4-ary heap.  A bitmap of
+ * non-empty slots finds the next event on the wheel.
+ */
+class Scheduler::WheelEngine : noncopyable
+{
+public:
+  explicit
+  WheelEngine(boost::asio::io_service& ioService)
+    : m_freeNodes(NIL)
+    , m_nextSequence(0)
+    , m_size(0)
+    , m_nOnWheel(0)
+    , m_epoch(time::steady_clock::now())
+    , m_currentTick(0)
+    , m_slots(NSLOTS, NIL)
+    , m_bitmap{}
+    , m_deadlineTimer(ioService)
+    , m_isArmed(false)
+    , m_isFiring(false)
+  {
+  }
+
+  EventId
+  schedule(const time::nanoseconds& after, const Event& event)
+  {
+    time::steady_clock::TimePoint now = time::steady_clock::now();
+    if (m_nOnWheel == 0) {
+      // nothing is on the wheel, so it can move to the present
+      m_currentTick = std::max(this->getTick(now), m_currentTick);
+    }
+
+    uint32_t index = this->allocateNode();
+    Node& node = m_nodes[index];
+    node.when = now + after;
+    node.sequence = m_nextSequence++;
+    node.event = event;
+    this->place(index);
+    ++m_size;
+
+    if (!m_isFiring && (!m_isArmed || node.when < m_armedTime)) {
+      this->arm(node.when);
+    }
+    return make_shared<EventIdImpl>(index, node.generation);
+  }
+
+  void
+  cancel(const EventIdImpl& eventId)
+  {
+    if (eventId.m_node >= m_nodes.size() ||
+        m_nodes[eventId.m_node].generation != eventId.m_generation) {
+      return; // event already fired or cancelled
+    }
+
+    uint32_t index = eventId.m_node;
+    switch (m_nodes[index].location) {
+    case Location::WHEEL:
+      this->unlink(index);
+      --m_size;
+      break;
+    case Location::HEAP:
+      this->heapErase(m_nodes[index].heapPosition);
+      --m_size;
+      break;
+    case Location::DUE:
+      break;
+    case Location::FREE:
+      return;
+    }
+    this->releaseNode(index);
+
+    if (m_size == 0 && !m_isFiring) {
+      // let the io_service run out of work
+      this->disarm();
+    }
+  }
+
+  void
+  cancelAll()
+  {
+    for (uint32_t index = 0; index < m_nodes.size(); ++index) {
+      if (m_nodes[index].location != Location::FREE) {
+        this->releaseNode(index);
+      }
+    }
+    std::fill(m_slots.begin(), m_slots.end(), NIL);
+    std::fill(std::begin(m_bitmap), std::end(m_bitmap), 0);
+    m_heap.clear();
+    m_size = 0;
+    m_nOnWheel = 0;
+    this->disarm();
+  }
+
+private:
+  static const uint32_t NIL = std::numeric_limits<uint32_t>::max();
+  static const size_t SLOT_BITS = 12;
+  static const size_t NSLOTS = size_t(1) << SLOT_BITS;
+  static const size_t SLOT_MASK = NSLOTS - 1;
+  static const size_t NWORDS = NSLOTS / 64;
+  static const size_t HEAP_ARITY = 4;
+
+  static time::nanoseconds
+  getAccuracy()
+  {
+    return time::milliseconds(1);
+  }
+
+  enum class Location : uint8_t {
+    FREE,  ///< in the free list
+    WHEEL, ///< in the list of a slot
+    HEAP,  ///< in the heap
+    DUE,   ///< taken out to be fired
+  };
+
+  struct Node
+  {
+    time::steady_clock::TimePoint when;
+    uint64_t sequence; ///< order of scheduling, to break ties between events due at once
+    Event event;
+    uint32_t generation = 0;
+    uint32_t prev = NIL;
+    uint32_t next = NIL; ///< next node in the slot, or in the free list
+    uint32_t slot = NIL;
+    uint32_t heapPosition = NIL;
+    Location location = Location::FREE;
+  };
+
+  bool
+  isEarlier(uint32_t a, uint32_t b) const
+  {
+    const Node& x = m_nodes[a];
+    const Node& y = m_nodes[b];
+    return x.when < y.when || (x.when == y.when && x.sequence < y.sequence);
+  }
+
+  uint64_t
+  getTick(const time::steady_clock::TimePoint& when) const
+  {
+    time::nanoseconds sinceEpoch = when - m_epoch;
+    return sinceEpoch <= time::nanoseconds::zero() ? 0 : sinceEpoch.count() / getAccuracy().count();
+  }
+
+  uint32_t
+  allocateNode()
+  {
+    if (m_freeNodes == NIL) {
+      m_nodes.emplace_back();
+      return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+    uint32_t index = m_freeNodes;
+    m_freeNodes = m_nodes[index].next;
+    return index;
+  }
+
+  void
+  releaseNode(uint32_t index)
+  {
+    Node& node = m_nodes[index];
+    node.event = nullptr;
+    ++node.generation;
+    node.location = Location::FREE;
+    node.next = m_freeNodes;
+    m_freeNodes = index;
+  }
+
+  /**
+   * \brief put a node in the slot of its tick, or in the heap if it is beyond the wheel
+   */
+  void
+  place(uint32_t index)
+  {
+    Node& node = m_nodes[index];
+    uint64_t tick = std::max(this->getTick(node.when), m_currentTick);
+    if (tick - m_currentTick >= NSLOTS) {
+      node.location = Location::HEAP;
+      this->heapPush(index);
+      return;
+    }
+
+    size_t slot = tick & SLOT_MASK;
+    node.location = Location::WHEEL;
+    node.slot = slot;
+    ++m_nOnWheel;
+    node.prev = NIL;
+    node.next = m_slots[slot];
+    if (node.next != NIL) {
+      m_nodes[node.next].prev = index;
+    }
+    m_slots[slot] = index;
+    m_bitmap[slot / 64] |= uint64_t(1) << (slot % 64);
+  }
+
+  void
+  unlink(uint32_t index)
+  {
+    Node& node = m_nodes[index];
+    if (node.prev != NIL) {
+      m_nodes[node.prev].next = node.next;
+    }
+    else {
+      m_slots[node.slot] = node.next;
+      if (node.next == NIL) {
+        m_bitmap[node.slot / 64] &= ~(uint64_t(1) << (node.slot % 64));
+      }
+    }
+    if (node.next != NIL) {
+      m_nodes[node.next].prev = node.prev;
+    }
+    --m_nOnWheel;
+  }
+
+  /**
+   * \return distance from slot \p from to the next non-empty slot in the order of the wheel,
+   *         or NSLOTS if all slots are empty
+   */
+  size_t
+  findNonEmptySlot(size_t from) const
+  {
+    size_t word = from / 64;
+    uint64_t bits = m_bitmap[word] & (~uint64_t(0) << (from % 64));
+    for (size_t i = 0; ; ++i) {
+      if (bits != 0) {
+        size_t slot = ((word + i) % NWORDS) * 64 + __builtin_ctzll(bits);
+        return (slot - from) & SLOT_MASK;
+      }
+      if (i == NWORDS) {
+        return NSLOTS;
+      }
+      bits = m_bitmap[(word + i + 1) % NWORDS];
+      if (i + 1 == NWORDS) {
+        // back to the first word: only the slots before from
+        bits &= ~(~uint64_t(0) << (from % 64));
+      }
+    }
+  }
+
+  void
+  heapPush(uint32_t index)
+  {
+    m_heap.push_back(index);
+    this->siftUp(m_heap.size() - 1);
+  }
+
+  void
+  heapErase(size_t position)
+  {
+    uint32_t last = m_heap.back();
+    m_heap.pop_back();
+    if (position == m_heap.size()) {
+      return;
+    }
+    m_heap[position] = last;
+    m_nodes[last].heapPosition = position;
+    if (position > 0 && this->isEarlier(last, m_heap[(position - 1) / HEAP_ARITY])) {
+      this->siftUp(position);
+    }
+    else {
+      this->siftDown(position);
+    }
+  }
+
+  void
+  siftUp(size_t position)
+  {
+    uint32_t index = m_heap[position];
+    while (position > 0) {
+      size_t parent = (position - 1) / HEAP_ARITY;
+      if (!this->isEarlier(index, m_heap[parent])) {
+        break;
+      }
+      m_heap[position] = m_heap[parent];
+      m_nodes[m_heap[position]].heapPosition = position;
+      position = parent;
+    }
+    m_heap[position] = index;
+    m_nodes[index].heapPosition = position;
+  }
+
+  void
+  siftDown(size_t position)
+  {
+    uint32_t index = m_heap[position];
+    while (true) {
+      size_t first = position * HEAP_ARITY + 1;
+      if (first >= m_heap.size()) {
+        break;
+      }
+      size_t earliest = first;
+      for (size_t child = first + 1; child < std::min(first + HEAP_ARITY, m_heap.size()); ++child) {
+        if (this->isEarlier(m_heap[child], m_heap[earliest])) {
+          earliest = child;
+        }
+      }
+      if (!this->isEarlier(m_heap[earliest], index)) {
+        break;
+      }
+      m_heap[position] = m_heap[earliest];
+      m_nodes[m_heap[position]].heapPosition = position;
+      position = earliest;
+    }
+    m_heap[position] = index;
+    m_nodes[index].heapPosition = position;
+  }
+
+  /**
+   * \brief move the events of the earliest tick that has events due at \p now from the wheel
+   *        and the heap to m_due, and advance the wheel to that tick
+   */
+  void
+  collectDueEvents(const time::steady_clock::TimePoint& now)
+  {
+    uint64_t nowTick = std::max(this->getTick(now), m_currentTick);
+    uint64_t tick = std::numeric_limits<uint64_t>::max();
+    size_t distance = this->findNonEmptySlot(m_currentTick & SLOT_MASK);
+    if (distance < NSLOTS && m_currentTick + distance <= nowTick) {
+      tick = m_currentTick + distance;
+    }
+    if (!m_heap.empty() && m_nodes[m_heap.front()].when <= now) {
+      tick = std::min(tick, std::max(this->getTick(m_nodes[m_heap.front()].when), m_currentTick));
+    }
+    if (tick == std::numeric_limits<uint64_t>::max()) {
+      return;
+    }
+    m_currentTick = tick;
+
+    auto takeNode = [this] (uint32_t index) {
+      m_nodes[index].location = Location::DUE;
+      m_due.emplace_back(index, m_nodes[index].generation);
+      --m_size;
+    };
+
+    // only the slot of the present tick can hold events that are not due yet
+    uint32_t index = m_slots[tick & SLOT_MASK];
+    while (index != NIL) {
+      uint32_t next = m_nodes[index].next;
+      if (m_nodes[index].when <= now) {
+        this->unlink(index);
+        takeNode(index);
+      }
+      index = next;
+    }
+
+    while (!m_heap.empty() && m_nodes[m_heap.front()].when <= now &&
+           this->getTick(m_nodes[m_heap.front()].when) <= tick) {
+      index = m_heap.front();
+      this->heapErase(0);
+      takeNode(index);
+    }
+  }
+
+  void
+  onTimer(const boost::system::error_code& error)
+  {
+    if (error) // e.g., cancelled
+      return;
+
+    m_isArmed = false;
+    m_isFiring = true;
+
+    time::steady_clock::TimePoint now = time::steady_clock::now();
+    // events scheduled by the callbacks can be due as well
+    for (this->collectDueEvents(now); !m_due.empty(); this->collectDueEvents(now)) {
+      std::sort(m_due.begin(), m_due.end(),
+                [this] (const std::pair<uint32_t, uint32_t>& a,
+                        const std::pair<uint32_t, uint32_t>& b) {
+                  return this->isEarlier(a.first, b.first);
+                });
+      for (const auto& entry : m_due) {
+        Node& node = m_nodes[entry.first];
+        if (node.generation != entry.second) {
+          continue; // cancelled by an earlier event
+        }
+        Event event = std::move(node.event);
+        this->releaseNode(entry.first);
+        event();
+      }
+      m_due.clear();
+    }
+    m_currentTick = std::max(this->getTick(now), m_currentTick);
+
+    m_isFiring = false;
+    this->rearm();
+  }
+
+  /**
+   * \brief arm the deadline timer for the earliest event, or disarm it if there is none
+   */
+  void
+  rearm()
+  {
+    if (m_size == 0) {
+      this->disarm();
+      return;
+    }
+
+    uint32_t earliest = m_heap.empty() ? NIL : m_heap.front();
+    size_t distance = this->findNonEmptySlot(m_currentTick & SLOT_MASK);
+    if (distance < NSLOTS) {
+      for (uint32_t index = m_slots[(m_currentTick + distance) & SLOT_MASK]; index != NIL;
+           index = m_nodes[index].next) {
+        if (earliest == NIL || this->isEarlier(index, earliest)) {
+          earliest = index;
+        }
+      }
+    }
+    this->arm(m_nodes[earliest].when);
+  }
+
+  void
+  arm(const time::steady_clock::TimePoint& when)
+  {
+    if (m_isArmed && when == m_armedTime) {
+      return;
+    }
+    m_isArmed = true;
+    m_armedTime = when;
+    m_deadlineTimer.expires_at(when);
+    m_deadlineTimer.async_wait(bind(&WheelEngine::onTimer, this, _1));
+  }
+
+  void
+  disarm()
+  {
+    if (m_isArmed) {
+      m_isArmed = false;
+      m_deadlineTimer.cancel();
+    }
+  }
+
+private:
+  std::vector<Node> m_nodes;
+  uint32_t m_freeNodes; ///< head of the free list
+  uint64_t m_nextSequence;
+  size_t m_size; ///< number of events on the wheel or in the heap
+  size_t m_nOnWheel;
+
+  time::steady_clock::TimePoint m_epoch; ///< time of tick 0
+  uint64_t m_currentTick; ///< the wheel holds the ticks from m_currentTick to m_currentTick + SLOT_MASK
+  std::vector<uint32_t> m_slots; ///< first node of each slot
+  uint64_t m_bitmap[NWORDS]; ///< non-empty slots
+  std::vector<uint32_t> m_heap;
+  std::vector<std::pair<uint32_t, uint32_t>> m_due; ///< node and generation of due events
+
+  monotonic_deadline_timer m_deadlineTimer;
+  time::steady_clock::TimePoint m_armedTime;
+  bool m_isArmed;
+  bool m_isFiring;
+};
+
+const uint32_t Scheduler::WheelEngine::NIL;
+const size_t Scheduler::WheelEngine::SLOT_BITS;
+const size_t Scheduler::WheelEngine::NSLOTS;
+const size_t Scheduler::WheelEngine::SLOT_MASK;
+const size_t Scheduler::WheelEngine::NWORDS;
+const size_t Scheduler::WheelEngine::HEAP_ARITY;
+
+Scheduler::Scheduler(boost::asio::io_service& ioService, Engine engine)
   : m_scheduledEvent(m_events.end())
   , m_deadlineTimer(ioService)
   , m_isEventExecuting(false)
 {
+  if (engine == Engine::TIMING_WHEEL) {
+    m_wheel.reset(new WheelEngine(ioService));
+  }
 }
 
+Scheduler::~Scheduler() = default;
+
 EventId
 Scheduler::scheduleEvent(const time::nanoseconds& after,
                          const Event& event)
 {
+  if (m_wheel != nullptr) {
+    return m_wheel->schedule(after, event);
+  }
+
   EventQueue::iterator i = m_events.insert(EventInfo(after, event));
 
   // On OSX 10.9, boost, and C++03 the following doesn't work without ndn::
@@ -127,6 +617,11 @@ Scheduler::cancelEvent(const EventId& eventId)
   if (!static_cast<bool>(eventId) || !eventId->isValid())
     return; // event already fired or cancelled
 
+  if (m_wheel != nullptr) {
+    m_wheel->cancel(*eventId);
+    return;
+  }
+
   if (static_cast<EventQueue::iterator>(*eventId) != m_scheduledEvent) {
     m_events.erase(*eventId);
     eventId->invalidate();
@@ -155,6 +650,11 @@ Scheduler::cancelEvent(const EventId& eventId)
 void
 Scheduler::cancelAllEvents()
 {
+  if (m_wheel != nullptr) {
+    m_wheel->cancelAll();
+    return;
+  }
+
   m_events.clear();
   m_deadlineTimer.cancel();
 }
@@ -45,7 +45,34 @@ class Scheduler
 public:
   typedef function<void()> Event;
 
-  Scheduler(boost::asio::io_service& ioService);
+  /**
+   * \brief Data structures that can hold the scheduled events
+   */
+  enum class Engine {
+    /**
+     * \brief a std::multiset ordered by time
+     *
+     * Each event allocates a tree node, and scheduling or cancelling an event takes O(log n).
+     */
+    MULTISET,
+    /**
+     * \brief a timing wheel of 1 ms slots for events due within about 4 seconds, and a 4-ary
+     *        heap for later events
+     *
+     * Events are kept in a pool of nodes that is reused.  Scheduling or cancelling an event on
+     * the wheel takes O(1), and on the heap O(log n).  Events still fire at their scheduled
+     * time, in the same order as with MULTISET.
+     *
+     * \note Each scheduled event still allocates the EventId it returns, so the node pool
+     *       saves the tree node allocation of MULTISET but not every allocation.
+     */
+    TIMING_WHEEL
+  };
+
+  explicit
+  Scheduler(boost::asio::io_service& ioService, Engine engine = Engine::MULTISET);
+
+  ~Scheduler();
 
   /**
    * \brief Schedule one time event after the specified delay
@@ -100,6 +127,9 @@ private:
   typedef std::multiset<EventInfo> EventQueue;
   friend struct EventIdImpl;
 
+  class WheelEngine;
+  unique_ptr<WheelEngine> m_wheel; ///< non-null if the TIMING_WHEEL engine is used
+
   EventQueue m_events;
   EventQueue::iterator m_scheduledEvent;
   monotonic_deadline_timer m_deadlineTimer;
@@ -0,0 +1,320 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "timing-wheel.hpp"
+
+namespace ndn {
+namespace util {
+
+const size_t TimingWheel::NLEVELS;
+const size_t TimingWheel::SLOT_BITS;
+const size_t TimingWheel::NSLOTS;
+const uint64_t TimingWheel::NOT_ARMED;
+
+static const uint64_t SLOT_MASK = TimingWheel::NSLOTS - 1;
+
+TimingWheel::Timer::Timer()
+  : m_wheel(nullptr)
+  , m_tick(0)
+  , m_level(0)
+{
+  prev = next = nullptr;
+}
+
+TimingWheel::Timer::~Timer()
+{
+  this->cancel();
+}
+
+void
+TimingWheel::Timer::cancel()
+{
+  if (m_wheel == nullptr) {
+    return;
+  }
+
+  TimingWheel& wheel = *m_wheel;
+  wheel.unlink(*this);
+  m_callback = nullptr;
+
+  if (wheel.m_size == 0 && !wheel.m_isFiring) {
+    // let the io_service run out of work
+    wheel.rearm();
+  }
+}
+
+TimingWheel::TimingWheel(boost::asio::io_service& ioService, const time::nanoseconds& accuracy)
+  : m_accuracy(accuracy)
+  , m_epoch(time::steady_clock::now())
+  , m_currentTick(0)
+  , m_size(0)
+  , m_isFiring(false)
+  , m_deadlineTimer(ioService)
+  , m_armedTick(NOT_ARMED)
+{
+  if (accuracy <= time::nanoseconds::zero()) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("TimingWheel accuracy must be positive"));
+  }
+
+  for (size_t level = 0; level < NLEVELS; ++level) {
+    for (Link& slot : m_slots[level]) {
+      slot.prev = slot.next = &slot;
+    }
+    m_nTimers[level] = 0;
+  }
+}
+
+TimingWheel::~TimingWheel()
+{
+  for (size_t level = 0; level < NLEVELS; ++level) {
+    for (Link& slot : m_slots[level]) {
+      for (Link* link = slot.next; link != &slot; link = link->next) {
+        Timer& timer = static_cast<Timer&>(*link);
+        timer.m_wheel = nullptr;
+        timer.m_callback = nullptr;
+      }
+    }
+  }
+}
+
+void
+TimingWheel::schedule(Timer& timer, const time::nanoseconds& after, const Callback& callback)
+{
+  if (timer.m_wheel != nullptr) {
+    BOOST_ASSERT(timer.m_wheel == this);
+    this->unlink(timer);
+  }
+
+  timer.m_expiry = time::steady_clock::now() + after;
+  timer.m_callback = callback;
+  this->insert(timer);
+
+  if (m_isFiring || timer.m_tick >= m_armedTick) {
+    return;
+  }
+  if (timer.m_level > 0) {
+    // the deadline timer is armed for the tick that cascades the timer
+    this->rearm();
+  }
+  else {
+    m_armedTick = timer.m_tick;
+    m_deadlineTimer.expires_at(this->getTickTime(m_armedTick));
+    m_deadlineTimer.async_wait(bind(&TimingWheel::onTimer, this, _1));
+  }
+}
+
+void
+TimingWheel::setAccuracy(const time::nanoseconds& accuracy)
+{
+  if (accuracy <= time::nanoseconds::zero()) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("TimingWheel accuracy must be positive"));
+  }
+
+  std::vector<Timer*> timers;
+  timers.reserve(m_size);
+  for (size_t level = 0; level < NLEVELS; ++level) {
+    for (Link& slot : m_slots[level]) {
+      for (Link* link = slot.next; link != &slot; link = link->next) {
+        timers.push_back(static_cast<Timer*>(link));
+      }
+      slot.prev = slot.next = &slot;
+    }
+    m_nTimers[level] = 0;
+  }
+  m_size = 0;
+
+  m_accuracy = accuracy;
+  m_epoch = time::steady_clock::now();
+  m_currentTick = 0;
+  for (Timer* timer : timers) {
+    this->insert(*timer);
+  }
+
+  m_armedTick = NOT_ARMED;
+  m_deadlineTimer.cancel();
+  this->rearm();
+}
+
+void
+TimingWheel::insert(Timer& timer)
+{
+  // the first tick at or after the expiry, so that the timer never fires early
+  time::nanoseconds sinceEpoch = timer.m_expiry - m_epoch;
+  uint64_t tick = sinceEpoch <= time::nanoseconds::zero() ? 0 :
+                  (sinceEpoch.count() + m_accuracy.count() - 1) / m_accuracy.count();
+  timer.m_tick = std::max(tick, m_currentTick);
+
+  uint64_t delta = timer.m_tick - m_currentTick;
+  size_t level = 0;
+  while (level < NLEVELS - 1 && delta >> (SLOT_BITS * (level + 1)) != 0) {
+    ++level;
+  }
+
+  uint64_t slotTick = timer.m_tick;
+  if (delta >> (SLOT_BITS * NLEVELS) != 0) {
+    // beyond the range of the wheel: park in the farthest slot, and insert again when reached
+    slotTick = m_currentTick + (uint64_t(1) << (SLOT_BITS * NLEVELS)) - 1;
+  }
+
+  Link& slot = m_slots[level][(slotTick >> (SLOT_BITS * level)) & SLOT_MASK];
+  timer.prev = slot.prev;
+  timer.next = &slot;
+  slot.prev->next = &timer;
+  slot.prev = &timer;
+
+  timer.m_wheel = this;
+  timer.m_level = level;
+  ++m_nTimers[level];
+  ++m_size;
+}
+
+void
+TimingWheel::unlink(Timer& timer)
+{
+  timer.prev->next = timer.next;
+  timer.next->prev = timer.prev;
+  timer.prev = timer.next = nullptr;
+
+  timer.m_wheel = nullptr;
+  --m_nTimers[timer.m_level];
+  --m_size;
+}
+
+void
+TimingWheel::cascade(size_t level, size_t slotIndex)
+{
+  Link& slot = m_slots[level][slotIndex];
+  while (slot.next != &slot) {
+    Timer& timer = static_cast<Timer&>(*slot.next);
+    this->unlink(timer);
+    this->insert(timer);
+  }
+}
+
+void
+TimingWheel::onTimer(const boost::system::error_code& error)
+{
+  if (error) // e.g., cancelled
+    return;
+
+  m_armedTick = NOT_ARMED;
+  m_isFiring = true;
+
+  time::nanoseconds sinceEpoch = time::steady_clock::now() - m_epoch;
+  uint64_t nowTick = sinceEpoch <= time::nanoseconds::zero() ? 0 :
+                     sinceEpoch.count() / m_accuracy.count();
+  while (m_currentTick <= nowTick) {
+    if (m_size == 0) {
+      m_currentTick = nowTick + 1;
+    }
+    else if (m_nTimers[0] == 0 && (m_currentTick & SLOT_MASK) != 0) {
+      // nothing fires before the next tick that cascades
+      m_currentTick = std::min((m_currentTick | SLOT_MASK) + 1, nowTick + 1);
+    }
+    else {
+      this->processTick();
+    }
+  }
+
+  m_isFiring = false;
+  this->rearm();
+}
+
+void
+TimingWheel::processTick()
+{
+  uint64_t tick = m_currentTick;
+  if ((tick & SLOT_MASK) == 0) {
+    for (size_t level = 1; level < NLEVELS; ++level) {
+      size_t slotIndex = (tick >> (SLOT_BITS * level)) & SLOT_MASK;
+      this->cascade(level, slotIndex);
+      if (slotIndex != 0) {
+        break;
+      }
+    }
+  }
+
+  // timers scheduled by the callbacks go to later ticks
+  m_currentTick = tick + 1;
+
+  Link& slot = m_slots[0][tick & SLOT_MASK];
+  if (slot.next == &slot) {
+    return;
+  }
+  Link expired;
+  expired.next = slot.next;
+  expired.prev = slot.prev;
+  expired.next->prev = expired.prev->next = &expired;
+  slot.prev = slot.next = &slot;
+
+  while (expired.next != &expired) {
+    Timer& timer = static_cast<Timer&>(*expired.next);
+    this->unlink(timer);
+    // the callback can destroy the timer
+    Callback callback = std::move(timer.m_callback);
+    timer.m_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+}
+
+void
+TimingWheel::rearm()
+{
+  if (m_size == 0) {
+    if (m_armedTick != NOT_ARMED) {
+      m_armedTick = NOT_ARMED;
+      m_deadlineTimer.cancel();
+    }
+    return;
+  }
+
+  uint64_t nextTick = NOT_ARMED;
+  if (m_nTimers[0] > 0) {
+    for (uint64_t tick = m_currentTick; tick < m_currentTick + NSLOTS; ++tick) {
+      const Link& slot = m_slots[0][tick & SLOT_MASK];
+      if (slot.next != &slot) {
+        nextTick = tick;
+        break;
+      }
+    }
+  }
+  for (size_t level = 1; level < NLEVELS; ++level) {
+    if (m_nTimers[level] > 0) {
+      // the next tick that cascades this level
+      size_t shift = SLOT_BITS * level;
+      uint64_t cascadeTick = ((m_currentTick + (uint64_t(1) << shift) - 1) >> shift) << shift;
+      nextTick = std::min(nextTick, cascadeTick);
+      break;
+    }
+  }
+
+  if (nextTick != m_armedTick) {
+    m_armedTick = nextTick;
+    m_deadlineTimer.expires_at(this->getTickTime(nextTick));
+    m_deadlineTimer.async_wait(bind(&TimingWheel::onTimer, this, _1));
+  }
+}
+
+} // namespace util
+} // namespace ndn
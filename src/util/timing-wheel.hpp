@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_TIMING_WHEEL_HPP
+#define NDN_UTIL_TIMING_WHEEL_HPP
+
+#include "../common.hpp"
+#include "monotonic_deadline_timer.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief Hierarchical timing wheel for large numbers of one-shot timers
+ *
+ * Time is divided into ticks of a configurable accuracy.  The wheel has NLEVELS levels of
+ * NSLOTS slots each: a slot of level 0 holds the timers expiring in one tick, and a slot of
+ * level L holds the timers expiring in NSLOTS^L ticks, which are moved to lower levels when
+ * the wheel reaches them.  Timers are intrusive list nodes owned by the caller, so scheduling
+ * and cancelling a timer take constant time and do not allocate.
+ *
+ * A single deadline timer, armed for the next tick that has expiring timers, drives the
+ * wheel.  A timer never fires before its expiry, and fires at most one tick after it.
+ */
+class TimingWheel : noncopyable
+{
+public:
+  typedef function<void()> Callback;
+
+private:
+  struct Link
+  {
+    Link* prev;
+    Link* next;
+  };
+
+public:
+  /**
+   * @brief a timer that can be scheduled in a TimingWheel
+   *
+   * The timer is cancelled when it is destroyed, or when its wheel is destroyed.
+   */
+  class Timer : private Link, noncopyable
+  {
+  public:
+    Timer();
+
+    ~Timer();
+
+    /**
+     * @brief whether the timer is scheduled and has not fired yet
+     */
+    bool
+    isPending() const
+    {
+      return m_wheel != nullptr;
+    }
+
+    /**
+     * @brief cancel the timer, if it is pending
+     */
+    void
+    cancel();
+
+  private:
+    TimingWheel* m_wheel;
+    time::steady_clock::TimePoint m_expiry;
+    uint64_t m_tick;
+    size_t m_level;
+    Callback m_callback;
+
+    friend class TimingWheel;
+  };
+
+  static const size_t NLEVELS = 4;
+  static const size_t SLOT_BITS = 8;
+  static const size_t NSLOTS = 1 << SLOT_BITS;
+
+  /**
+   * @brief create a timing wheel
+   * @param accuracy duration of one tick; must be positive
+   */
+  explicit
+  TimingWheel(boost::asio::io_service& ioService,
+              const time::nanoseconds& accuracy = time::milliseconds(1));
+
+  /**
+   * @brief cancel all pending timers
+   */
+  ~TimingWheel();
+
+  /**
+   * @brief schedule @p timer to invoke @p callback after @p after
+   *
+   * If @p timer is pending, it is rescheduled.
+   */
+  void
+  schedule(Timer& timer, const time::nanoseconds& after, const Callback& callback);
+
+  /**
+   * @return number of pending timers
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  const time::nanoseconds&
+  getAccuracy() const
+  {
+    return m_accuracy;
+  }
+
+  /**
+   * @brief change the duration of one tick
+   *
+   * Pending timers keep their expiry.  This takes time linear in the number of pending timers.
+   */
+  void
+  setAccuracy(const time::nanoseconds& accuracy);
+
+private:
+  /**
+   * @brief put @p timer in the slot of its tick
+   */
+  void
+  insert(Timer& timer);
+
+  void
+  unlink(Timer& timer);
+
+  /**
+   * @brief move the timers of a slot of a level above 0 to lower levels
+   */
+  void
+  cascade(size_t level, size_t slot);
+
+  /**
+   * @brief process the ticks up to now, then arm the deadline timer for the next one
+   */
+  void
+  onTimer(const boost::system::error_code& error);
+
+  /**
+   * @brief process the current tick: cascade the slots that the tick reaches, and fire the
+   *        timers of its slot of level 0
+   */
+  void
+  processTick();
+
+  void
+  rearm();
+
+  time::steady_clock::TimePoint
+  getTickTime(uint64_t tick) const
+  {
+    return m_epoch + m_accuracy * tick;
+  }
+
+private:
+  time::nanoseconds m_accuracy;
+  time::steady_clock::TimePoint m_epoch; ///< time of tick 0
+  uint64_t m_currentTick; ///< first tick that has not been processed
+  Link m_slots[NLEVELS][NSLOTS]; ///< sentinels of circular lists of timers
+  size_t m_nTimers[NLEVELS];
+  size_t m_size;
+  bool m_isFiring; ///< whether onTimer is processing ticks
+
+  monotonic_deadline_timer m_deadlineTimer;
+  uint64_t m_armedTick; ///< tick the deadline timer is armed for, or NOT_ARMED
+  static const uint64_t NOT_ARMED = std::numeric_limits<uint64_t>::max();
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_TIMING_WHEEL_HPP
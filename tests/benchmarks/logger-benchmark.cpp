@@ -0,0 +1,315 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+/** \file
+ *  \brief measures the cost of log statements
+ *
+ *  Usage: logger-benchmark [-n nRecords] [-t maxThreads] [-b boost|ring|queue]
+ */
+
+#include "util/logger-factory.hpp"
+#include "util/logger-bounded-queue-backend.hpp"
+#include "util/logger-compressed-sink.hpp"
+#include "util/logger-mapped-file-sink.hpp"
+#include "util/logger-ring-buffer-backend.hpp"
+#include "util/logger-tlv-sink.hpp"
+#include "name.hpp"
+
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <unistd.h>
+
+namespace ndn {
+namespace tests_benchmarks_logger {
+
+NDN_CXX_LOG_INIT(LoggerBenchmark);
+
+using util::LogLevel;
+using util::LoggerFactory;
+using util::NullLogSink;
+
+static void
+report(const std::string& title, size_t nRecords, time::nanoseconds duration)
+{
+  double nsPerRecord = static_cast<double>(duration.count()) / nRecords;
+  printf("%-44s %10.1f ns/record %14.0f records/s\n",
+         title.data(), nsPerRecord, 1e9 / nsPerRecord);
+}
+
+/** \return number of write system calls made by this process so far, or -1 if unknown
+ */
+static int64_t
+getWriteSyscallCount()
+{
+  // Linux-specific; other platforms skip this measurement
+  std::ifstream io("/proc/self/io");
+  std::string key;
+  int64_t value;
+  while (io >> key >> value) {
+    if (key == "syscw:") {
+      return value;
+    }
+  }
+  return -1;
+}
+
+static void
+reportWriteSyscalls(const std::string& title, size_t nRecords, int64_t nSyscalls)
+{
+  if (nSyscalls >= 0) {
+    printf("%-44s %10.1f writes/10k records\n", title.data(), nSyscalls * 10000.0 / nRecords);
+  }
+}
+
+static void
+logRecords(size_t nRecords, const Name& name)
+{
+  for (size_t i = 0; i < nRecords; ++i) {
+    NDN_CXX_LOG_DEBUG("record " << i << " name=" << name);
+  }
+}
+
+/** \return time to execute \p nRecords log statements on each of \p nThreads threads,
+ *          and to write them out
+ */
+static time::nanoseconds
+measureLogging(size_t nRecords, size_t nThreads)
+{
+  Name name("/benchmark/logger/name");
+  name.wireEncode();
+
+  time::steady_clock::TimePoint start = time::steady_clock::now();
+  if (nThreads == 1) {
+    logRecords(nRecords, name);
+  }
+  else {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nThreads; ++i) {
+      threads.emplace_back(&logRecords, nRecords, std::cref(name));
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+  LoggerFactory::getBackend()->flush();
+  return time::steady_clock::now() - start;
+}
+
+static void
+benchmarkDisabled(size_t nRecords)
+{
+  LoggerFactory::setSeverityLevel("LoggerBenchmark", LogLevel::INFO);
+  report("disabled statement", nRecords, measureLogging(nRecords, 1));
+}
+
+static void
+benchmarkSinks(size_t nRecords, const boost::filesystem::path& dir)
+{
+  LoggerFactory::setSeverityLevel("LoggerBenchmark", LogLevel::DEBUG);
+
+  LoggerFactory::setSink(make_shared<NullLogSink>());
+  report("enabled statement, null sink", nRecords, measureLogging(nRecords, 1));
+
+  std::ofstream os((dir / "stream.log").string());
+  LoggerFactory::setDestination(os);
+  report("enabled statement, ostream", nRecords, measureLogging(nRecords, 1));
+
+  // like std::clog, every output operation on an unbuffered stream is a system call
+  std::ofstream unbufferedOs;
+  unbufferedOs.rdbuf()->pubsetbuf(nullptr, 0);
+  unbufferedOs.open((dir / "unbuffered.log").string());
+  LoggerFactory::setDestination(unbufferedOs);
+  int64_t nSyscalls = getWriteSyscallCount();
+  report("enabled statement, unbuffered ostream", nRecords, measureLogging(nRecords, 1));
+  reportWriteSyscalls("enabled statement, unbuffered ostream", nRecords,
+                      nSyscalls < 0 ? -1 : getWriteSyscallCount() - nSyscalls);
+
+  util::MappedFileLogSink::Options options;
+  options.fileSize = 256 * 1024 * 1024;
+  LoggerFactory::setSink(make_shared<util::MappedFileLogSink>((dir / "mapped.log").string(),
+                                                              options));
+  report("enabled statement, memory-mapped file", nRecords, measureLogging(nRecords, 1));
+
+  LoggerFactory::setSink(make_shared<util::TlvLogSink>((dir / "structured.tlv").string()));
+  report("enabled statement, structured file", nRecords, measureLogging(nRecords, 1));
+
+  boost::filesystem::path compressedPath = dir / "compressed.log.gz";
+  LoggerFactory::setSink(make_shared<util::CompressedLogSink>(compressedPath.string()));
+  report("enabled statement, compressed file", nRecords, measureLogging(nRecords, 1));
+
+  // the sink finishes the gzip stream when it is replaced
+  LoggerFactory::setSink(make_shared<NullLogSink>());
+  std::cout << "compressed file: " << boost::filesystem::file_size(compressedPath)
+            << " bytes, text: " << boost::filesystem::file_size(dir / "stream.log")
+            << " bytes" << std::endl;
+}
+
+static void
+benchmarkContention(size_t nRecords, size_t maxThreads)
+{
+  LoggerFactory::setSeverityLevel("LoggerBenchmark", LogLevel::DEBUG);
+  LoggerFactory::setSink(make_shared<NullLogSink>());
+
+  for (size_t nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+    size_t nRecordsPerThread = nRecords / nThreads;
+    report("null sink, " + to_string(nThreads) + " threads", nRecordsPerThread * nThreads,
+           measureLogging(nRecordsPerThread, nThreads));
+  }
+}
+
+static void
+benchmarkSetSeverityLevels()
+{
+  static const size_t N_LOGGERS = 1000;
+  static const size_t N_CHANGES = 1000;
+
+  // a Logger cannot be unregistered from LoggerFactory, so these are never deleted
+  for (size_t i = 0; i < N_LOGGERS; ++i) {
+    new util::Logger("Benchmark.Group" + to_string(i % 10) + ".Module" + to_string(i));
+  }
+
+  time::steady_clock::TimePoint start = time::steady_clock::now();
+  for (size_t i = 0; i < N_CHANGES; ++i) {
+    LoggerFactory::setSeverityLevels(i % 2 == 0 ? "*=INFO:Benchmark.Group1.*=DEBUG:"
+                                                  "Benchmark.Group2.*=WARN:"
+                                                  "Benchmark.Group2.Module2=TRACE" :
+                                                  "*=DEBUG");
+  }
+  time::nanoseconds duration = time::steady_clock::now() - start;
+  printf("%-44s %10.1f us/change\n",
+         ("setSeverityLevels, " + to_string(N_LOGGERS) + " loggers").data(),
+         duration.count() / 1000.0 / N_CHANGES);
+
+  LoggerFactory::setSeverityLevels("*=NONE");
+}
+
+/** \brief measure Logger construction on \p nThreads threads, while the configuration changes
+ */
+static void
+benchmarkRegistration(size_t nThreads)
+{
+  static const size_t N_LOGGERS_PER_THREAD = 2000;
+
+  std::atomic<bool> isDone(false);
+  std::thread changer([&isDone] {
+    for (size_t i = 0; !isDone.load(); ++i) {
+      LoggerFactory::setSeverityLevels(i % 2 == 0 ? "Registration.*=DEBUG" :
+                                                    "Registration.*=INFO");
+    }
+  });
+
+  time::steady_clock::TimePoint start = time::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < nThreads; ++i) {
+    threads.emplace_back([i] {
+      // a Logger cannot be unregistered from LoggerFactory, so these are never deleted
+      for (size_t j = 0; j < N_LOGGERS_PER_THREAD; ++j) {
+        new util::Logger("Registration.Thread" + to_string(i) + ".Module" + to_string(j));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  time::nanoseconds duration = time::steady_clock::now() - start;
+
+  isDone.store(true);
+  changer.join();
+  printf("%-44s %10.1f ns/logger\n",
+         ("Logger construction, " + to_string(nThreads) + " threads").data(),
+         static_cast<double>(duration.count()) / (N_LOGGERS_PER_THREAD * nThreads));
+}
+
+static int
+usage(const char* programName)
+{
+  std::cerr << "Usage: " << programName << " [-n nRecords] [-t maxThreads] [-b boost|ring|queue]"
+            << std::endl;
+  return 2;
+}
+
+int
+main(int argc, char** argv)
+{
+  size_t nRecords = 1000000;
+  size_t maxThreads = std::max(4U, std::thread::hardware_concurrency());
+  std::string backend = "boost";
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:t:b:")) != -1) {
+    switch (opt) {
+    case 'n':
+      nRecords = std::max(1L, std::atol(optarg));
+      break;
+    case 't':
+      maxThreads = std::max(1L, std::atol(optarg));
+      break;
+    case 'b':
+      backend = optarg;
+      break;
+    default:
+      return usage(argv[0]);
+    }
+  }
+
+  if (backend == "ring") {
+    LoggerFactory::setBackend(make_shared<util::RingBufferLoggerBackend>());
+  }
+  else if (backend == "queue") {
+    util::BoundedQueueLoggerBackend::Options options;
+    options.overflowPolicy = util::BoundedQueueLoggerBackend::OverflowPolicy::BLOCK;
+    LoggerFactory::setBackend(make_shared<util::BoundedQueueLoggerBackend>(options));
+  }
+  else if (backend != "boost") {
+    return usage(argv[0]);
+  }
+
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+                                boost::filesystem::unique_path("logger-benchmark-%%%%%%%%");
+  boost::filesystem::create_directories(dir);
+
+  std::cout << "backend=" << backend << " nRecords=" << nRecords << std::endl;
+  benchmarkDisabled(nRecords * 10);
+  benchmarkSinks(nRecords, dir);
+  benchmarkContention(nRecords, maxThreads);
+  benchmarkSetSeverityLevels();
+  benchmarkRegistration(maxThreads);
+
+  // release the files before removing them
+  static std::ofstream nullOutputStream;
+  LoggerFactory::setDestination(nullOutputStream);
+  boost::filesystem::remove_all(dir);
+  return 0;
+}
+
+} // namespace tests_benchmarks_logger
+} // namespace ndn
+
+int
+main(int argc, char** argv)
+{
+  return ndn::tests_benchmarks_logger::main(argc, argv);
+}
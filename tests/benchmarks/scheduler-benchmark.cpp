@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+/** \file
+ *  \brief compares the engines of util::Scheduler with many outstanding events
+ *
+ *  Usage: scheduler-benchmark [-n nEvents] [-d maxDelayMs]
+ */
+
+#include "util/scheduler.hpp"
+#include "util/time-unit-test-clock.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <unistd.h>
+
+namespace ndn {
+namespace tests_benchmarks_scheduler {
+
+using util::Scheduler;
+using util::scheduler::EventId;
+
+/** \brief measures wall-clock time, because time::steady_clock is replaced by a unit test clock
+ */
+class Stopwatch
+{
+public:
+  Stopwatch()
+    : m_start(std::chrono::steady_clock::now())
+  {
+  }
+
+  double
+  getNanoseconds() const
+  {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() -
+                                                    m_start).count();
+  }
+
+private:
+  std::chrono::steady_clock::time_point m_start;
+};
+
+static void
+report(const std::string& title, size_t nEvents, double nanoseconds)
+{
+  double nsPerEvent = nanoseconds / nEvents;
+  printf("%-44s %10.1f ns/event %14.0f events/s\n",
+         title.data(), nsPerEvent, 1e9 / nsPerEvent);
+}
+
+/** \brief schedules \p nEvents events, replaces each of them once, cancels half of them, and
+ *         fires the rest, with \p nEvents events outstanding at the start
+ */
+static void
+benchmarkEngine(const std::string& engineName, Scheduler::Engine engine,
+                size_t nEvents, time::milliseconds maxDelay)
+{
+  auto steadyClock = make_shared<time::UnitTestSteadyClock>();
+  time::setCustomClocks(steadyClock, make_shared<time::UnitTestSystemClock>());
+
+  boost::asio::io_service io;
+  Scheduler scheduler(io, engine);
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<time::microseconds::rep> delayDist(1000,
+    time::duration_cast<time::microseconds>(maxDelay).count());
+  size_t nFired = 0;
+  auto event = [&nFired] { ++nFired; };
+
+  std::vector<time::microseconds> delays(nEvents);
+  for (auto& delay : delays) {
+    delay = time::microseconds(delayDist(gen));
+  }
+  std::vector<size_t> order(nEvents);
+  for (size_t i = 0; i < nEvents; ++i) {
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), gen);
+
+  std::vector<EventId> ids(nEvents);
+  Stopwatch scheduling;
+  for (size_t i = 0; i < nEvents; ++i) {
+    ids[i] = scheduler.scheduleEvent(delays[i], event);
+  }
+  report(engineName + " schedule", nEvents, scheduling.getNanoseconds());
+
+  // like an Interest that is satisfied, and followed by the next one
+  Stopwatch replacing;
+  for (size_t i : order) {
+    scheduler.cancelEvent(ids[i]);
+    ids[i] = scheduler.scheduleEvent(delays[nEvents - 1 - i], event);
+  }
+  report(engineName + " cancel + schedule", nEvents, replacing.getNanoseconds());
+
+  Stopwatch cancelling;
+  for (size_t i = 0; i < nEvents / 2; ++i) {
+    scheduler.cancelEvent(ids[order[i]]);
+  }
+  report(engineName + " cancel", nEvents / 2, cancelling.getNanoseconds());
+
+  // few polls, so that the cost of the io_service does not hide the cost of the engine
+  Stopwatch firing;
+  for (time::milliseconds t(0); t <= maxDelay; t += time::milliseconds(100)) {
+    steadyClock->advance(time::milliseconds(100));
+    io.poll();
+  }
+  report(engineName + " fire", nEvents - nEvents / 2, firing.getNanoseconds());
+
+  if (nFired != nEvents - nEvents / 2) {
+    std::cerr << engineName << ": " << nFired << " events fired, expected "
+              << nEvents - nEvents / 2 << std::endl;
+  }
+  time::setCustomClocks(nullptr, nullptr);
+}
+
+static int
+usage(const char* programName)
+{
+  std::cerr << "Usage: " << programName << " [-n nEvents] [-d maxDelayMs]" << std::endl;
+  return 2;
+}
+
+int
+main(int argc, char** argv)
+{
+  size_t nEvents = 1000000;
+  time::milliseconds maxDelay(4000);
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:d:")) != -1) {
+    switch (opt) {
+    case 'n':
+      nEvents = std::max(2L, std::atol(optarg));
+      break;
+    case 'd':
+      maxDelay = time::milliseconds(std::max(2L, std::atol(optarg)));
+      break;
+    default:
+      return usage(argv[0]);
+    }
+  }
+
+  printf("%zu outstanding events, delays up to %lld ms\n",
+         nEvents, static_cast<long long>(maxDelay.count()));
+  benchmarkEngine("multiset", Scheduler::Engine::MULTISET, nEvents, maxDelay);
+  benchmarkEngine("timing wheel", Scheduler::Engine::TIMING_WHEEL, nEvents, maxDelay);
+  return 0;
+}
+
+} // namespace tests_benchmarks_scheduler
+} // namespace ndn
+
+int
+main(int argc, char** argv)
+{
+  return ndn::tests_benchmarks_scheduler::main(argc, argv);
+}
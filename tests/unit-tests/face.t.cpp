@@ -23,6 +23,8 @@
 #include "util/scheduler.hpp"
 #include "security/key-chain.hpp"
 #include "util/dummy-client-face.hpp"
+#include "util/interest-latency-tracker.hpp"
+#include "util/packet-capture.hpp"
 #include "transport/tcp-transport.hpp"
 
 #include "boost-test.hpp"
@@ -170,6 +172,26 @@ BOOST_AUTO_TEST_CASE(ExpressInterestTimeout)
   BOOST_CHECK_EQUAL(face.sentNacks.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(InterestLifetimeAccuracy)
+{
+  BOOST_CHECK_THROW(face.setInterestLifetimeAccuracy(time::nanoseconds::zero()),
+                    std::invalid_argument);
+  face.setInterestLifetimeAccuracy(time::milliseconds(100));
+  advanceClocks(time::milliseconds(1));
+
+  size_t nTimeouts = 0;
+  face.expressInterest(Interest("/Hello/World", time::milliseconds(50)), nullptr, nullptr,
+                       bind([&nTimeouts] { ++nTimeouts; }));
+  advanceClocks(time::milliseconds(1), 60);
+  BOOST_CHECK_EQUAL(nTimeouts, 0);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 1);
+
+  // the Interest times out at the end of the 100ms tick that contains its expiry
+  advanceClocks(time::milliseconds(1), 40);
+  BOOST_CHECK_EQUAL(nTimeouts, 1);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
 // test case for deprecated expressInterest implementation
 BOOST_AUTO_TEST_CASE(DeprecatedExpressInterestTimeout)
 {
@@ -224,6 +246,112 @@ BOOST_AUTO_TEST_CASE(ExpressInterestNack)
   BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(SatisfyMultiplePendingInterests)
+{
+  shared_ptr<Data> data = util::makeData("/A/B/C/D");
+  std::vector<std::string> satisfied;
+  auto expressInterest = [&] (const Name& name) {
+    face.expressInterest(Interest(name, time::milliseconds(50)),
+                         [&satisfied, name] (const Interest&, const Data&) {
+                           satisfied.push_back(name.toUri());
+                         },
+                         nullptr, nullptr);
+  };
+
+  expressInterest("/A/B/C");
+  expressInterest("/X");
+  expressInterest("/A");
+  expressInterest("/A/B/C/D/E");
+  expressInterest(data->getFullName());
+  expressInterest("/A/B/C/D/F");
+  expressInterest("/A/B");
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 7);
+
+  // every matching Interest is satisfied, in the order expressed
+  face.receive(*data);
+  advanceClocks(time::milliseconds(1), 10);
+  std::vector<std::string> expected{"/A/B/C", "/A", data->getFullName().toUri(), "/A/B"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(satisfied.begin(), satisfied.end(),
+                                expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 3);
+
+  face.receive(*util::makeData("/A/B/C/D/E"));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(satisfied.back(), "/A/B/C/D/E");
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 2);
+
+  // components are compared by value, regardless of their type
+  std::vector<uint8_t> digest(32, 0x01);
+  Name digestName = Name("/D").append(name::Component::fromImplicitSha256Digest(digest.data(),
+                                                                                digest.size()));
+  digestName.append("E");
+  Name genericName = Name("/D").append(digest.data(), digest.size()).append("E");
+  BOOST_REQUIRE(digestName.isPrefixOf(genericName));
+  expressInterest(digestName);
+  advanceClocks(time::milliseconds(1), 10);
+  face.receive(*util::makeData(Name(genericName).append("F")));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(satisfied.back(), digestName.toUri());
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ExpressInterestFromCallback)
+{
+  // An Interest expressed by a callback is satisfied or nacked by the same packet if it matches,
+  // as in a scan of the whole table.  Packets are received on the io_service thread, where
+  // expressInterest inserts the Interest right away.
+  size_t nData = 0;
+  std::function<void(const Interest&, const Data&)> onData = [&] (const Interest&, const Data&) {
+    if (++nData == 1) {
+      face.expressInterest(Interest("/A", time::milliseconds(50)), onData, nullptr, nullptr);
+      face.expressInterest(Interest("/B", time::milliseconds(50)), onData, nullptr, nullptr);
+    }
+  };
+  face.expressInterest(Interest("/A", time::milliseconds(50)), onData, nullptr, nullptr);
+  advanceClocks(time::milliseconds(1), 10);
+
+  io.post([this] { face.receive(*util::makeData("/A/1")); });
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(nData, 2);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 1);
+
+  size_t nNacks = 0;
+  std::function<void(const Interest&, const lp::Nack&)> onNack =
+    [&] (const Interest& interest, const lp::Nack&) {
+      if (++nNacks == 1) {
+        face.expressInterest(interest, nullptr, onNack, nullptr);
+      }
+    };
+  face.expressInterest(Interest("/C").setNonce(3), nullptr, onNack, nullptr);
+  advanceClocks(time::milliseconds(1), 10);
+
+  io.post([this] { face.receive(lp::Nack(face.sentInterests.back())); });
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(nNacks, 2);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ExpressInterestNackNonce)
+{
+  std::vector<uint32_t> nackedNonces;
+  auto onNack = [&] (const Interest& interest, const lp::Nack&) {
+    nackedNonces.push_back(interest.getNonce());
+  };
+
+  face.expressInterest(Interest("/Hello/World").setNonce(1), nullptr, onNack, nullptr);
+  face.expressInterest(Interest("/Hello/World").setNonce(2), nullptr, onNack, nullptr);
+  advanceClocks(time::milliseconds(1), 10);
+
+  // only the Interest with the same Nonce is nacked
+  face.receive(lp::Nack(face.sentInterests.at(1)));
+  face.receive(lp::Nack(Interest("/Bye/World").setNonce(1)));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_REQUIRE_EQUAL(nackedNonces.size(), 1);
+  BOOST_CHECK_EQUAL(nackedNonces[0], 2);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(RemovePendingInterest)
 {
   const PendingInterestId* interestId =
@@ -505,6 +633,46 @@ BOOST_AUTO_TEST_CASE(SetRegexFilter)
   BOOST_CHECK_EQUAL(nInInterests, 2);
 }
 
+BOOST_AUTO_TEST_CASE(FilterDispatchOrder)
+{
+  std::vector<std::string> matched;
+  auto setInterestFilter = [&] (const InterestFilter& filter, const std::string& label) {
+    return face.setInterestFilter(filter,
+                                  [&matched, label] (const InterestFilter&, const Interest&) {
+                                    matched.push_back(label);
+                                  });
+  };
+
+  setInterestFilter("/A/B", "/A/B");
+  setInterestFilter(InterestFilter("/A", "<B><>"), "/A<B><>");
+  const InterestFilterId* filterId = setInterestFilter("/A/B/C", "/A/B/C");
+  setInterestFilter("/X", "/X");
+  setInterestFilter("/", "/");
+  setInterestFilter(InterestFilter("/A/B", "<D>"), "/A/B<D>");
+  setInterestFilter("/A/B/C/D", "/A/B/C/D");
+  setInterestFilter("/A", "/A");
+  advanceClocks(time::milliseconds(10), 10);
+
+  // matching filters are invoked in the order they were set
+  face.receive(Interest("/A/B/C"));
+  std::vector<std::string> expected{"/A/B", "/A<B><>", "/A/B/C", "/", "/A"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(matched.begin(), matched.end(), expected.begin(), expected.end());
+
+  matched.clear();
+  face.unsetInterestFilter(filterId);
+  advanceClocks(time::milliseconds(10), 10);
+  face.receive(Interest("/A/B/C/D"));
+  expected = {"/A/B", "/", "/A/B/C/D", "/A"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(matched.begin(), matched.end(), expected.begin(), expected.end());
+
+  matched.clear();
+  face.unsetInterestFilter(filterId); // already unset
+  advanceClocks(time::milliseconds(10), 10);
+  face.receive(Interest("/A/B/D"));
+  expected = {"/A/B", "/A<B><>", "/", "/A/B<D>", "/A"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(matched.begin(), matched.end(), expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_CASE(SetRegexFilterAndRegister)
 {
   size_t nInInterests = 0;
@@ -596,6 +764,90 @@ BOOST_AUTO_TEST_CASE(DestructionWithoutCancellingPendingInterests) // Bug #2518
   // should not segfault
 }
 
+BOOST_AUTO_TEST_CASE(CapturePackets)
+{
+  std::ostringstream os;
+  util::PacketCapture::Options options;
+  options.prefixes = {"/A"};
+  auto capture = make_shared<util::PacketCapture>(os, options);
+  face.setPacketCapture(capture);
+  advanceClocks(time::milliseconds(10));
+
+  face.expressInterest(Interest("/A/1"), bind([]{}), bind([]{}), bind([]{}));
+  face.expressInterest(Interest("/B/1"), bind([]{}), bind([]{}), bind([]{}));
+  advanceClocks(time::milliseconds(10));
+  face.receive(*util::makeData("/A/1"));
+  face.receive(*util::makeData("/B/1"));
+  advanceClocks(time::milliseconds(10));
+  face.put(*util::makeData("/A/2"));
+  advanceClocks(time::milliseconds(10));
+
+  face.setPacketCapture(nullptr);
+  face.put(*util::makeData("/A/3"));
+  advanceClocks(time::milliseconds(10));
+
+  capture->flush();
+  util::PacketCapture::Statistics st = capture->getStatistics();
+  BOOST_CHECK_EQUAL(st.nCaptured, 3);
+  BOOST_CHECK_EQUAL(st.nWritten, 3);
+}
+
+BOOST_AUTO_TEST_CASE(TrackInterestLatency)
+{
+  auto tracker = make_shared<util::InterestLatencyTracker>(std::vector<Name>{"/A", "/A/B"});
+  face.setInterestLatencyTracker(tracker);
+  advanceClocks(time::milliseconds(1));
+
+  face.expressInterest(Interest("/A/1", time::milliseconds(1000)),
+                       bind([]{}), bind([]{}), bind([]{}));
+  face.expressInterest(Interest("/A/B/1", time::milliseconds(1000)),
+                       bind([]{}), bind([]{}), bind([]{}));
+  face.expressInterest(Interest("/A/2", time::milliseconds(50)),
+                       bind([]{}), bind([]{}), bind([]{}));
+  face.expressInterest(Interest("/A/4", time::milliseconds(1000)),
+                       bind([]{}), bind([]{}), bind([]{}));
+  face.expressInterest(Interest("/C/1", time::milliseconds(1000)),
+                       bind([]{}), bind([]{}), bind([]{}));
+  advanceClocks(time::milliseconds(1)); // the Interests are expressed in this tick
+
+  advanceClocks(time::milliseconds(1), 20);
+  face.receive(*util::makeData("/A/1"));
+  face.receive(*util::makeData("/C/1"));
+  advanceClocks(time::milliseconds(1), 10);
+  lp::Nack nack(face.sentInterests.at(1));
+  nack.setReason(lp::NackReason::CONGESTION);
+  face.receive(nack);
+  face.receive(*util::makeData("/A/4"));
+  advanceClocks(time::milliseconds(1), 100);
+
+  const util::InterestLatencyTracker::PrefixStatistics* a = tracker->getStatistics("/A");
+  BOOST_REQUIRE(a != nullptr);
+  BOOST_CHECK_EQUAL(a->rtt.getCount(), 2);
+  BOOST_CHECK_EQUAL(a->rtt.getMax().count(), 30000);
+  // upper bound of the bucket of 20000us, which spans 1024us
+  BOOST_CHECK_EQUAL(a->rtt.getPercentile(50).count(), 20479);
+  BOOST_CHECK_EQUAL(a->nack.getCount(), 0);
+  BOOST_CHECK_EQUAL(a->timeout.getCount(), 1);
+  BOOST_CHECK_GE(a->timeout.getMax(), time::milliseconds(50));
+
+  const util::InterestLatencyTracker::PrefixStatistics* ab = tracker->getStatistics("/A/B");
+  BOOST_REQUIRE(ab != nullptr);
+  BOOST_CHECK_EQUAL(ab->rtt.getCount(), 0);
+  BOOST_CHECK_EQUAL(ab->nack.getCount(), 1);
+  BOOST_CHECK_EQUAL(ab->nack.getMax().count(), 30000);
+  BOOST_CHECK_EQUAL(ab->timeout.getCount(), 0);
+
+  // after the tracker is removed, completed Interests are no longer recorded
+  face.setInterestLatencyTracker(nullptr);
+  advanceClocks(time::milliseconds(1));
+  face.expressInterest(Interest("/A/3", time::milliseconds(1000)),
+                       bind([]{}), bind([]{}), bind([]{}));
+  advanceClocks(time::milliseconds(1), 10);
+  face.receive(*util::makeData("/A/3"));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(a->rtt.getCount(), 2);
+}
+
 BOOST_AUTO_TEST_CASE(FaceTransport)
 {
   KeyChain keyChain;
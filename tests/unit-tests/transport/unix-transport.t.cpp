@@ -21,9 +21,14 @@
 
 #include "transport/unix-transport.hpp"
 #include "transport-fixture.hpp"
+#include "encoding/block-helpers.hpp"
 
 #include "boost-test.hpp"
 
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/filesystem.hpp>
+
 namespace ndn {
 namespace tests {
 
@@ -77,6 +82,71 @@ BOOST_AUTO_TEST_CASE(GetDefaultSocketNameBadMalformedUri)
                         });
 }
 
+BOOST_AUTO_TEST_CASE(ReceiveWithoutCopy)
+{
+  boost::filesystem::path dir(UNIT_TEST_CONFIG_PATH);
+  boost::filesystem::create_directories(dir);
+  std::string socketPath = (dir / "unix-transport.sock").string();
+  boost::filesystem::remove(socketPath);
+
+  boost::asio::io_service io;
+  boost::asio::local::stream_protocol::acceptor acceptor(io,
+    boost::asio::local::stream_protocol::endpoint(socketPath));
+  boost::asio::local::stream_protocol::socket forwarder(io);
+
+  std::vector<Block> received;
+  UnixTransport transport(socketPath);
+  transport.connect(io, [&received] (const Block& block) { received.push_back(block); });
+  acceptor.accept(forwarder);
+
+  auto receive = [&] (size_t nTotal) {
+    while (received.size() < nTotal && io.run_one() > 0) {
+    }
+    BOOST_REQUIRE_EQUAL(received.size(), nTotal);
+  };
+
+  // large and small packets alternate
+  std::vector<Block> packets;
+  for (int i = 0; i < 4; ++i) {
+    size_t length = i % 2 == 0 ? 5000 + i : 300 + i;
+    packets.push_back(makeStringBlock(100 + i, std::string(length, 'a' + i)));
+  }
+
+  // first two packets and the beginning of the third one
+  Buffer firstWrite;
+  firstWrite.insert(firstWrite.end(), packets[0].begin(), packets[0].end());
+  firstWrite.insert(firstWrite.end(), packets[1].begin(), packets[1].end());
+  firstWrite.insert(firstWrite.end(), packets[2].begin(), packets[2].begin() + 100);
+  boost::asio::write(forwarder, boost::asio::buffer(firstWrite.buf(), firstWrite.size()));
+  receive(2);
+
+  BOOST_CHECK(received[0] == packets[0]);
+  BOOST_CHECK(received[1] == packets[1]);
+  // the large packet refers to the receive buffer, and the small one is copied
+  BOOST_CHECK_EQUAL(received[0].getBuffer()->size(), MAX_NDN_PACKET_SIZE);
+  BOOST_CHECK_EQUAL(received[1].getBuffer()->size(), received[1].size());
+
+  // rest of the third packet and the fourth one
+  Buffer secondWrite;
+  secondWrite.insert(secondWrite.end(), packets[2].begin() + 100, packets[2].end());
+  secondWrite.insert(secondWrite.end(), packets[3].begin(), packets[3].end());
+  boost::asio::write(forwarder, boost::asio::buffer(secondWrite.buf(), secondWrite.size()));
+  receive(4);
+
+  BOOST_CHECK(received[2] == packets[2]);
+  BOOST_CHECK(received[3] == packets[3]);
+  // the retained large packet holds the first buffer, so the transport continued in another one
+  BOOST_CHECK_EQUAL(received[2].getBuffer()->size(), MAX_NDN_PACKET_SIZE);
+  BOOST_CHECK(received[2].getBuffer() != received[0].getBuffer());
+  BOOST_CHECK_EQUAL(received[3].getBuffer()->size(), received[3].size());
+  // the retained Blocks are not overwritten by later receives
+  BOOST_CHECK(received[0] == packets[0]);
+  BOOST_CHECK(received[1] == packets[1]);
+
+  transport.close();
+  boost::filesystem::remove(socketPath);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/interest-latency-tracker.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_SUITE(UtilInterestLatencyTracker)
+
+BOOST_AUTO_TEST_CASE(LongestPrefixMatch)
+{
+  InterestLatencyTracker tracker({"/A", "/A/B", "/C", "/A"});
+  BOOST_CHECK_EQUAL(tracker.getPrefixes().size(), 3);
+  BOOST_CHECK(tracker.getStatistics("/D") == nullptr);
+
+  tracker.recordData("/A/B/1", time::milliseconds(10));
+  tracker.recordData("/A/X", time::milliseconds(20));
+  tracker.recordNack("/A/B", time::milliseconds(30));
+  tracker.recordTimeout("/C/1/2", time::seconds(4));
+  tracker.recordData("/D/1", time::milliseconds(50)); // untracked
+
+  const InterestLatencyTracker::PrefixStatistics* ab = tracker.getStatistics("/A/B");
+  BOOST_REQUIRE(ab != nullptr);
+  BOOST_CHECK_EQUAL(ab->rtt.getCount(), 1);
+  BOOST_CHECK_EQUAL(ab->rtt.getMax(), time::milliseconds(10));
+  BOOST_CHECK_EQUAL(ab->nack.getCount(), 1);
+  BOOST_CHECK_EQUAL(ab->timeout.getCount(), 0);
+
+  const InterestLatencyTracker::PrefixStatistics* a = tracker.getStatistics("/A");
+  BOOST_REQUIRE(a != nullptr);
+  BOOST_CHECK_EQUAL(a->rtt.getCount(), 1);
+  BOOST_CHECK_EQUAL(a->rtt.getMax(), time::milliseconds(20));
+
+  const InterestLatencyTracker::PrefixStatistics* c = tracker.getStatistics("/C");
+  BOOST_REQUIRE(c != nullptr);
+  BOOST_CHECK_EQUAL(c->timeout.getCount(), 1);
+  BOOST_CHECK_EQUAL(c->rtt.getCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RootPrefix)
+{
+  InterestLatencyTracker tracker({"/", "/A"});
+  tracker.recordData("/B", time::milliseconds(1));
+  tracker.recordData("/A/B", time::milliseconds(1));
+  BOOST_CHECK_EQUAL(tracker.getStatistics("/")->rtt.getCount(), 1);
+  BOOST_CHECK_EQUAL(tracker.getStatistics("/A")->rtt.getCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(PrintSummary)
+{
+  InterestLatencyTracker tracker({"/B", "/A"});
+  tracker.recordData("/A/1", time::microseconds(5));
+
+  std::ostringstream os;
+  tracker.printSummary(os);
+  BOOST_CHECK_EQUAL(os.str(),
+    "/A rtt(count=1 mean=5us p50=5us p90=5us p99=5us max=5us)"
+    " nack(count=0 mean=0us p50=0us p90=0us p99=0us max=0us)"
+    " timeout(count=0 mean=0us p50=0us p90=0us p99=0us max=0us)\n"
+    "/B rtt(count=0 mean=0us p50=0us p90=0us p99=0us max=0us)"
+    " nack(count=0 mean=0us p50=0us p90=0us p99=0us max=0us)"
+    " timeout(count=0 mean=0us p50=0us p90=0us p99=0us max=0us)\n");
+}
+
+BOOST_FIXTURE_TEST_CASE(LogSummary, UnitTestTimeFixture)
+{
+  InterestLatencyTracker tracker({"/A"});
+  BOOST_CHECK_NO_THROW(tracker.enableLogSummary(io, time::seconds(1)));
+  BOOST_CHECK_NO_THROW(advanceClocks(time::milliseconds(500), 5));
+  tracker.disableLogSummary();
+  BOOST_CHECK_NO_THROW(advanceClocks(time::milliseconds(500), 5));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilInterestLatencyTracker
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
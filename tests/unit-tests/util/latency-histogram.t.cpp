@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/latency-histogram.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(UtilLatencyHistogram)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  LatencyHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMean(), time::microseconds::zero());
+  BOOST_CHECK_EQUAL(histogram.getMax(), time::microseconds::zero());
+  BOOST_CHECK_EQUAL(histogram.getPercentile(50), time::microseconds::zero());
+}
+
+BOOST_AUTO_TEST_CASE(SmallLatencies)
+{
+  LatencyHistogram histogram;
+  for (int i = 1; i <= 10; ++i) {
+    histogram.record(time::microseconds(i));
+  }
+  // latencies below 32us are recorded exactly
+  BOOST_CHECK_EQUAL(histogram.getCount(), 10);
+  BOOST_CHECK_EQUAL(histogram.getMean(), time::microseconds(5));
+  BOOST_CHECK_EQUAL(histogram.getMax(), time::microseconds(10));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(0), time::microseconds(1));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(50), time::microseconds(5));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(90), time::microseconds(9));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(100), time::microseconds(10));
+
+  // sub-microsecond latencies are truncated
+  histogram.record(time::nanoseconds(999));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(0), time::microseconds(0));
+}
+
+BOOST_AUTO_TEST_CASE(Precision)
+{
+  for (uint64_t us : {32, 100, 1000, 12345, 999999, 60000000}) {
+    LatencyHistogram histogram;
+    histogram.record(time::microseconds(us));
+    histogram.record(time::microseconds(us * 2));
+    BOOST_TEST_MESSAGE("latency " << us << "us");
+
+    // the reported percentile is the bucket upper bound, within 1/16 of the recorded value
+    time::microseconds p50 = histogram.getPercentile(50);
+    BOOST_CHECK_GE(p50.count(), us);
+    BOOST_CHECK_LE(p50.count(), us + us / 16);
+    BOOST_CHECK_EQUAL(histogram.getPercentile(100), time::microseconds(us * 2));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Overflow)
+{
+  LatencyHistogram histogram;
+  histogram.record(time::hours(24 * 365 * 10));
+  BOOST_CHECK_EQUAL(histogram.getCount(), 1);
+  BOOST_CHECK_EQUAL(histogram.getPercentile(50), histogram.getMax());
+}
+
+BOOST_AUTO_TEST_CASE(Reset)
+{
+  LatencyHistogram histogram;
+  histogram.record(time::milliseconds(5));
+  histogram.reset();
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMax(), time::microseconds::zero());
+  BOOST_CHECK_EQUAL(histogram.getPercentile(99), time::microseconds::zero());
+
+  histogram.record(time::microseconds(7));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(99), time::microseconds(7));
+}
+
+BOOST_AUTO_TEST_CASE(Print)
+{
+  LatencyHistogram histogram;
+  histogram.record(time::microseconds(4));
+  histogram.record(time::microseconds(8));
+  std::ostringstream os;
+  os << histogram;
+  BOOST_CHECK_EQUAL(os.str(), "count=2 mean=6us p50=4us p90=8us p99=8us max=8us");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLatencyHistogram
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger-backend.hpp"
+
+#include "boost-test.hpp"
+#include "test-call-site.hpp"
+
+#include <numeric>
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_CXX_LOG_INIT(BoostBackendTest);
+
+/** \brief a LogSink that counts the records written between flushes
+ */
+class BatchCountingSink : public LogSink
+{
+public:
+  void
+  write(const LogRecord&) NDN_CXX_DECL_OVERRIDE
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_nUnflushed;
+  }
+
+  void
+  flush() NDN_CXX_DECL_OVERRIDE
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_nUnflushed > 0) {
+      m_batches.push_back(m_nUnflushed);
+      m_nUnflushed = 0;
+    }
+  }
+
+  /** \return sizes of flushed batches
+   */
+  std::vector<size_t>
+  getBatches() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_batches;
+  }
+
+  /** \return number of flushed records
+   */
+  size_t
+  getNFlushed() const
+  {
+    std::vector<size_t> batches = this->getBatches();
+    return std::accumulate(batches.begin(), batches.end(), size_t(0));
+  }
+
+  /** \brief wait up to one second until \p nRecords records have been flushed
+   *  \return whether they have been flushed
+   */
+  bool
+  waitUntilFlushed(size_t nRecords) const
+  {
+    for (int i = 0; i < 100 && this->getNFlushed() < nRecords; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return this->getNFlushed() >= nRecords;
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  size_t m_nUnflushed = 0;
+  std::vector<size_t> m_batches;
+};
+
+static void
+logRecords(BoostLoggerBackend& backend, int nRecords)
+{
+  for (int i = 0; i < nRecords; ++i) {
+    LogRecord record(getTestCallSite<getNdnCxxLogger>());
+    record << "record" << i;
+    backend.log(std::move(record));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(UtilBoostLoggerBackend)
+
+BOOST_AUTO_TEST_CASE(MaxBatchSize)
+{
+  auto sink = make_shared<BatchCountingSink>();
+  BoostLoggerBackend::Options options;
+  options.maxBatchSize = 4;
+  options.maxDelay = time::seconds(3600);
+  BoostLoggerBackend backend(options);
+  backend.setSink(sink);
+
+  logRecords(backend, 10);
+  backend.flush();
+
+  // however the flusher thread splits the queue, the sink is flushed every 4 records
+  std::vector<size_t> batches = sink->getBatches();
+  BOOST_CHECK_EQUAL(sink->getNFlushed(), 10);
+  BOOST_CHECK_GE(batches.size(), 3);
+  for (size_t batch : batches) {
+    BOOST_CHECK_LE(batch, options.maxBatchSize);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MaxDelay)
+{
+  auto sink = make_shared<BatchCountingSink>();
+  BoostLoggerBackend::Options options;
+  options.maxDelay = time::milliseconds(10);
+  BoostLoggerBackend backend(options);
+  backend.setSink(sink);
+
+  // a lone record is flushed by the flusher thread, without an explicit flush
+  logRecords(backend, 1);
+  BOOST_CHECK(sink->waitUntilFlushed(1));
+
+  // after a period without records, the idle flusher thread wakes up for the next one
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  logRecords(backend, 1);
+  BOOST_CHECK(sink->waitUntilFlushed(2));
+  BOOST_CHECK_EQUAL(sink->getNFlushed(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(DrainOnDestruction)
+{
+  auto sink = make_shared<BatchCountingSink>();
+  {
+    BoostLoggerBackend::Options options;
+    options.maxDelay = time::seconds(3600);
+    BoostLoggerBackend backend(options);
+    backend.setSink(sink);
+
+    // the flusher thread writes at most the records queued when it wakes up, then sleeps
+    logRecords(backend, 100);
+  }
+  BOOST_CHECK_EQUAL(sink->getNFlushed(), 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilBoostLoggerBackend
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
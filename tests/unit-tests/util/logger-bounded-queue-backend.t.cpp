@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger-bounded-queue-backend.hpp"
+
+#include "boost-test.hpp"
+#include "test-call-site.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_CXX_LOG_INIT(BoundedQueueTest);
+
+/** \brief a LogSink that holds the writer thread in write() until opened
+ */
+class GatedSink : public LogSink
+{
+public:
+  void
+  write(const LogRecord& record) NDN_CXX_DECL_OVERRIDE
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isWriting = true;
+    m_cv.notify_all();
+    m_cv.wait(lock, [this] { return m_isOpen; });
+    messages.push_back(record.getMessage());
+  }
+
+  void
+  flush() NDN_CXX_DECL_OVERRIDE
+  {
+  }
+
+  void
+  waitUntilWriting()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_isWriting; });
+  }
+
+  void
+  open()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isOpen = true;
+    m_cv.notify_all();
+  }
+
+public:
+  std::vector<std::string> messages;
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_isWriting = false;
+  bool m_isOpen = false;
+};
+
+class BoundedQueueFixture
+{
+public:
+  BoundedQueueFixture()
+    : sink(make_shared<GatedSink>())
+  {
+  }
+
+  /** \brief create a backend of capacity 4, and fill its queue while the writer is held
+   *
+   *  Record "0" is held by the writer thread, and records "1" to "4" are queued.
+   */
+  unique_ptr<BoundedQueueLoggerBackend>
+  makeFullBackend(BoundedQueueLoggerBackend::OverflowPolicy policy)
+  {
+    BoundedQueueLoggerBackend::Options options;
+    options.capacity = 4;
+    options.overflowPolicy = policy;
+    auto backend = make_unique<BoundedQueueLoggerBackend>(options);
+    backend->setSink(sink);
+
+    log(*backend, "0");
+    sink->waitUntilWriting();
+    for (int i = 1; i <= 4; ++i) {
+      log(*backend, to_string(i));
+    }
+    return backend;
+  }
+
+  static void
+  log(LoggerBackend& backend, const std::string& message, LogLevel level = LogLevel::DEBUG)
+  {
+    LogRecord record(getTestCallSite<getNdnCxxLogger>(level));
+    record << message;
+    backend.log(std::move(record));
+  }
+
+protected:
+  shared_ptr<GatedSink> sink;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilLoggerBoundedQueueBackend, BoundedQueueFixture)
+
+BOOST_AUTO_TEST_CASE(DropNewest)
+{
+  auto backend = makeFullBackend(BoundedQueueLoggerBackend::OverflowPolicy::DROP_NEWEST);
+  log(*backend, "5");
+  log(*backend, "6");
+
+  BoundedQueueLoggerBackend::Statistics st = backend->getStatistics();
+  BOOST_CHECK_EQUAL(st.nEnqueued, 5);
+  BOOST_CHECK_EQUAL(st.nDropped, 2);
+  BOOST_CHECK_EQUAL(st.nWritten, 0);
+  BOOST_CHECK_EQUAL(st.highWatermark, 4);
+  BOOST_REQUIRE_EQUAL(st.modules.size(), 1);
+  const auto& module = st.modules["BoundedQueueTest"];
+  BOOST_CHECK_EQUAL(module.nEnqueued, 5);
+  BOOST_CHECK_EQUAL(module.nDropped, 2);
+  BOOST_CHECK_EQUAL(module.highWatermark, 4);
+
+  sink->open();
+  backend->flush();
+  BOOST_CHECK_EQUAL(backend->getStatistics().nWritten, 5);
+  std::vector<std::string> expected{"0", "1", "2", "3", "4"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(sink->messages.begin(), sink->messages.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(DropOldest)
+{
+  auto backend = makeFullBackend(BoundedQueueLoggerBackend::OverflowPolicy::DROP_OLDEST);
+  log(*backend, "5");
+  log(*backend, "6");
+
+  BoundedQueueLoggerBackend::Statistics st = backend->getStatistics();
+  BOOST_CHECK_EQUAL(st.nEnqueued, 7);
+  BOOST_CHECK_EQUAL(st.nDropped, 2);
+  BOOST_CHECK_EQUAL(st.modules["BoundedQueueTest"].nDropped, 2);
+
+  sink->open();
+  backend->flush();
+  std::vector<std::string> expected{"0", "3", "4", "5", "6"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(sink->messages.begin(), sink->messages.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(DropBelowLevel)
+{
+  auto backend = makeFullBackend(BoundedQueueLoggerBackend::OverflowPolicy::DROP_BELOW_LEVEL);
+  log(*backend, "5");
+  BOOST_CHECK_EQUAL(backend->getStatistics().nDropped, 1);
+
+  // an ERROR record waits for space
+  std::thread logger([&backend] { log(*backend, "error", LogLevel::ERROR); });
+  sink->open();
+  logger.join();
+  backend->flush();
+
+  BOOST_CHECK_EQUAL(backend->getStatistics().nDropped, 1);
+  std::vector<std::string> expected{"0", "1", "2", "3", "4", "error"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(sink->messages.begin(), sink->messages.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Block)
+{
+  auto backend = makeFullBackend(BoundedQueueLoggerBackend::OverflowPolicy::BLOCK);
+
+  std::thread logger([&backend] {
+    log(*backend, "5");
+    log(*backend, "6");
+  });
+  sink->open();
+  logger.join();
+  backend.reset(); // writes remaining records
+
+  std::vector<std::string> expected{"0", "1", "2", "3", "4", "5", "6"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(sink->messages.begin(), sink->messages.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLoggerBoundedQueueBackend
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger-compressed-sink.hpp"
+
+#include "boost-test.hpp"
+#include "test-call-site.hpp"
+
+#include <thread>
+#include <boost/filesystem.hpp>
+#include <zlib.h>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_CXX_LOG_INIT(CompressedSinkTest);
+
+class CompressedSinkFixture
+{
+public:
+  CompressedSinkFixture()
+    : m_dir(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "CompressedSinkTest")
+  {
+    boost::filesystem::create_directories(m_dir);
+    path = (m_dir / "test.log.gz").string();
+  }
+
+  ~CompressedSinkFixture()
+  {
+    boost::filesystem::remove_all(m_dir);
+  }
+
+  /** \brief decompress \p path from \p offset
+   *  \param isRaw true if \p offset is a sync point, false if \p offset is zero
+   *  \return messages of complete lines, without timestamp, level and module
+   */
+  std::vector<std::string>
+  readMessages(size_t offset = 0, bool isRaw = false) const
+  {
+    std::string compressed = readFile();
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    BOOST_REQUIRE_EQUAL(inflateInit2(&stream, isRaw ? -15 : 15 + 16), Z_OK);
+    stream.next_in = reinterpret_cast<Bytef*>(&compressed[offset]);
+    stream.avail_in = static_cast<uInt>(compressed.size() - offset);
+
+    std::string text;
+    std::vector<char> output(4096);
+    int result = Z_OK;
+    while (result == Z_OK) {
+      stream.next_out = reinterpret_cast<Bytef*>(output.data());
+      stream.avail_out = static_cast<uInt>(output.size());
+      result = inflate(&stream, Z_NO_FLUSH);
+      text.append(output.data(), output.size() - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    BOOST_CHECK(result == Z_STREAM_END || result == Z_BUF_ERROR);
+
+    std::vector<std::string> messages;
+    std::istringstream is(text);
+    std::string line;
+    while (std::getline(is, line) && !is.eof()) {
+      messages.push_back(line.substr(line.find("] ") + 2));
+    }
+    return messages;
+  }
+
+  std::string
+  readFile() const
+  {
+    std::ifstream is(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+  }
+
+private:
+  boost::filesystem::path m_dir;
+
+protected:
+  std::string path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilLoggerCompressedSink, CompressedSinkFixture)
+
+BOOST_AUTO_TEST_CASE(Write)
+{
+  {
+    CompressedLogSink sink(path);
+    for (int i = 0; i < 1000; ++i) {
+      writeRecord<getNdnCxxLogger>(sink, i);
+    }
+    sink.flush();
+  }
+
+  std::vector<std::string> messages = readMessages();
+  BOOST_REQUIRE_EQUAL(messages.size(), 1000);
+  BOOST_CHECK_EQUAL(messages.front(), "record 0");
+  BOOST_CHECK_EQUAL(messages.back(), "record 999");
+
+  // compressed size is well below the text size
+  BOOST_CHECK_LT(boost::filesystem::file_size(path), 1000 * 40 / 4);
+}
+
+BOOST_AUTO_TEST_CASE(SyncPoints)
+{
+  CompressedLogSink::Options options;
+  options.syncInterval = 4096;
+  {
+    CompressedLogSink sink(path, options);
+    for (int i = 0; i < 1000; ++i) {
+      writeRecord<getNdnCxxLogger>(sink, i);
+    }
+    BOOST_CHECK_GE(sink.getNSyncPoints(), 5);
+  }
+
+  // decompression can start after any sync point, at the beginning of a record
+  static const std::string SYNC_MARKER("\x00\x00\xFF\xFF", 4);
+  std::string compressed = readFile();
+  size_t marker = compressed.find(SYNC_MARKER, compressed.size() / 2);
+  BOOST_REQUIRE_NE(marker, std::string::npos);
+
+  std::vector<std::string> messages = readMessages(marker + SYNC_MARKER.size(), true);
+  BOOST_REQUIRE_GT(messages.size(), 0);
+  BOOST_CHECK_LT(messages.size(), 1000);
+  BOOST_CHECK_EQUAL(messages.front(), "record " + to_string(1000 - messages.size()));
+  BOOST_CHECK_EQUAL(messages.back(), "record 999");
+}
+
+BOOST_AUTO_TEST_CASE(Flush)
+{
+  CompressedLogSink::Options options;
+  options.flushInterval = time::milliseconds(0);
+  CompressedLogSink sink(path, options);
+
+  writeRecord<getNdnCxxLogger>(sink, 0);
+  writeRecord<getNdnCxxLogger>(sink, 1);
+  BOOST_CHECK_EQUAL(readMessages().size(), 0);
+
+  // flushed records are readable while the gzip stream is still open
+  sink.flush();
+  std::vector<std::string> messages = readMessages();
+  BOOST_REQUIRE_EQUAL(messages.size(), 2);
+  BOOST_CHECK_EQUAL(messages[1], "record 1");
+  BOOST_CHECK_EQUAL(sink.getNSyncPoints(), 1);
+
+  // nothing is written when there is no new record
+  sink.flush();
+  BOOST_CHECK_EQUAL(sink.getNSyncPoints(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(DeferredFlush)
+{
+  CompressedLogSink::Options options;
+  options.flushInterval = time::seconds(3600);
+  CompressedLogSink sink(path, options);
+
+  // a flush within flushInterval does not pass the records to the file yet
+  writeRecord<getNdnCxxLogger>(sink, 0);
+  sink.flush();
+  BOOST_CHECK_EQUAL(readMessages().size(), 0);
+  BOOST_CHECK_EQUAL(sink.getNSyncPoints(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(DeferredFlushDeadline)
+{
+  CompressedLogSink::Options options;
+  options.flushInterval = time::milliseconds(20);
+  CompressedLogSink sink(path, options);
+
+  writeRecord<getNdnCxxLogger>(sink, 0);
+  sink.flush();
+  writeRecord<getNdnCxxLogger>(sink, 1);
+  sink.flush();
+
+  // neither a record nor flush follows; the syncer thread passes the records to the file
+  for (int i = 0; i < 100 && readMessages().size() < 2; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::vector<std::string> messages = readMessages();
+  BOOST_REQUIRE_EQUAL(messages.size(), 2);
+  BOOST_CHECK_EQUAL(messages[1], "record 1");
+}
+
+BOOST_AUTO_TEST_CASE(InvalidOptions)
+{
+  CompressedLogSink::Options options;
+  options.compressionLevel = 10;
+  BOOST_CHECK_THROW(CompressedLogSink(path, options), CompressedLogSink::Error);
+  BOOST_CHECK_THROW(CompressedLogSink((boost::filesystem::path(path) / "nonexistent").string()),
+                    CompressedLogSink::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLoggerCompressedSink
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
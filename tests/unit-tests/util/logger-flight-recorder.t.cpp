@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger-flight-recorder.hpp"
+#include "util/logger-factory.hpp"
+#include "interest.hpp"
+
+#include "boost-test.hpp"
+#include "test-call-site.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_CXX_LOG_INIT(FlightRecorderTest);
+
+class FlightRecorderFixture
+{
+public:
+  FlightRecorderFixture()
+    : m_path(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "FlightRecorderTest")
+  {
+    boost::filesystem::create_directories(m_path);
+    dumpFile = (m_path / "dump.log").string();
+  }
+
+  ~FlightRecorderFixture()
+  {
+    boost::filesystem::remove_all(m_path);
+  }
+
+  /** \return lines of dumpFile, without timestamps
+   */
+  std::vector<std::string>
+  readDump() const
+  {
+    std::vector<std::string> lines;
+    std::ifstream is(dumpFile);
+    std::string line;
+    while (std::getline(is, line)) {
+      lines.push_back(line.substr(line.find(' ') + 1));
+    }
+    return lines;
+  }
+
+private:
+  boost::filesystem::path m_path;
+
+protected:
+  std::string dumpFile;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilLoggerFlightRecorder, FlightRecorderFixture)
+
+BOOST_AUTO_TEST_CASE(WrapAround)
+{
+  FlightRecorder recorder(4);
+  BOOST_CHECK_EQUAL(recorder.getCapacity(), 4);
+
+  for (int i = 0; i < 6; ++i) {
+    LogRecord record(getTestCallSite<getNdnCxxLogger>());
+    record << "record " << i;
+    recorder.record(record);
+  }
+  BOOST_CHECK_EQUAL(recorder.getNRecorded(), 6);
+  BOOST_CHECK_EQUAL(recorder.getNDropped(), 0);
+
+  BOOST_REQUIRE(recorder.dumpToFile(dumpFile.data()));
+  std::vector<std::string> lines = readDump();
+  BOOST_REQUIRE_EQUAL(lines.size(), 4);
+  for (int i = 0; i < 4; ++i) {
+    BOOST_CHECK_EQUAL(lines[i], "DEBUG: [FlightRecorderTest] record " + to_string(i + 2));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Render)
+{
+  FlightRecorder recorder(8);
+
+  Name name("/A/%01/....");
+  name.wireEncode();
+  Interest interest("/B");
+  interest.setNonce(1);
+  interest.wireEncode();
+  // the Name of a decoded Interest is part of the Interest's wire encoding
+  Interest decoded(interest.wireEncode());
+  {
+    LogRecord record(getTestCallSite<getNdnCxxLogger>());
+    record << "int=" << -5 << " uint=" << 7U << " double=" << 0.25 << " char=" << 'x'
+           << " bool=" << true << " str=" << std::string("s") << " name=" << name
+           << " interest=" << interest << " part=" << decoded.getName() << std::flush;
+    recorder.record(record);
+  }
+  {
+    LogRecord record(getTestCallSite<getNdnCxxLogger>());
+    record << "long=" << std::string(1000, 'a');
+    recorder.record(record);
+  }
+
+  BOOST_REQUIRE(recorder.dumpToFile(dumpFile.data()));
+  std::vector<std::string> lines = readDump();
+  BOOST_REQUIRE_EQUAL(lines.size(), 2);
+  BOOST_CHECK_EQUAL(lines[0], "DEBUG: [FlightRecorderTest] int=-5 uint=7 double=0.25 char=x "
+                              "bool=1 str=s name=/A/%01/.... interest=/B part=/B");
+  BOOST_CHECK_EQUAL(lines[1].compare(0, 34, "DEBUG: [FlightRecorderTest] long=a"), 0);
+  BOOST_CHECK_LT(lines[1].size(), 300);
+  BOOST_CHECK_EQUAL(lines[1].compare(lines[1].size() - 4, 4, "a..."), 0);
+}
+
+BOOST_AUTO_TEST_CASE(LoggerFactoryIntegration)
+{
+  std::ostringstream os;
+  LoggerFactory::setDestination(os);
+  LoggerFactory::setSeverityLevel("FlightRecorderTest", LogLevel::INFO);
+  LoggerFactory::enableFlightRecorder(16, LogLevel::DEBUG);
+
+  NDN_CXX_LOG_TRACE("trace");
+  NDN_CXX_LOG_DEBUG("debug");
+  NDN_CXX_LOG_INFO("info");
+
+  LoggerFactory::dumpFlightRecorder(dumpFile);
+  std::vector<std::string> lines = readDump();
+  BOOST_REQUIRE_EQUAL(lines.size(), 2);
+  BOOST_CHECK_EQUAL(lines[0], "DEBUG: [FlightRecorderTest] debug");
+  BOOST_CHECK_EQUAL(lines[1], "INFO: [FlightRecorderTest] info");
+
+  LoggerFactory::disableFlightRecorder();
+  NDN_CXX_LOG_DEBUG("debug after disabling");
+  BOOST_CHECK_THROW(LoggerFactory::dumpFlightRecorder(dumpFile), std::runtime_error);
+
+  LoggerFactory::getBackend()->flush();
+  std::string output = os.str();
+  BOOST_CHECK_EQUAL(output.find("debug"), std::string::npos);
+  BOOST_CHECK_NE(output.find(" INFO: [FlightRecorderTest] info"), std::string::npos);
+
+  LoggerFactory::setSeverityLevel("FlightRecorderTest", LogLevel::NONE);
+  static std::ofstream nullOutputStream;
+  LoggerFactory::setDestination(nullOutputStream);
+}
+
+BOOST_AUTO_TEST_CASE(ReplaceWhileRecording)
+{
+  std::atomic<bool> isStopped(false);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&isStopped] {
+      while (!isStopped.load()) {
+        NDN_CXX_LOG_DEBUG("concurrent");
+      }
+    });
+  }
+
+  // replaced recorders are deleted while other threads are recording
+  for (int i = 0; i < 50; ++i) {
+    LoggerFactory::enableFlightRecorder(64, LogLevel::DEBUG);
+    if (i % 10 == 0) {
+      LoggerFactory::disableFlightRecorder();
+    }
+  }
+  isStopped.store(true);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  LoggerFactory::enableFlightRecorder(16, LogLevel::DEBUG);
+  NDN_CXX_LOG_DEBUG("only");
+  LoggerFactory::dumpFlightRecorder(dumpFile);
+  std::vector<std::string> lines = readDump();
+  BOOST_REQUIRE_EQUAL(lines.size(), 1);
+  BOOST_CHECK_EQUAL(lines[0], "DEBUG: [FlightRecorderTest] only");
+
+  LoggerFactory::disableFlightRecorder();
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLoggerFlightRecorder
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+// this translation unit compiles log statements as if configured with
+// --with-log-level-floor=WARN, overriding the floor in ndn-cxx-config.hpp
+#include "common.hpp"
+#undef NDN_CXX_LOG_LEVEL_FLOOR
+#define NDN_CXX_LOG_LEVEL_FLOOR 2
+
+#include "util/logger.hpp"
+#include "util/logger-factory.hpp"
+
+#include "boost-test.hpp"
+
+#include <fstream>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_CXX_LOG_INIT(LogLevelFloorTest);
+
+BOOST_AUTO_TEST_SUITE(UtilLoggerLevelFloor)
+
+BOOST_AUTO_TEST_CASE(CompiledOut)
+{
+  std::ostringstream os;
+  LoggerFactory::setDestination(os);
+  LoggerFactory::setSeverityLevel("LogLevelFloorTest", LogLevel::ALL);
+
+  // statements below the floor are not compiled, whatever the level of their module
+  int nEvaluations = 0;
+  NDN_CXX_LOG_DEBUG("debug " << ++nEvaluations);
+  NDN_CXX_LOG_INFO_EVERY_N(1, "info " << ++nEvaluations);
+  BOOST_CHECK_EQUAL(nEvaluations, 0);
+
+  NDN_CXX_LOG_WARN("warn " << ++nEvaluations);
+  NDN_CXX_LOG_FATAL("fatal " << ++nEvaluations);
+  BOOST_CHECK_EQUAL(nEvaluations, 2);
+
+  LoggerFactory::getBackend()->flush();
+  std::string output = os.str();
+  BOOST_CHECK_EQUAL(output.find("debug"), std::string::npos);
+  BOOST_CHECK_EQUAL(output.find("info"), std::string::npos);
+  BOOST_CHECK_NE(output.find("[LogLevelFloorTest] warn 1"), std::string::npos);
+  BOOST_CHECK_NE(output.find("[LogLevelFloorTest] fatal 2"), std::string::npos);
+
+  LoggerFactory::setSeverityLevel("LogLevelFloorTest", LogLevel::NONE);
+  static std::ofstream nullOutputStream;
+  LoggerFactory::setDestination(nullOutputStream);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLoggerLevelFloor
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger-management.hpp"
+#include "util/logger-tlv.hpp"
+#include "util/dummy-client-face.hpp"
+#include "encoding/tlv-nfd.hpp"
+
+#include "boost-test.hpp"
+#include "identity-management-fixture.hpp"
+#include "../unit-test-time-fixture.hpp"
+#include "../make-interest-data.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+NDN_CXX_LOG_INIT(LoggerManagementTest);
+
+class LoggerManagementFixture : public UnitTestTimeFixture
+                              , public security::IdentityManagementFixture
+{
+public:
+  LoggerManagementFixture()
+    : face(io, {true, true})
+    , dispatcher(face, m_keyChain)
+    , management(face, dispatcher, mgmt::makeAcceptAllAuthorization())
+  {
+    dispatcher.addTopPrefix("/root");
+    advanceClocks(time::milliseconds(1));
+    face.sentData.clear();
+
+    // the Logger is constructed when first used
+    getNdnCxxLogger();
+    LoggerFactory::setSeverityLevel("LoggerManagementTest", LogLevel::INFO);
+  }
+
+  ~LoggerManagementFixture()
+  {
+    LoggerFactory::resetSeverityLevel("LoggerManagementTest.*");
+    LoggerFactory::setSeverityLevel("LoggerManagementTest", LogLevel::NONE);
+  }
+
+  /** \brief send a set-level command and return the status code of the response
+   */
+  uint32_t
+  setLevel(const LoggerControlParameters& params)
+  {
+    face.sentData.clear();
+    Name name("/root/log/set-level");
+    name.append(params.wireEncode());
+    face.receive(*makeInterest(name));
+    advanceClocks(time::milliseconds(1));
+
+    BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+    return mgmt::ControlResponse(face.sentData[0].getContent().blockFromValue()).getCode();
+  }
+
+public:
+  DummyClientFace face;
+  mgmt::Dispatcher dispatcher;
+  LoggerManagement management;
+};
+
+BOOST_AUTO_TEST_SUITE(UtilLoggerManagement)
+
+BOOST_AUTO_TEST_CASE(ControlParametersEncoding)
+{
+  LoggerControlParameters params;
+  BOOST_CHECK(!params.hasModuleName());
+  BOOST_CHECK(!params.hasLevel());
+  BOOST_CHECK(!params.hasDuration());
+
+  params.setModuleName("Face")
+        .setLevel(LogLevel::DEBUG)
+        .setDuration(time::minutes(1));
+  Block wire = params.wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), tlv::nfd::ControlParameters);
+
+  LoggerControlParameters decoded(wire);
+  BOOST_CHECK_EQUAL(decoded.getModuleName(), "Face");
+  BOOST_CHECK(decoded.getLevel() == LogLevel::DEBUG);
+  BOOST_CHECK_EQUAL(decoded.getDuration(), time::minutes(1));
+
+  LoggerControlParameters fatal(LoggerControlParameters().setLevel(LogLevel::FATAL).wireEncode());
+  BOOST_CHECK(!fatal.hasModuleName());
+  BOOST_CHECK(fatal.getLevel() == LogLevel::FATAL);
+
+  BOOST_CHECK_THROW(LoggerControlParameters(Block(tlv::Name)), LoggerControlParameters::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ModuleStatusEncoding)
+{
+  LoggerFactory::ModuleStatus status{"Face", LogLevel::ALL, 10, 2};
+  Block wire = LoggerModuleStatus(status).wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), tlv::logging::ModuleStatus);
+
+  LoggerModuleStatus decoded(wire);
+  BOOST_CHECK_EQUAL(decoded.get().moduleName, "Face");
+  BOOST_CHECK(decoded.get().level == LogLevel::ALL);
+  BOOST_CHECK_EQUAL(decoded.get().nRecords, 10);
+  BOOST_CHECK_EQUAL(decoded.get().nDropped, 2);
+
+  BOOST_CHECK_THROW(LoggerModuleStatus(Block(tlv::logging::ModuleStatus)),
+                    LoggerModuleStatus::Error);
+}
+
+BOOST_FIXTURE_TEST_CASE(SetLevel, LoggerManagementFixture)
+{
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("LoggerManagementTest")
+                               .setLevel(LogLevel::DEBUG)), 200);
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("LoggerManagementTest") == LogLevel::DEBUG);
+
+  // missing level
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("LoggerManagementTest")), 400);
+  // temporary level for all modules
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("*")
+                               .setLevel(LogLevel::DEBUG)
+                               .setDuration(time::seconds(1))), 400);
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("LoggerManagementTest") == LogLevel::DEBUG);
+
+  // modules under a prefix
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("LoggerManagementTest.*")
+                               .setLevel(LogLevel::TRACE)), 200);
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("LoggerManagementTest.Sub") == LogLevel::TRACE);
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("LoggerManagementTest") == LogLevel::DEBUG);
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("LoggerManagementTest.*")
+                               .setLevel(LogLevel::DEBUG)
+                               .setDuration(time::seconds(1))), 400);
+  // '*' is not the last component
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("LoggerManagement*")
+                               .setLevel(LogLevel::DEBUG)), 400);
+}
+
+BOOST_FIXTURE_TEST_CASE(SetLevelTemporarily, LoggerManagementFixture)
+{
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("LoggerManagementTest")
+                               .setLevel(LogLevel::DEBUG)
+                               .setDuration(time::seconds(60))), 200);
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("LoggerManagementTest") == LogLevel::DEBUG);
+
+  // raising again extends the period, but the original level is still restored
+  advanceClocks(time::seconds(30));
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("LoggerManagementTest")
+                               .setLevel(LogLevel::TRACE)
+                               .setDuration(time::seconds(60))), 200);
+  advanceClocks(time::seconds(40));
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("LoggerManagementTest") == LogLevel::TRACE);
+  advanceClocks(time::seconds(30));
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("LoggerManagementTest") == LogLevel::INFO);
+
+  // a permanent level cancels the restore
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("LoggerManagementTest")
+                               .setLevel(LogLevel::DEBUG)
+                               .setDuration(time::seconds(60))), 200);
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("LoggerManagementTest")
+                               .setLevel(LogLevel::WARN)), 200);
+  advanceClocks(time::seconds(90));
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("LoggerManagementTest") == LogLevel::WARN);
+
+  // a module without a level of its own takes the level of its prefix again
+  LoggerFactory::setSeverityLevel("LoggerManagementTest.*", LogLevel::TRACE);
+  BOOST_CHECK_EQUAL(setLevel(LoggerControlParameters()
+                               .setModuleName("LoggerManagementTest.Sub")
+                               .setLevel(LogLevel::DEBUG)
+                               .setDuration(time::seconds(60))), 200);
+  BOOST_CHECK(LoggerFactory::hasSeverityLevel("LoggerManagementTest.Sub"));
+  advanceClocks(time::seconds(90));
+  BOOST_CHECK(!LoggerFactory::hasSeverityLevel("LoggerManagementTest.Sub"));
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("LoggerManagementTest.Sub") == LogLevel::TRACE);
+  LoggerFactory::setSeverityLevel("LoggerManagementTest.*", LogLevel::WARN);
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("LoggerManagementTest.Sub") == LogLevel::WARN);
+}
+
+BOOST_FIXTURE_TEST_CASE(ListModules, LoggerManagementFixture)
+{
+  face.receive(*makeInterest("/root/log/modules"));
+  advanceClocks(time::milliseconds(1));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+
+  Block content = face.sentData[0].getContent();
+  content.parse();
+  bool hasModule = false;
+  for (const Block& element : content.elements()) {
+    LoggerModuleStatus status(element);
+    if (status.get().moduleName == "LoggerManagementTest") {
+      hasModule = true;
+      BOOST_CHECK(status.get().level == LogLevel::INFO);
+    }
+  }
+  BOOST_CHECK(hasModule);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLoggerManagement
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
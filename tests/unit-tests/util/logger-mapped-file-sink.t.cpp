@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger-mapped-file-sink.hpp"
+#include "util/logger-factory.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-test-time-fixture.hpp"
+#include "test-call-site.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_CXX_LOG_INIT(MappedFileSinkTest);
+
+class MappedFileSinkFixture
+{
+public:
+  MappedFileSinkFixture()
+    : m_dir(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "MappedFileSinkTest")
+  {
+    boost::filesystem::create_directories(m_dir);
+    path = (m_dir / "test.log").string();
+  }
+
+  ~MappedFileSinkFixture()
+  {
+    boost::filesystem::remove_all(m_dir);
+  }
+
+  /** \return messages in \p filename, without timestamp, level and module
+   */
+  static std::vector<std::string>
+  readMessages(const std::string& filename)
+  {
+    std::vector<std::string> messages;
+    std::ifstream is(filename);
+    std::string line;
+    while (std::getline(is, line)) {
+      messages.push_back(line.substr(line.find("] ") + 2));
+    }
+    return messages;
+  }
+
+private:
+  boost::filesystem::path m_dir;
+
+protected:
+  std::string path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilLoggerMappedFileSink, MappedFileSinkFixture)
+
+BOOST_AUTO_TEST_CASE(Write)
+{
+  MappedFileLogSink::Options options;
+  options.fileSize = 4096;
+  options.durability = MappedFileLogSink::Durability::SYNC_ON_ERROR;
+  {
+    MappedFileLogSink sink(path, options);
+    writeRecord<getNdnCxxLogger>(sink, 0);
+    writeRecord<getNdnCxxLogger>(sink, 1, LogLevel::ERROR);
+    writeRecord<getNdnCxxLogger>(sink, 2);
+    sink.flush();
+    BOOST_CHECK_EQUAL(boost::filesystem::file_size(path), 4096); // preallocated
+  }
+
+  // the file is truncated to its written size upon closing
+  std::vector<std::string> messages = readMessages(path);
+  BOOST_REQUIRE_EQUAL(messages.size(), 3);
+  BOOST_CHECK_EQUAL(messages[0], "record 0");
+  BOOST_CHECK_EQUAL(messages[1], "record 1");
+  BOOST_CHECK_EQUAL(messages[2], "record 2");
+  BOOST_CHECK_LT(boost::filesystem::file_size(path), 4096);
+}
+
+BOOST_AUTO_TEST_CASE(PeriodicSyncOnFlush)
+{
+  ndn::tests::UnitTestTimeFixture clocks; // record timestamps come from the mock system clock
+
+  MappedFileLogSink::Options options;
+  options.fileSize = 4096;
+  options.durability = MappedFileLogSink::Durability::PERIODIC_SYNC;
+  options.syncInterval = time::hours(1); // the syncer thread does not wake up during the test
+  MappedFileLogSink sink(path, options);
+
+  writeRecord<getNdnCxxLogger>(sink, 0);
+  sink.flush();
+  BOOST_CHECK_EQUAL(sink.getSyncedSize(), 0);
+
+  // no further record is written, but flush is invoked after the interval
+  clocks.advanceClocks(time::hours(1));
+  sink.flush();
+  BOOST_CHECK_GT(sink.getSyncedSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(PeriodicSyncAfterBurst)
+{
+  MappedFileLogSink::Options options;
+  options.fileSize = 4096;
+  options.durability = MappedFileLogSink::Durability::PERIODIC_SYNC;
+  options.syncInterval = time::milliseconds(10);
+  MappedFileLogSink sink(path, options);
+
+  writeRecord<getNdnCxxLogger>(sink, 0);
+  writeRecord<getNdnCxxLogger>(sink, 1);
+  sink.flush();
+
+  // neither a record nor flush follows; the syncer thread synchronizes the burst
+  for (int i = 0; i < 200 && sink.getSyncedSize() == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  size_t syncedSize = sink.getSyncedSize();
+  BOOST_CHECK_GT(syncedSize, 0);
+
+  std::ifstream is(path);
+  std::string line;
+  size_t writtenSize = 0;
+  while (std::getline(is, line) && line[0] != '\0') {
+    writtenSize += line.size() + 1;
+  }
+  BOOST_CHECK_EQUAL(syncedSize, writtenSize);
+}
+
+BOOST_AUTO_TEST_CASE(SizeRotation)
+{
+  MappedFileLogSink::Options options;
+  options.fileSize = 256;
+  options.nRotatedFiles = 2;
+  {
+    MappedFileLogSink sink(path, options);
+    for (int i = 0; i < 40; ++i) {
+      writeRecord<getNdnCxxLogger>(sink, i);
+    }
+    BOOST_CHECK_EQUAL(sink.getNDropped(), 0);
+  }
+
+  BOOST_CHECK(!boost::filesystem::exists(path + ".3"));
+  std::vector<std::string> current = readMessages(path);
+  std::vector<std::string> rotated1 = readMessages(path + ".1");
+  std::vector<std::string> rotated2 = readMessages(path + ".2");
+  BOOST_REQUIRE(!current.empty() && !rotated1.empty() && !rotated2.empty());
+  BOOST_CHECK_EQUAL(current.back(), "record 39");
+
+  // the files hold consecutive records
+  BOOST_CHECK_EQUAL(rotated2.back(), "record " + to_string(39 - current.size() - rotated1.size()));
+  BOOST_CHECK_EQUAL(rotated1.back(), "record " + to_string(39 - current.size()));
+  BOOST_CHECK_LE(boost::filesystem::file_size(path + ".1"), 256);
+}
+
+BOOST_AUTO_TEST_CASE(ExplicitRotation)
+{
+  MappedFileLogSink::Options options;
+  options.fileSize = 4096;
+  options.nRotatedFiles = 0;
+  {
+    MappedFileLogSink sink(path, options);
+    writeRecord<getNdnCxxLogger>(sink, 0);
+    sink.rotate();
+    writeRecord<getNdnCxxLogger>(sink, 1);
+  }
+
+  std::vector<std::string> messages = readMessages(path);
+  BOOST_REQUIRE_EQUAL(messages.size(), 1);
+  BOOST_CHECK_EQUAL(messages[0], "record 1");
+  BOOST_CHECK(!boost::filesystem::exists(path + ".1"));
+}
+
+BOOST_AUTO_TEST_CASE(CannotCreate)
+{
+  BOOST_CHECK_THROW(MappedFileLogSink(path + "/nonexistent/test.log"), MappedFileLogSink::Error);
+}
+
+BOOST_AUTO_TEST_CASE(LoggerFactorySink)
+{
+  shared_ptr<LogSink> oldSink = LoggerFactory::getSink();
+  LoggerFactory::setSeverityLevel("MappedFileSinkTest", LogLevel::INFO);
+  LoggerFactory::setSink(make_shared<MappedFileLogSink>(path));
+
+  NDN_CXX_LOG_INFO("via LoggerFactory");
+  NDN_CXX_LOG_DEBUG("not logged");
+
+  LoggerFactory::setSeverityLevel("MappedFileSinkTest", LogLevel::NONE);
+  LoggerFactory::setSink(oldSink); // closes the file
+
+  std::vector<std::string> messages = readMessages(path);
+  BOOST_REQUIRE_EQUAL(messages.size(), 1);
+  BOOST_CHECK_EQUAL(messages[0], "via LoggerFactory");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLoggerMappedFileSink
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger.hpp"
+#include "interest.hpp"
+#include "data.hpp"
+
+#include "boost-test.hpp"
+#include "../make-interest-data.hpp"
+#include "test-call-site.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_CXX_LOG_INIT(LogRecordTest);
+
+BOOST_AUTO_TEST_SUITE(UtilLoggerRecord)
+
+BOOST_AUTO_TEST_CASE(Primitives)
+{
+  LogRecord record(getTestCallSite<getNdnCxxLogger>());
+
+  std::string str("string");
+  char buffer[] = "buffer";
+  record << "literal " << str << ' ' << buffer << ' ' << -1 << ' ' << 2U << ' '
+         << static_cast<uint8_t>('c') << ' ' << true << ' ' << 0.5 << ' '
+         << time::milliseconds(100) << std::flush;
+
+  // the record must not depend on the lifetime of non-literal arguments
+  str = "changed";
+  std::strcpy(buffer, "BUFFER");
+
+  BOOST_CHECK_EQUAL(record.getMessage(), "literal string buffer -1 2 c 1 0.5 100 milliseconds");
+  BOOST_CHECK(record.getLevel() == LogLevel::DEBUG);
+  BOOST_CHECK_EQUAL(&record.getLogger(), &getNdnCxxLogger());
+}
+
+BOOST_AUTO_TEST_CASE(CharArrays)
+{
+  LogRecord record(getTestCallSite<getNdnCxxLogger>());
+
+  char buffer[16];
+  std::snprintf(buffer, sizeof(buffer), "%d", 42);
+  const char constBuffer[] = {'c', 'o', 'n', 's', 't'}; // not null-terminated
+  record << NDN_CXX_LOG_LITERAL("literal ") << buffer << ' ' << constBuffer;
+
+  std::strcpy(buffer, "XX");
+  const_cast<char&>(constBuffer[0]) = 'X';
+
+  BOOST_CHECK_EQUAL(record.getMessage(), "literal 42 const");
+}
+
+BOOST_AUTO_TEST_CASE(Manipulators)
+{
+  LogRecord record(getTestCallSite<getNdnCxxLogger>());
+  record << std::hex << 255 << ' ' << std::showbase << 255 << std::noshowbase << std::dec
+         << ' ' << 255 << ' ' << std::setw(4) << std::setfill('0') << 7 << ' '
+         << std::setw(3) << "ab" << ' ' << std::fixed << std::setprecision(2) << 0.5 << ' '
+         << std::setbase(16) << 10;
+
+  std::ostringstream os;
+  os << std::setprecision(3);
+  record.printMessage(os);
+  BOOST_CHECK_EQUAL(os.str(), "ff 0xff 255 0007 0ab 0.50 a");
+
+  // the stream state is restored after the message
+  os << ' ' << 10 << ' ' << 1.0 / 3;
+  BOOST_CHECK_EQUAL(os.str(), "ff 0xff 255 0007 0ab 0.50 a 10 0.333");
+}
+
+BOOST_AUTO_TEST_CASE(WireEncodedPackets)
+{
+  Interest interest("/A/B");
+  interest.setNonce(1);
+  interest.setMustBeFresh(true);
+  interest.wireEncode();
+  Name name(interest.getName().wireEncode());
+  BOOST_REQUIRE(name.hasWire());
+
+  long nInterestWireRefs = interest.wireEncode().getBuffer().use_count();
+  LogRecord record(getTestCallSite<getNdnCxxLogger>());
+  record << "<I " << interest;
+  // the Interest is copied, because setNonce modifies its wire encoding in place
+  BOOST_CHECK_EQUAL(interest.wireEncode().getBuffer().use_count(), nInterestWireRefs);
+  record << " name=" << name << " prefix=" << Name("/C");
+  interest.setNonce(2);
+  interest.setName("/X");
+
+  BOOST_CHECK_EQUAL(record.getMessage(),
+                    "<I /A/B?ndn.MustBeFresh=1&ndn.Nonce=1 name=/A/B prefix=/C");
+  BOOST_CHECK_EQUAL(record.getMessage(),
+                    "<I /A/B?ndn.MustBeFresh=1&ndn.Nonce=1 name=/A/B prefix=/C");
+}
+
+BOOST_AUTO_TEST_CASE(WireEncodedData)
+{
+  shared_ptr<Data> data = makeData("/D/E");
+
+  LogRecord record(getTestCallSite<getNdnCxxLogger>());
+  record << ">D " << *data;
+  data->setName("/X");
+
+  BOOST_CHECK_EQUAL(record.getMessage().substr(0, 14), ">D Name: /D/E\n");
+}
+
+BOOST_AUTO_TEST_CASE(WirePartOfBuffer)
+{
+  // a packet received by StreamTransport occupies part of a larger receive buffer
+  Block wire = makeData("/D/E")->wireEncode();
+  auto receiveBuffer = make_shared<Buffer>(MAX_NDN_PACKET_SIZE);
+  std::copy(wire.begin(), wire.end(), receiveBuffer->begin() + 100);
+  Data data(Block(receiveBuffer, receiveBuffer->begin() + 100,
+                  receiveBuffer->begin() + 100 + wire.size()));
+  long nReceiveBufferRefs = receiveBuffer.use_count();
+
+  LogRecord record(getTestCallSite<getNdnCxxLogger>());
+  record << ">D " << data.getName() << " " << data;
+  // both the Name and the Data are copied inline, so the record does not pin the receive buffer
+  BOOST_CHECK_EQUAL(receiveBuffer.use_count(), nReceiveBufferRefs);
+
+  BOOST_CHECK_EQUAL(record.getMessage().substr(0, 19), ">D /D/E Name: /D/E\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLoggerRecord
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger-ring-buffer-backend.hpp"
+
+#include "boost-test.hpp"
+#include "test-call-site.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_CXX_LOG_INIT(RingBufferTest);
+
+BOOST_AUTO_TEST_SUITE(UtilLoggerRingBufferBackend)
+
+BOOST_AUTO_TEST_CASE(MergeThreads)
+{
+  std::ostringstream os;
+  RingBufferLoggerBackend backend(1024, time::milliseconds(1));
+  backend.setSink(make_shared<StreamLogSink>(os));
+
+  static const int N_THREADS = 4;
+  static const int N_RECORDS = 100;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < N_THREADS; ++i) {
+    threads.emplace_back([&backend, i] {
+      for (int j = 0; j < N_RECORDS; ++j) {
+        LogRecord record(getTestCallSite<getNdnCxxLogger>(LogLevel::DEBUG));
+        record << "thread" << i << " record" << j;
+        backend.log(std::move(record));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  backend.flush();
+
+  std::istringstream is(os.str());
+  std::string line;
+  int nLines = 0;
+  std::string prevTimestamp;
+  while (std::getline(is, line)) {
+    ++nLines;
+    BOOST_CHECK_NE(line.find(" DEBUG: [RingBufferTest] thread"), std::string::npos);
+    std::string timestamp = line.substr(0, line.find(' '));
+    BOOST_CHECK_LE(prevTimestamp, timestamp);
+    prevTimestamp = timestamp;
+  }
+  BOOST_CHECK_EQUAL(nLines, N_THREADS * N_RECORDS);
+
+  RingBufferLoggerBackend::Statistics st = backend.getStatistics();
+  BOOST_CHECK_EQUAL(st.nQueued, N_THREADS * N_RECORDS);
+  BOOST_CHECK_EQUAL(st.nDropped, 0);
+  BOOST_CHECK_EQUAL(st.nWritten, N_THREADS * N_RECORDS);
+  BOOST_CHECK_EQUAL(st.nRings, 0); // rings of exited threads are removed after draining
+}
+
+BOOST_AUTO_TEST_CASE(Overflow)
+{
+  std::ostringstream os;
+  RingBufferLoggerBackend backend(8, time::seconds(3600));
+  backend.setSink(make_shared<StreamLogSink>(os));
+
+  for (int i = 0; i < 20; ++i) {
+    backend.log(LogRecord(getTestCallSite<getNdnCxxLogger>(LogLevel::INFO)));
+  }
+
+  RingBufferLoggerBackend::Statistics st = backend.getStatistics();
+  BOOST_CHECK_EQUAL(st.nQueued, 8);
+  BOOST_CHECK_EQUAL(st.nDropped, 12);
+  BOOST_CHECK_EQUAL(st.nWritten, 0);
+  BOOST_CHECK_EQUAL(st.nRings, 1);
+
+  backend.flush();
+  st = backend.getStatistics();
+  BOOST_CHECK_EQUAL(st.nWritten, 8);
+  std::string output = os.str();
+  BOOST_CHECK_EQUAL(std::count(output.begin(), output.end(), '\n'), 8);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLoggerRingBufferBackend
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger-timestamp.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+class TimestampSourceFixture
+{
+public:
+  TimestampSourceFixture()
+    : m_oldSource(LogTimestamp::getSource())
+  {
+  }
+
+  ~TimestampSourceFixture()
+  {
+    LogTimestamp::setSource(m_oldSource);
+  }
+
+private:
+  TimestampSource m_oldSource;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilLoggerTimestamp, TimestampSourceFixture)
+
+static std::string
+formatTimestamp(int64_t microseconds)
+{
+  char buffer[LogTimestamp::MAX_FORMATTED_LENGTH + 1];
+  size_t length = LogTimestamp::format(LogTimestamp::TimePoint(time::microseconds(microseconds)),
+                                       buffer);
+  BOOST_CHECK_EQUAL(std::strlen(buffer), length);
+  return std::string(buffer, length);
+}
+
+BOOST_AUTO_TEST_CASE(Format)
+{
+  BOOST_CHECK_EQUAL(formatTimestamp(1466000000123456), "1466000000.123456");
+  // cached whole seconds
+  BOOST_CHECK_EQUAL(formatTimestamp(1466000000000007), "1466000000.000007");
+  BOOST_CHECK_EQUAL(formatTimestamp(1466000001999999), "1466000001.999999");
+  BOOST_CHECK_EQUAL(formatTimestamp(0), "0.000000");
+  BOOST_CHECK_EQUAL(formatTimestamp(2500000), "2.500000");
+  BOOST_CHECK_EQUAL(formatTimestamp(-500000), "-1.500000");
+
+  std::ostringstream os;
+  LogTimestamp::print(os, LogTimestamp::TimePoint(time::milliseconds(1500)));
+  BOOST_CHECK_EQUAL(os.str(), "1.500000");
+}
+
+BOOST_AUTO_TEST_CASE(Sources)
+{
+  LogTimestamp::setSource(TimestampSource::SYSTEM);
+  BOOST_CHECK_EQUAL(LogTimestamp::getSource(), TimestampSource::SYSTEM);
+  time::system_clock::TimePoint systemTime = time::system_clock::now();
+  BOOST_CHECK_LE(LogTimestamp::now() - systemTime, time::seconds(1));
+
+  LogTimestamp::setSource(TimestampSource::REALTIME_COARSE);
+  time::system_clock::TimePoint coarseTime = LogTimestamp::now();
+  BOOST_CHECK_LE(coarseTime - systemTime, time::seconds(1));
+  BOOST_CHECK_LE(systemTime - coarseTime, time::seconds(1));
+
+  LogTimestamp::setSource(TimestampSource::STEADY);
+  time::nanoseconds steadyTime = time::steady_clock::now().time_since_epoch();
+  BOOST_CHECK_LE(LogTimestamp::now().time_since_epoch() - steadyTime, time::seconds(1));
+
+  LogTimestamp::setSource(TimestampSource::PROCESS_RELATIVE);
+  LogTimestamp::TimePoint relativeTime = LogTimestamp::now();
+  BOOST_CHECK_GE(relativeTime.time_since_epoch(), time::nanoseconds::zero());
+  BOOST_CHECK_LE(relativeTime.time_since_epoch(), steadyTime);
+  BOOST_CHECK_LE(relativeTime, LogTimestamp::now());
+
+  BOOST_CHECK_EQUAL(LogTimestamp::toNanoseconds(LogTimestamp::TimePoint(time::microseconds(3))),
+                    3000);
+
+  std::ostringstream os;
+  os << TimestampSource::PROCESS_RELATIVE;
+  BOOST_CHECK_EQUAL(os.str(), "relative");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLoggerTimestamp
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger-tlv-sink.hpp"
+#include "encoding/block-helpers.hpp"
+#include "interest.hpp"
+
+#include "boost-test.hpp"
+#include "test-call-site.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_CXX_LOG_INIT(TlvSinkTest);
+
+BOOST_AUTO_TEST_SUITE(UtilLoggerTlvSink)
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  Interest interest("/A/B");
+  interest.setNonce(0x01020304);
+  interest.wireEncode();
+  Name name("/C");
+  name.wireEncode();
+  // the Name of a decoded Interest is part of the Interest's wire encoding
+  Interest decoded(interest.wireEncode());
+
+  LogRecord record(getTestCallSite<getNdnCxxLogger>());
+  record << "n=" << -2 << ' ' << 3u << " d=" << 0.5 << true << interest << name
+         << std::string("s") << decoded.getName();
+  Block wire = TlvLogSink::encode(record, 7);
+
+  BOOST_CHECK_EQUAL(wire.type(), tlv::logging::LogRecord);
+  wire.parse();
+  const Block::element_container& elements = wire.elements();
+  BOOST_REQUIRE_EQUAL(elements.size(), 14);
+
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(elements[0]),
+                    time::duration_cast<time::nanoseconds>(
+                      record.getTimestamp().time_since_epoch()).count());
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(elements[1]), 7);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(elements[2]), 5); // DEBUG
+
+  BOOST_CHECK_EQUAL(elements[3].type(), tlv::logging::TextField);
+  BOOST_CHECK_EQUAL(readString(elements[3]), "n=");
+  BOOST_CHECK_EQUAL(elements[4].type(), tlv::logging::SignedIntegerField);
+  static const uint8_t MINUS_TWO[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE};
+  BOOST_CHECK_EQUAL_COLLECTIONS(elements[4].value_begin(), elements[4].value_end(),
+                                MINUS_TWO, MINUS_TWO + sizeof(MINUS_TWO));
+  BOOST_CHECK_EQUAL(readString(elements[5]), " ");
+  BOOST_CHECK_EQUAL(elements[6].type(), tlv::logging::UnsignedIntegerField);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(elements[6]), 3);
+  BOOST_CHECK_EQUAL(readString(elements[7]), " d=");
+  BOOST_CHECK_EQUAL(elements[8].type(), tlv::logging::DoubleField);
+  static const uint8_t HALF[] = {0x3F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+  BOOST_CHECK_EQUAL_COLLECTIONS(elements[8].value_begin(), elements[8].value_end(),
+                                HALF, HALF + sizeof(HALF));
+  BOOST_CHECK_EQUAL(elements[9].type(), tlv::logging::BooleanField);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(elements[9]), 1);
+
+  BOOST_CHECK_EQUAL(elements[10].type(), tlv::logging::InterestField);
+  elements[10].parse();
+  BOOST_CHECK_EQUAL(Name(elements[10].get(tlv::Name)), "/A/B");
+  const Block& nonce = elements[10].get(tlv::Nonce);
+  BOOST_REQUIRE_EQUAL(nonce.value_size(), sizeof(uint32_t));
+  uint32_t nonceValue = 0;
+  std::memcpy(&nonceValue, nonce.value(), sizeof(nonceValue));
+  BOOST_CHECK_EQUAL(nonceValue, 0x01020304);
+
+  BOOST_CHECK_EQUAL(elements[11].type(), tlv::Name);
+  BOOST_CHECK_EQUAL(Name(elements[11]), "/C");
+  BOOST_CHECK_EQUAL(readString(elements[12]), "s");
+  BOOST_CHECK_EQUAL(elements[13].type(), tlv::Name);
+  BOOST_CHECK_EQUAL(Name(elements[13]), "/A/B");
+}
+
+BOOST_AUTO_TEST_CASE(Write)
+{
+  std::ostringstream os;
+  TlvLogSink sink(os);
+  for (int i = 0; i < 2; ++i) {
+    LogRecord record(getTestCallSite<getNdnCxxLogger>());
+    record << "record " << i;
+    sink.write(record);
+  }
+  sink.flush();
+
+  std::string output = os.str();
+  const uint8_t* pos = reinterpret_cast<const uint8_t*>(output.data());
+  const uint8_t* end = pos + output.size();
+  std::vector<Block> elements;
+  while (pos < end) {
+    bool isOk = false;
+    Block element;
+    std::tie(isOk, element) = Block::fromBuffer(pos, end - pos);
+    BOOST_REQUIRE(isOk);
+    elements.push_back(element);
+    pos += element.size();
+  }
+
+  // module is declared before its first record
+  BOOST_REQUIRE_EQUAL(elements.size(), 3);
+  BOOST_CHECK_EQUAL(elements[0].type(), tlv::logging::ModuleDeclaration);
+  elements[0].parse();
+  BOOST_CHECK_EQUAL(readString(elements[0].get(tlv::logging::ModuleName)), "TlvSinkTest");
+  uint64_t moduleId = readNonNegativeInteger(elements[0].get(tlv::logging::ModuleId));
+
+  for (int i = 1; i <= 2; ++i) {
+    BOOST_CHECK_EQUAL(elements[i].type(), tlv::logging::LogRecord);
+    elements[i].parse();
+    BOOST_CHECK_EQUAL(readNonNegativeInteger(elements[i].get(tlv::logging::ModuleId)), moduleId);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLoggerTlvSink
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
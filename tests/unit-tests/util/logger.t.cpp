@@ -0,0 +1,444 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/logger-factory.hpp"
+#include "util/logger-mapped-file-sink.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_CXX_LOG_INIT(CallSiteTest);
+
+static LogCallSite&
+getCallSite1()
+{
+  static LogCallSite site(&getNdnCxxLogger, LogLevel::DEBUG, __FILE__, __LINE__, "site1");
+  return site;
+}
+
+static LogCallSite&
+getCallSite2()
+{
+  static LogCallSite site(&getNdnCxxLogger, LogLevel::DEBUG, __FILE__, __LINE__, "site2");
+  return site;
+}
+
+static std::string
+makeLocation(const LogCallSite& site)
+{
+  return "util/logger.t.cpp:" + to_string(site.getLine());
+}
+
+BOOST_AUTO_TEST_SUITE(UtilLogger)
+
+BOOST_AUTO_TEST_CASE(CallSite)
+{
+  LogCallSite& site1 = getCallSite1();
+  LogCallSite& site2 = getCallSite2();
+  LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::INFO);
+
+  // first execution registers the call site
+  BOOST_CHECK_EQUAL(site1.isEnabled(), false);
+  std::vector<const LogCallSite*> sites = LoggerFactory::getCallSites();
+  BOOST_REQUIRE_LT(site1.getId(), sites.size());
+  BOOST_CHECK_EQUAL(sites[site1.getId()], &site1);
+  BOOST_CHECK_EQUAL(&site1.getLogger(), &getNdnCxxLogger());
+  BOOST_CHECK_EQUAL(site1.getFormat(), std::string("site1"));
+
+  BOOST_CHECK_EQUAL(site1.matches(makeLocation(site1)), true);
+  BOOST_CHECK_EQUAL(site1.matches(__FILE__ ":" + to_string(site1.getLine())), true);
+  BOOST_CHECK_EQUAL(site1.matches("er.t.cpp:" + to_string(site1.getLine())), false);
+  BOOST_CHECK_EQUAL(site1.matches(makeLocation(site2)), false);
+
+  LoggerFactory::setCallSiteEnabled(makeLocation(site1), true);
+  BOOST_CHECK_EQUAL(site1.isEnabled(), true);
+
+  LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::TRACE);
+  LoggerFactory::setCallSiteEnabled(makeLocation(site1), false);
+  BOOST_CHECK_EQUAL(site1.isEnabled(), false);
+
+  LoggerFactory::resetCallSite(makeLocation(site1));
+  BOOST_CHECK_EQUAL(site1.isEnabled(), true);
+
+  // rule is applied when the call site is registered
+  LoggerFactory::setCallSiteEnabled(makeLocation(site2), false);
+  BOOST_CHECK_EQUAL(site2.isEnabled(), false);
+  BOOST_CHECK_NE(site2.getId(), site1.getId());
+  LoggerFactory::resetCallSite(makeLocation(site2));
+  BOOST_CHECK_EQUAL(site2.isEnabled(), true);
+
+  BOOST_CHECK_THROW(LoggerFactory::setCallSiteEnabled("logger.t.cpp", true), std::invalid_argument);
+  BOOST_CHECK_THROW(LoggerFactory::setCallSiteEnabled("logger.t.cpp:x", true), std::invalid_argument);
+
+  LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::NONE);
+}
+
+class RateLimitFixture : public ndn::tests::UnitTestTimeFixture
+{
+public:
+  RateLimitFixture()
+  {
+    LoggerFactory::setDestination(m_os);
+    LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::DEBUG);
+  }
+
+  ~RateLimitFixture()
+  {
+    LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::NONE);
+    static std::ofstream nullOutputStream;
+    LoggerFactory::setDestination(nullOutputStream);
+  }
+
+  /** \return logged messages, without timestamp, level and module
+   */
+  std::vector<std::string>
+  getMessages()
+  {
+    LoggerFactory::getBackend()->flush();
+    std::vector<std::string> messages;
+    std::istringstream is(m_os.str());
+    std::string line;
+    while (std::getline(is, line)) {
+      messages.push_back(line.substr(line.find("] ") + 2));
+    }
+    return messages;
+  }
+
+private:
+  std::ostringstream m_os;
+};
+
+BOOST_FIXTURE_TEST_CASE(EveryN, RateLimitFixture)
+{
+  for (int i = 0; i < 8; ++i) {
+    NDN_CXX_LOG_DEBUG_EVERY_N(3, "message " << i);
+    NDN_CXX_LOG_TRACE_EVERY_N(3, "trace " << i); // disabled call site does not count
+  }
+
+  std::vector<std::string> messages = getMessages();
+  BOOST_REQUIRE_EQUAL(messages.size(), 3);
+  BOOST_CHECK_EQUAL(messages[0], "message 0");
+  BOOST_CHECK_EQUAL(messages[1], "message 3 [suppressed 2 messages]");
+  BOOST_CHECK_EQUAL(messages[2], "message 6 [suppressed 2 messages]");
+}
+
+BOOST_FIXTURE_TEST_CASE(EveryMs, RateLimitFixture)
+{
+  auto logMessage = [] (int i) {
+    NDN_CXX_LOG_DEBUG_EVERY_MS(100, "message " << i);
+  };
+
+  for (int i = 0; i < 10; ++i) {
+    logMessage(i);
+    advanceClocks(time::milliseconds(30));
+  }
+
+  std::vector<std::string> messages = getMessages();
+  BOOST_REQUIRE_EQUAL(messages.size(), 3);
+  BOOST_CHECK_EQUAL(messages[0], "message 0");
+  BOOST_CHECK_EQUAL(messages[1], "message 4 [suppressed 3 messages]");
+  BOOST_CHECK_EQUAL(messages[2], "message 8 [suppressed 3 messages]");
+
+  // the suppressed execution after the last logged one is reported only by the next one
+  advanceClocks(time::seconds(1));
+  BOOST_CHECK_EQUAL(getMessages().size(), 3);
+  logMessage(10);
+  messages = getMessages();
+  BOOST_REQUIRE_EQUAL(messages.size(), 4);
+  BOOST_CHECK_EQUAL(messages[3], "message 10 [suppressed 1 messages]");
+}
+
+BOOST_FIXTURE_TEST_CASE(TokenBucket, RateLimitFixture)
+{
+  auto logMessage = [] (const std::string& message) {
+    // 10 messages per second with bursts of 2
+    NDN_CXX_LOG_DEBUG_RATE(10, 2, message);
+  };
+
+  for (int i = 0; i < 5; ++i) {
+    logMessage("burst " + to_string(i));
+  }
+  advanceClocks(time::milliseconds(100));
+  for (int i = 0; i < 2; ++i) {
+    logMessage("refill " + to_string(i));
+  }
+  advanceClocks(time::seconds(1));
+  for (int i = 0; i < 3; ++i) {
+    logMessage("idle " + to_string(i));
+  }
+
+  std::vector<std::string> messages = getMessages();
+  BOOST_REQUIRE_EQUAL(messages.size(), 5);
+  BOOST_CHECK_EQUAL(messages[0], "burst 0");
+  BOOST_CHECK_EQUAL(messages[1], "burst 1");
+  BOOST_CHECK_EQUAL(messages[2], "refill 0 [suppressed 3 messages]");
+  BOOST_CHECK_EQUAL(messages[3], "idle 0 [suppressed 1 messages]");
+  BOOST_CHECK_EQUAL(messages[4], "idle 1");
+}
+
+static std::string
+getLastMessage(const std::ostringstream& os)
+{
+  std::string output = os.str();
+  if (output.empty()) {
+    return "";
+  }
+  output.pop_back(); // newline
+  return output.substr(output.rfind("] ") + 2);
+}
+
+BOOST_AUTO_TEST_CASE(ModuleRouting)
+{
+  std::ostringstream defaultOs, moduleOs, wildcardOs;
+  LoggerFactory::setDestination(defaultOs);
+  LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::INFO);
+
+  LoggerFactory::setModuleSink("CallSiteTest", make_shared<StreamLogSink>(moduleOs));
+  LoggerFactory::setModuleSink("*", make_shared<StreamLogSink>(wildcardOs));
+  NDN_CXX_LOG_INFO("routed to module");
+  LoggerFactory::getBackend()->flush();
+  BOOST_CHECK_EQUAL(getLastMessage(moduleOs), "routed to module");
+  BOOST_CHECK_EQUAL(wildcardOs.str(), "");
+  BOOST_CHECK_EQUAL(defaultOs.str(), "");
+
+  LoggerFactory::setSeverityLevels("CallSiteTest>");
+  BOOST_CHECK(LoggerFactory::getModuleSink("CallSiteTest") == nullptr);
+  NDN_CXX_LOG_INFO("routed to wildcard");
+  LoggerFactory::getBackend()->flush();
+  BOOST_CHECK_EQUAL(getLastMessage(wildcardOs), "routed to wildcard");
+
+  LoggerFactory::setModuleSink("*", nullptr);
+  NDN_CXX_LOG_INFO("not routed");
+  LoggerFactory::getBackend()->flush();
+  BOOST_CHECK_EQUAL(getLastMessage(defaultOs), "not routed");
+
+  boost::filesystem::path dir = boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "ModuleRouting";
+  boost::filesystem::create_directories(dir);
+  std::string path = (dir / "module.log").string();
+  LoggerFactory::setSeverityLevels("CallSiteTest=WARN:CallSiteTest>" + path);
+  BOOST_CHECK(dynamic_pointer_cast<MappedFileLogSink>(
+                LoggerFactory::getModuleSink("CallSiteTest")) != nullptr);
+  BOOST_CHECK(boost::filesystem::exists(path));
+
+  // routes to the same path share the sink, which is released once it is no longer routed
+  weak_ptr<LogSink> fileSink = LoggerFactory::getModuleSink("CallSiteTest");
+  LoggerFactory::setSeverityLevels("CallSiteTest>" + path + ":CallSiteTestOther>" + path);
+  BOOST_CHECK(LoggerFactory::getModuleSink("CallSiteTest") == fileSink.lock());
+  BOOST_CHECK(LoggerFactory::getModuleSink("CallSiteTestOther") == fileSink.lock());
+  LoggerFactory::setSeverityLevels("CallSiteTest>:CallSiteTestOther>");
+  BOOST_CHECK(fileSink.expired());
+
+  BOOST_CHECK_THROW(LoggerFactory::setSeverityLevels(">face.log"), std::invalid_argument);
+
+  // a malformed rule rejects the whole configuration, including routes before it
+  std::string okPath = (dir / "ok.log").string();
+  BOOST_CHECK_THROW(LoggerFactory::setSeverityLevels("CallSiteTest>" + okPath +
+                                                     ":CallSiteTestOther=BOGUS"),
+                    std::invalid_argument);
+  BOOST_CHECK(LoggerFactory::getModuleSink("CallSiteTest") == nullptr);
+  BOOST_CHECK(!boost::filesystem::exists(okPath));
+  BOOST_CHECK_THROW(LoggerFactory::setSeverityLevels("CallSiteTest=TRACE:CallSiteTest>" +
+                                                     okPath + ":Bad*Pattern=INFO"),
+                    std::invalid_argument);
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("CallSiteTest") == LogLevel::WARN);
+  BOOST_CHECK(!boost::filesystem::exists(okPath));
+  boost::filesystem::remove_all(dir);
+
+  LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::NONE);
+  static std::ofstream nullOutputStream;
+  LoggerFactory::setDestination(nullOutputStream);
+}
+
+BOOST_AUTO_TEST_CASE(ReplaceBackend)
+{
+  std::ostringstream os;
+  LoggerFactory::setDestination(os);
+  LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::INFO);
+
+  shared_ptr<LoggerBackend> original = LoggerFactory::getBackend();
+  BoostLoggerBackend::Options options;
+  options.maxDelay = time::seconds(3600);
+  auto backend = make_shared<BoostLoggerBackend>(options);
+  weak_ptr<LoggerBackend> replaced = backend;
+  LoggerFactory::setBackend(std::move(backend));
+  NDN_CXX_LOG_INFO("into replaced backend");
+
+  // no log statement is using the replaced backend, so it is released with its flusher thread,
+  // after writing out its record
+  LoggerFactory::setBackend(original);
+  BOOST_CHECK(replaced.expired());
+  BOOST_CHECK_EQUAL(getLastMessage(os), "into replaced backend");
+
+  LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::NONE);
+  static std::ofstream nullOutputStream;
+  LoggerFactory::setDestination(nullOutputStream);
+}
+
+BOOST_AUTO_TEST_CASE(ModuleStatus)
+{
+  static std::ofstream nullOutputStream;
+  LoggerFactory::setDestination(nullOutputStream);
+  LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::INFO);
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("CallSiteTest") == LogLevel::INFO);
+
+  auto findModule = [] {
+    std::vector<LoggerFactory::ModuleStatus> modules = LoggerFactory::getModuleStatus();
+    auto it = std::find_if(modules.begin(), modules.end(),
+                           [] (const LoggerFactory::ModuleStatus& module) {
+                             return module.moduleName == "CallSiteTest";
+                           });
+    BOOST_REQUIRE(it != modules.end());
+    return *it;
+  };
+
+  LoggerFactory::ModuleStatus before = findModule();
+  BOOST_CHECK(before.level == LogLevel::INFO);
+  BOOST_CHECK_EQUAL(before.nDropped, 0);
+
+  NDN_CXX_LOG_INFO("counted");
+  NDN_CXX_LOG_DEBUG("not counted");
+  LoggerFactory::ModuleStatus after = findModule();
+  BOOST_CHECK_EQUAL(after.nRecords, before.nRecords + 1);
+
+  LoggerFactory::setSeverityLevel("CallSiteTest", LogLevel::NONE);
+  BOOST_CHECK(findModule().level == LogLevel::NONE);
+}
+
+BOOST_AUTO_TEST_CASE(HierarchicalLevels)
+{
+  // a Logger cannot be unregistered from LoggerFactory, so these have static storage duration
+  static Logger loggerA("HierarchyTest.A");
+  static Logger loggerAB("HierarchyTest.A.B");
+  static Logger loggerC("HierarchyTest.C");
+  static Logger other("HierarchyTestOther");
+
+  LoggerFactory::setSeverityLevels("HierarchyTest.*=DEBUG:HierarchyTest.A.B=TRACE");
+  BOOST_CHECK(loggerA.getLevel() == LogLevel::DEBUG);
+  BOOST_CHECK(loggerAB.getLevel() == LogLevel::TRACE);
+  BOOST_CHECK(loggerC.getLevel() == LogLevel::DEBUG);
+  BOOST_CHECK(other.getLevel() == LoggerFactory::getSeverityLevel("*"));
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("HierarchyTest.*") == LogLevel::DEBUG);
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("HierarchyTest.A.*") == LogLevel::DEBUG);
+
+  // the most specific rule applies, regardless of the order of rules
+  LoggerFactory::setSeverityLevel("HierarchyTest.A.*", LogLevel::WARN);
+  BOOST_CHECK(loggerA.getLevel() == LogLevel::DEBUG);
+  BOOST_CHECK(loggerC.getLevel() == LogLevel::DEBUG);
+  BOOST_CHECK(LoggerFactory::getSeverityLevel("HierarchyTest.A.D.E") == LogLevel::WARN);
+
+  // a wildcard discards the rules it covers
+  BOOST_CHECK(loggerAB.getLevel() == LogLevel::WARN);
+  LoggerFactory::setSeverityLevel("HierarchyTest.A.B", LogLevel::TRACE);
+  LoggerFactory::setSeverityLevel("HierarchyTest.*", LogLevel::ERROR);
+  BOOST_CHECK(loggerA.getLevel() == LogLevel::ERROR);
+  BOOST_CHECK(loggerAB.getLevel() == LogLevel::ERROR);
+
+  // a Logger constructed later takes its level from the rules
+  LoggerFactory::setSeverityLevel("HierarchyTest.Late", LogLevel::ALL);
+  static Logger loggerLate("HierarchyTest.Late");
+  static Logger loggerLateChild("HierarchyTest.Late.Child");
+  BOOST_CHECK(loggerLate.getLevel() == LogLevel::ALL);
+  BOOST_CHECK(loggerLateChild.getLevel() == LogLevel::ERROR);
+
+  // resetting a rule lets the module take the level of its prefixes again
+  BOOST_CHECK(LoggerFactory::hasSeverityLevel("HierarchyTest.Late"));
+  BOOST_CHECK(!LoggerFactory::hasSeverityLevel("HierarchyTest.Late.Child"));
+  BOOST_CHECK(LoggerFactory::hasSeverityLevel("HierarchyTest.*"));
+  LoggerFactory::resetSeverityLevel("HierarchyTest.Late");
+  BOOST_CHECK(!LoggerFactory::hasSeverityLevel("HierarchyTest.Late"));
+  BOOST_CHECK(loggerLate.getLevel() == LogLevel::ERROR);
+  LoggerFactory::resetSeverityLevel("HierarchyTest.Unknown");
+
+  BOOST_CHECK_THROW(LoggerFactory::setSeverityLevel("HierarchyTest*", LogLevel::INFO),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(LoggerFactory::setSeverityLevels("HierarchyTest.*=INFO:HierarchyTest.*.A=INFO"),
+                    std::invalid_argument);
+  // a malformed configuration applies no level rule
+  BOOST_CHECK(loggerA.getLevel() == LogLevel::ERROR);
+
+  LoggerFactory::resetSeverityLevel("HierarchyTest.*");
+  BOOST_CHECK(!LoggerFactory::hasSeverityLevel("HierarchyTest.*"));
+  BOOST_CHECK(loggerA.getLevel() == LoggerFactory::getSeverityLevel("*"));
+  LoggerFactory::setSeverityLevel("HierarchyTest.*", LogLevel::NONE);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentRegistration)
+{
+  static const size_t N_THREADS = 4;
+  static const size_t N_LOGGERS_PER_THREAD = 500;
+
+  std::vector<Logger*> loggers[N_THREADS];
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < N_THREADS; ++i) {
+    threads.emplace_back([i, &loggers] {
+      // a Logger cannot be unregistered from LoggerFactory, so these are never deleted
+      for (size_t j = 0; j < N_LOGGERS_PER_THREAD; ++j) {
+        loggers[i].push_back(new Logger("ConcurrencyTest.Thread" + to_string(i) +
+                                        ".Module" + to_string(j)));
+      }
+    });
+  }
+
+  // each Logger ends up with the last level, whether it is constructed before, during,
+  // or after each change
+  for (int i = 0; i < 100; ++i) {
+    LoggerFactory::setSeverityLevel("ConcurrencyTest.*", i % 2 == 0 ? LogLevel::DEBUG :
+                                                                      LogLevel::WARN);
+  }
+  LoggerFactory::setSeverityLevel("ConcurrencyTest.*", LogLevel::TRACE);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  size_t nWrongLevel = 0;
+  for (const auto& threadLoggers : loggers) {
+    BOOST_REQUIRE_EQUAL(threadLoggers.size(), N_LOGGERS_PER_THREAD);
+    for (const Logger* logger : threadLoggers) {
+      nWrongLevel += logger->getLevel() == LogLevel::TRACE &&
+                     logger->isLevelEnabled(LogLevel::TRACE) ? 0 : 1;
+    }
+  }
+  BOOST_CHECK_EQUAL(nWrongLevel, 0);
+
+  std::vector<LoggerFactory::ModuleStatus> modules = LoggerFactory::getModuleStatus();
+  auto isTestModule = [] (const LoggerFactory::ModuleStatus& module) {
+    return module.moduleName.compare(0, 16, "ConcurrencyTest.") == 0;
+  };
+  BOOST_CHECK_EQUAL(std::count_if(modules.begin(), modules.end(), isTestModule),
+                    N_THREADS * N_LOGGERS_PER_THREAD);
+
+  LoggerFactory::setSeverityLevel("ConcurrencyTest.*", LogLevel::NONE);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilLogger
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,246 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/packet-capture.hpp"
+
+#include "boost-test.hpp"
+#include "../make-interest-data.hpp"
+
+#include <boost/filesystem.hpp>
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using Direction = PacketCapture::Direction;
+
+/** \brief parses a pcap file written by PacketCapture
+ */
+class CaptureReader
+{
+public:
+  explicit
+  CaptureReader(const std::string& capture)
+    : m_capture(capture)
+    , m_pos(0)
+  {
+  }
+
+  template<typename T>
+  T
+  read()
+  {
+    BOOST_REQUIRE_LE(m_pos + sizeof(T), m_capture.size());
+    T value;
+    std::memcpy(&value, m_capture.data() + m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return value;
+  }
+
+  std::string
+  readBytes(size_t length)
+  {
+    BOOST_REQUIRE_LE(m_pos + length, m_capture.size());
+    std::string bytes = m_capture.substr(m_pos, length);
+    m_pos += length;
+    return bytes;
+  }
+
+  /** \brief read a packet record
+   *  \return the direction and the wire encoding of the packet
+   */
+  std::pair<Direction, Block>
+  readPacket()
+  {
+    read<uint32_t>(); // seconds
+    BOOST_CHECK_LT(read<uint32_t>(), 1000000);
+    uint32_t capturedLength = read<uint32_t>();
+    BOOST_CHECK_EQUAL(read<uint32_t>(), capturedLength);
+
+    std::string destination = readBytes(6);
+    std::string source = readBytes(6);
+    BOOST_CHECK_EQUAL(readBytes(2), std::string("\x86\x24"));
+    BOOST_CHECK(destination != source);
+
+    std::string wire = readBytes(capturedLength - 14);
+    return {source.back() == 1 ? Direction::OUTGOING : Direction::INCOMING,
+            Block(reinterpret_cast<const uint8_t*>(wire.data()), wire.size())};
+  }
+
+  bool
+  isAtEnd() const
+  {
+    return m_pos == m_capture.size();
+  }
+
+private:
+  std::string m_capture;
+  size_t m_pos;
+};
+
+BOOST_AUTO_TEST_SUITE(UtilPacketCapture)
+
+BOOST_AUTO_TEST_CASE(FileHeader)
+{
+  std::ostringstream os;
+  {
+    PacketCapture capture(os);
+  }
+
+  CaptureReader reader(os.str());
+  BOOST_CHECK_EQUAL(reader.read<uint32_t>(), 0xa1b2c3d4);
+  BOOST_CHECK_EQUAL(reader.read<uint16_t>(), 2);
+  BOOST_CHECK_EQUAL(reader.read<uint16_t>(), 4);
+  BOOST_CHECK_EQUAL(reader.read<int32_t>(), 0);
+  BOOST_CHECK_EQUAL(reader.read<uint32_t>(), 0);
+  BOOST_CHECK_EQUAL(reader.read<uint32_t>(), 262144);
+  BOOST_CHECK_EQUAL(reader.read<uint32_t>(), 1); // LINKTYPE_ETHERNET
+  BOOST_CHECK(reader.isAtEnd());
+}
+
+BOOST_AUTO_TEST_CASE(Packets)
+{
+  Block interest = Interest("/A/1").wireEncode();
+  Block data = makeData("/B/2")->wireEncode();
+
+  std::ostringstream os;
+  {
+    PacketCapture capture(os);
+    capture.capture(Direction::OUTGOING, interest);
+    capture.capture(Direction::INCOMING, data);
+    capture.flush();
+
+    PacketCapture::Statistics st = capture.getStatistics();
+    BOOST_CHECK_EQUAL(st.nCaptured, 2);
+    BOOST_CHECK_EQUAL(st.nDropped, 0);
+    BOOST_CHECK_EQUAL(st.nWritten, 2);
+  }
+
+  CaptureReader reader(os.str());
+  reader.readBytes(24);
+
+  std::pair<Direction, Block> packet = reader.readPacket();
+  BOOST_CHECK(packet.first == Direction::OUTGOING);
+  BOOST_CHECK(packet.second == interest);
+
+  packet = reader.readPacket();
+  BOOST_CHECK(packet.first == Direction::INCOMING);
+  BOOST_CHECK(packet.second == data);
+  BOOST_CHECK(reader.isAtEnd());
+}
+
+BOOST_AUTO_TEST_CASE(PartOfBuffer)
+{
+  // a packet received by StreamTransport occupies part of a larger receive buffer
+  Block interest = Interest("/A/1").wireEncode();
+  auto receiveBuffer = make_shared<Buffer>(MAX_NDN_PACKET_SIZE);
+  std::copy(interest.begin(), interest.end(), receiveBuffer->begin() + 100);
+  Block received(receiveBuffer, receiveBuffer->begin() + 100,
+                 receiveBuffer->begin() + 100 + interest.size());
+
+  std::ostringstream os;
+  {
+    PacketCapture::Options options;
+    options.capacity = 1;
+    PacketCapture capture(os, options);
+    capture.capture(Direction::INCOMING, received);
+
+    // the queue holds a copy, so the receive buffer can be reused
+    BOOST_CHECK_EQUAL(receiveBuffer.use_count(), 2);
+  }
+
+  CaptureReader reader(os.str());
+  reader.readBytes(24);
+  BOOST_CHECK(reader.readPacket().second == interest);
+  BOOST_CHECK(reader.isAtEnd());
+}
+
+BOOST_AUTO_TEST_CASE(PrefixFilter)
+{
+  std::ostringstream os;
+  PacketCapture::Options options;
+  options.prefixes = {"/A", "/B/C"};
+  PacketCapture capture(os, options);
+
+  BOOST_CHECK(capture.wantsPacket("/A"));
+  BOOST_CHECK(capture.wantsPacket("/A/B"));
+  BOOST_CHECK(capture.wantsPacket("/B/C/D"));
+  BOOST_CHECK(!capture.wantsPacket("/B"));
+  BOOST_CHECK(!capture.wantsPacket("/C"));
+
+  PacketCapture everything(os);
+  BOOST_CHECK(everything.wantsPacket("/"));
+  BOOST_CHECK(everything.wantsPacket("/C"));
+}
+
+BOOST_AUTO_TEST_CASE(Overflow)
+{
+  Block interest = Interest("/A").wireEncode();
+
+  std::ostringstream os;
+  PacketCapture::Options options;
+  options.capacity = 2;
+  {
+    PacketCapture capture(os, options);
+    for (int i = 0; i < 1000; ++i) {
+      capture.capture(Direction::OUTGOING, interest);
+    }
+    capture.flush();
+
+    // the writer thread may or may not keep up, but no packet is unaccounted for
+    PacketCapture::Statistics st = capture.getStatistics();
+    BOOST_CHECK_EQUAL(st.nCaptured, 1000);
+    BOOST_CHECK_EQUAL(st.nWritten + st.nDropped, 1000);
+    BOOST_CHECK_EQUAL(os.str().size(), 24 + st.nWritten * (16 + 14 + interest.size()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(File)
+{
+  boost::filesystem::path dir(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "PacketCapture");
+  boost::filesystem::create_directories(dir);
+  std::string path = (dir / "capture.pcap").string();
+  Block interest = Interest("/A").wireEncode();
+
+  {
+    PacketCapture capture(path);
+    capture.capture(Direction::OUTGOING, interest);
+
+    // the writer thread flushes the file after each batch
+    for (int i = 0; i < 100 && boost::filesystem::file_size(path) == 24; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    BOOST_CHECK_EQUAL(boost::filesystem::file_size(path), 24 + 16 + 14 + interest.size());
+  }
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(path), 24 + 16 + 14 + interest.size());
+
+  BOOST_CHECK_THROW(PacketCapture((dir / "nonexistent" / "capture.pcap").string()),
+                    PacketCapture::Error);
+  boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilPacketCapture
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
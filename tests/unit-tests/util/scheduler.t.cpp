@@ -268,6 +268,134 @@ BOOST_AUTO_TEST_CASE(ScopedEventIdMove)
 
 BOOST_AUTO_TEST_SUITE_END() // ScopedEventId
 
+class TimingWheelEngineFixture : public UnitTestTimeFixture
+{
+public:
+  TimingWheelEngineFixture()
+    : scheduler(io, Scheduler::Engine::TIMING_WHEEL)
+  {
+  }
+
+public:
+  Scheduler scheduler;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TimingWheelEngine, TimingWheelEngineFixture)
+
+BOOST_AUTO_TEST_CASE(Events)
+{
+  std::vector<int> fired;
+  scheduler.scheduleEvent(time::seconds(10), [&] { fired.push_back(3); }); // in the heap
+  EventId i = scheduler.scheduleEvent(time::seconds(1), [&] { fired.push_back(-1); });
+  scheduler.scheduleEvent(time::microseconds(2500), [&] { fired.push_back(2); });
+  scheduler.scheduleEvent(time::microseconds(2400), [&] { fired.push_back(1); });
+  scheduler.scheduleEvent(time::seconds(0), [&] { fired.push_back(0); });
+  scheduler.cancelEvent(i);
+  scheduler.cancelEvent(i);
+
+  advanceClocks(time::microseconds(100), 23);
+  BOOST_CHECK((fired == std::vector<int>{0}));
+  advanceClocks(time::microseconds(100), 1);
+  BOOST_CHECK((fired == std::vector<int>{0, 1}));
+  advanceClocks(time::microseconds(100), 1);
+  BOOST_CHECK((fired == std::vector<int>{0, 1, 2}));
+
+  advanceClocks(time::milliseconds(100), 99);
+  advanceClocks(time::milliseconds(97));
+  BOOST_CHECK((fired == std::vector<int>{0, 1, 2}));
+  advanceClocks(time::microseconds(500));
+  BOOST_CHECK((fired == std::vector<int>{0, 1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(StaleEventId)
+{
+  int hit1 = 0, hit2 = 0;
+  EventId i1 = scheduler.scheduleEvent(time::milliseconds(10), [&] { ++hit1; });
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(hit1, 1);
+
+  // reuses the node of the fired event
+  EventId i2 = scheduler.scheduleEvent(time::milliseconds(10), [&] { ++hit2; });
+  scheduler.cancelEvent(i1);
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(hit2, 1);
+
+  ScopedEventId se(scheduler);
+  se = scheduler.scheduleEvent(time::milliseconds(10), [&] { ++hit1; });
+  se = scheduler.scheduleEvent(time::milliseconds(10), [&] { ++hit2; });
+  se.cancel();
+  scheduler.cancelEvent(i2);
+  advanceClocks(time::milliseconds(1), 15);
+  BOOST_CHECK_EQUAL(hit1, 1);
+  BOOST_CHECK_EQUAL(hit2, 1);
+}
+
+BOOST_AUTO_TEST_CASE(CancelFromEvent)
+{
+  int count = 0;
+  EventId later;
+  scheduler.scheduleEvent(time::milliseconds(5), [&] {
+    ++count;
+    scheduler.cancelEvent(later);
+  });
+  later = scheduler.scheduleEvent(time::milliseconds(5), [] { BOOST_ERROR("cancelled event fired"); });
+  scheduler.scheduleEvent(time::seconds(20), [&] { scheduler.cancelAllEvents(); });
+  scheduler.scheduleEvent(time::seconds(20), [] { BOOST_ERROR("cancelled event fired"); });
+
+  advanceClocks(time::milliseconds(10), 3000);
+  BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Idle)
+{
+  EventId i = scheduler.scheduleEvent(time::seconds(10), [] {});
+  scheduler.cancelEvent(i);
+
+  // the deadline timer is cancelled, so the io_service runs out of work
+  BOOST_CHECK_EQUAL(io.run(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SameAsMultiset)
+{
+  Scheduler reference(io);
+  std::vector<std::pair<int, time::steady_clock::TimePoint>> fired[2];
+  std::vector<EventId> ids[2];
+  Scheduler* schedulers[2] = {&reference, &scheduler};
+
+  // each event can schedule or cancel more events, at the same points in both schedulers
+  std::function<void(size_t, int)> scheduleEvent = [&] (size_t engine, int label) {
+    time::microseconds delay((label * 7919) % 9000000);
+    ids[engine].push_back(schedulers[engine]->scheduleEvent(delay, [&, engine, label] {
+      fired[engine].emplace_back(label, time::steady_clock::now());
+      if (label % 5 == 0 && label < 3000) {
+        scheduleEvent(engine, label * 3 + 1);
+      }
+      if (label % 7 == 0) {
+        schedulers[engine]->cancelEvent(ids[engine][(label * 13) % ids[engine].size()]);
+      }
+    }));
+  };
+
+  for (int label = 0; label < 2000; ++label) {
+    for (size_t engine = 0; engine < 2; ++engine) {
+      scheduleEvent(engine, label);
+      if (label % 11 == 0) {
+        schedulers[engine]->cancelEvent(ids[engine][label / 2]);
+      }
+    }
+    if (label % 100 == 0) {
+      advanceClocks(time::microseconds(300));
+    }
+  }
+  advanceClocks(time::microseconds(700), 20000);
+
+  BOOST_CHECK_GT(fired[0].size(), 1000);
+  BOOST_CHECK_EQUAL(fired[0].size(), fired[1].size());
+  BOOST_CHECK(fired[0] == fired[1]);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TimingWheelEngine
+
 BOOST_AUTO_TEST_SUITE_END() // UtilTestScheduler
 
 } // namespace tests
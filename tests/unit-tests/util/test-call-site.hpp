@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TESTS_UNIT_TESTS_UTIL_TEST_CALL_SITE_HPP
+#define NDN_TESTS_UNIT_TESTS_UTIL_TEST_CALL_SITE_HPP
+
+#include "util/logger-sink.hpp"
+
+#include <boost/assert.hpp>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+/** \return a registered call site at \p level, for creating LogRecords without a log statement
+ *  \tparam getLogger getNdnCxxLogger of the test file, whose module the records belong to
+ */
+template<Logger& (*getLogger)()>
+const LogCallSite&
+getTestCallSite(LogLevel level = LogLevel::DEBUG)
+{
+  static LogCallSite sites[] = {
+    {getLogger, LogLevel::FATAL, __FILE__, __LINE__, ""},
+    {getLogger, LogLevel::ERROR, __FILE__, __LINE__, ""},
+    {getLogger, LogLevel::WARN, __FILE__, __LINE__, ""},
+    {getLogger, LogLevel::INFO, __FILE__, __LINE__, ""},
+    {getLogger, LogLevel::DEBUG, __FILE__, __LINE__, ""},
+    {getLogger, LogLevel::TRACE, __FILE__, __LINE__, ""},
+  };
+
+  for (LogCallSite& site : sites) {
+    if (site.getLevel() == level) {
+      site.isEnabled(); // registers the call site
+      return site;
+    }
+  }
+  BOOST_ASSERT_MSG(false, "no call site at this level");
+  return sites[0];
+}
+
+/** \brief write a record with message "record <i>" into \p sink
+ */
+template<Logger& (*getLogger)()>
+void
+writeRecord(LogSink& sink, int i, LogLevel level = LogLevel::DEBUG)
+{
+  LogRecord record(getTestCallSite<getLogger>(level));
+  record << "record " << i;
+  sink.write(record);
+}
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_TESTS_UNIT_TESTS_UTIL_TEST_CALL_SITE_HPP
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "util/timing-wheel.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_FIXTURE_TEST_SUITE(UtilTimingWheel, UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE(Expiry)
+{
+  TimingWheel wheel(io);
+  BOOST_CHECK(wheel.getAccuracy() == time::milliseconds(1));
+
+  std::vector<int> fired;
+  TimingWheel::Timer timers[5];
+  wheel.schedule(timers[0], time::milliseconds(300), [&] { fired.push_back(0); });
+  wheel.schedule(timers[1], time::milliseconds(5), [&] { fired.push_back(1); });
+  wheel.schedule(timers[2], time::seconds(70), [&] { fired.push_back(2); });
+  wheel.schedule(timers[3], time::milliseconds(0), [&] { fired.push_back(3); });
+  wheel.schedule(timers[4], time::milliseconds(256), [&] { fired.push_back(4); });
+  BOOST_CHECK_EQUAL(wheel.size(), 5);
+  BOOST_CHECK(timers[0].isPending());
+
+  advanceClocks(time::milliseconds(1), 4);
+  BOOST_CHECK((fired == std::vector<int>{3}));
+  advanceClocks(time::milliseconds(1), 1);
+  BOOST_CHECK((fired == std::vector<int>{3, 1}));
+  advanceClocks(time::milliseconds(1), 250);
+  BOOST_CHECK((fired == std::vector<int>{3, 1}));
+  advanceClocks(time::milliseconds(1), 1);
+  BOOST_CHECK((fired == std::vector<int>{3, 1, 4}));
+  advanceClocks(time::milliseconds(1), 43);
+  BOOST_CHECK((fired == std::vector<int>{3, 1, 4}));
+  advanceClocks(time::milliseconds(1), 1);
+  BOOST_CHECK((fired == std::vector<int>{3, 1, 4, 0}));
+  BOOST_CHECK(!timers[0].isPending());
+
+  advanceClocks(time::milliseconds(100), 696);
+  BOOST_CHECK((fired == std::vector<int>{3, 1, 4, 0}));
+  advanceClocks(time::milliseconds(100), 1);
+  BOOST_CHECK((fired == std::vector<int>{3, 1, 4, 0, 2}));
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(NeverEarly)
+{
+  TimingWheel wheel(io, time::milliseconds(4));
+  boost::random::mt19937 gen;
+  boost::random::uniform_int_distribution<int> dist(0, 100000);
+
+  const size_t N_TIMERS = 1000;
+  std::vector<unique_ptr<TimingWheel::Timer>> timers;
+  size_t nFired = 0;
+  for (size_t i = 0; i < N_TIMERS; ++i) {
+    timers.emplace_back(new TimingWheel::Timer);
+    time::milliseconds delay(dist(gen));
+    time::steady_clock::TimePoint expiry = time::steady_clock::now() + delay;
+    wheel.schedule(*timers.back(), delay, [&, expiry] {
+      time::nanoseconds lateness = time::steady_clock::now() - expiry;
+      BOOST_CHECK_GE(lateness, time::nanoseconds::zero());
+      BOOST_CHECK_LE(lateness, time::milliseconds(14));
+      ++nFired;
+    });
+    if (i % 3 == 0) {
+      advanceClocks(time::milliseconds(7));
+    }
+  }
+
+  advanceClocks(time::milliseconds(10), 10500);
+  BOOST_CHECK_EQUAL(nFired, N_TIMERS);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CancelAndReschedule)
+{
+  TimingWheel wheel(io);
+  size_t count1 = 0;
+  size_t count2 = 0;
+  TimingWheel::Timer timer1;
+  {
+    TimingWheel::Timer timer2;
+    wheel.schedule(timer2, time::milliseconds(10), [&] { ++count2; });
+  } // destroying the timer cancels it
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+
+  wheel.schedule(timer1, time::milliseconds(10), [&] { ++count1; });
+  timer1.cancel();
+  BOOST_CHECK(!timer1.isPending());
+  timer1.cancel();
+
+  wheel.schedule(timer1, time::milliseconds(10), [&] { ++count1; });
+  wheel.schedule(timer1, time::milliseconds(20), [&] { count1 += 10; });
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  advanceClocks(time::milliseconds(1), 15);
+  BOOST_CHECK_EQUAL(count1, 0);
+  advanceClocks(time::milliseconds(1), 5);
+  BOOST_CHECK_EQUAL(count1, 10);
+  BOOST_CHECK_EQUAL(count2, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ScheduleFromCallback)
+{
+  TimingWheel wheel(io);
+  unique_ptr<TimingWheel::Timer> timer(new TimingWheel::Timer);
+  TimingWheel::Timer other;
+  size_t count = 0;
+
+  std::function<void()> callback = [&] {
+    ++count;
+    if (count < 3) {
+      wheel.schedule(*timer, time::milliseconds(0), callback);
+    }
+    if (count == 2) {
+      // expires in the same tick as timer, but fires after it
+      wheel.schedule(other, time::milliseconds(1), [] { BOOST_ERROR("cancelled timer fired"); });
+    }
+    if (count == 3) {
+      other.cancel();
+      timer.reset();
+    }
+  };
+  wheel.schedule(*timer, time::milliseconds(5), callback);
+
+  advanceClocks(time::milliseconds(1), 5);
+  BOOST_CHECK_EQUAL(count, 1);
+  advanceClocks(time::milliseconds(1), 1);
+  BOOST_CHECK_EQUAL(count, 2);
+  advanceClocks(time::milliseconds(1), 1);
+  BOOST_CHECK_EQUAL(count, 3);
+  BOOST_CHECK(timer == nullptr);
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SetAccuracy)
+{
+  TimingWheel wheel(io);
+  BOOST_CHECK_THROW(TimingWheel(io, time::nanoseconds::zero()), std::invalid_argument);
+  BOOST_CHECK_THROW(wheel.setAccuracy(time::milliseconds(-1)), std::invalid_argument);
+
+  size_t count = 0;
+  TimingWheel::Timer timers[2];
+  wheel.schedule(timers[0], time::milliseconds(25), [&] { ++count; });
+  wheel.schedule(timers[1], time::milliseconds(1000), [&] { ++count; });
+  advanceClocks(time::milliseconds(3));
+
+  wheel.setAccuracy(time::milliseconds(10));
+  BOOST_CHECK(wheel.getAccuracy() == time::milliseconds(10));
+  BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+  advanceClocks(time::milliseconds(1), 21);
+  BOOST_CHECK_EQUAL(count, 0);
+  advanceClocks(time::milliseconds(1), 9);
+  BOOST_CHECK_EQUAL(count, 1);
+  advanceClocks(time::milliseconds(1), 969);
+  BOOST_CHECK_EQUAL(count, 1);
+  advanceClocks(time::milliseconds(1), 1);
+  BOOST_CHECK_EQUAL(count, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Idle)
+{
+  TimingWheel wheel(io);
+  TimingWheel::Timer timer;
+  wheel.schedule(timer, time::seconds(10), [] {});
+  timer.cancel();
+
+  // the deadline timer is cancelled, so the io_service runs out of work
+  BOOST_CHECK_EQUAL(io.run(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,333 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+/** \file
+ *  \brief decode, filter, and print structured log files written by ndn::util::TlvLogSink
+ */
+
+#include "name.hpp"
+#include "encoding/block-helpers.hpp"
+#include "util/logger-tlv.hpp"
+
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <unistd.h>
+
+namespace ndn {
+
+class LogCat : noncopyable
+{
+public:
+  LogCat()
+    : m_maxLevel(std::numeric_limits<uint64_t>::max())
+    , m_hasPrefix(false)
+  {
+  }
+
+  /** \brief show only records of \p module
+   */
+  void
+  setModule(const std::string& module)
+  {
+    m_module = module;
+  }
+
+  /** \brief show only records at \p level and more severe levels
+   *  \return whether \p level is valid
+   */
+  bool
+  setMaxLevel(const std::string& level)
+  {
+    for (size_t i = 0; i < sizeof(LEVEL_LABELS) / sizeof(LEVEL_LABELS[0]); ++i) {
+      if (level == LEVEL_LABELS[i] || (level == "WARN" && i == 3)) {
+        m_maxLevel = i;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** \brief show only records that have a Name, Interest, or Data field under \p prefix
+   */
+  void
+  setPrefix(const Name& prefix)
+  {
+    m_prefix = prefix;
+    m_hasPrefix = true;
+  }
+
+  /** \brief print the records in \p is
+   *  \return whether the input is well-formed
+   */
+  bool
+  process(std::istream& is, const std::string& inputName)
+  {
+    // module ids are unique within one file
+    m_modules.clear();
+
+    std::vector<uint8_t> buffer(INITIAL_BUFFER_SIZE);
+    size_t bufferEnd = 0;
+    while (is) {
+      is.read(reinterpret_cast<char*>(buffer.data() + bufferEnd), buffer.size() - bufferEnd);
+      bufferEnd += static_cast<size_t>(is.gcount());
+
+      size_t offset = 0;
+      while (offset < bufferEnd) {
+        bool isOk = false;
+        Block element;
+        std::tie(isOk, element) = Block::fromBuffer(buffer.data() + offset, bufferEnd - offset);
+        if (!isOk) {
+          break;
+        }
+        offset += element.size();
+
+        try {
+          this->processElement(element);
+        }
+        catch (const tlv::Error& e) {
+          std::cerr << inputName << ": malformed element: " << e.what() << std::endl;
+          return false;
+        }
+      }
+
+      // keep the incomplete element, and grow the buffer if it cannot hold the element
+      std::memmove(buffer.data(), buffer.data() + offset, bufferEnd - offset);
+      bufferEnd -= offset;
+      if (bufferEnd == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+      }
+    }
+
+    if (bufferEnd > 0) {
+      std::cerr << inputName << ": truncated element at end of input" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+private:
+  void
+  processElement(const Block& element)
+  {
+    element.parse();
+
+    switch (element.type()) {
+    case tlv::logging::ModuleDeclaration:
+      m_modules[readNonNegativeInteger(element.get(tlv::logging::ModuleId))] =
+        readString(element.get(tlv::logging::ModuleName));
+      break;
+    case tlv::logging::LogRecord:
+      this->processRecord(element);
+      break;
+    default:
+      // ignore unknown elements
+      break;
+    }
+  }
+
+  void
+  processRecord(const Block& record)
+  {
+    uint64_t level = readNonNegativeInteger(record.get(tlv::logging::Level));
+    if (level > m_maxLevel) {
+      return;
+    }
+
+    auto module = m_modules.find(readNonNegativeInteger(record.get(tlv::logging::ModuleId)));
+    if (module == m_modules.end()) {
+      BOOST_THROW_EXCEPTION(tlv::Error("LogRecord refers to an undeclared module"));
+    }
+    if (!m_module.empty() && module->second != m_module) {
+      return;
+    }
+
+    bool isUnderPrefix = !m_hasPrefix;
+    std::ostringstream message;
+    for (const Block& field : record.elements()) {
+      switch (field.type()) {
+      case tlv::logging::TextField:
+        message.write(reinterpret_cast<const char*>(field.value()), field.value_size());
+        break;
+      case tlv::logging::SignedIntegerField:
+        message << static_cast<int64_t>(readFixedInteger(field));
+        break;
+      case tlv::logging::UnsignedIntegerField:
+        message << readNonNegativeInteger(field);
+        break;
+      case tlv::logging::DoubleField: {
+        uint64_t bits = readFixedInteger(field);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        message << value;
+        break;
+      }
+      case tlv::logging::BooleanField:
+        message << readNonNegativeInteger(field);
+        break;
+      case tlv::Name:
+        isUnderPrefix = this->printName(message, Name(field)) || isUnderPrefix;
+        break;
+      case tlv::logging::InterestField: {
+        field.parse();
+        isUnderPrefix = this->printName(message, Name(field.get(tlv::Name))) || isUnderPrefix;
+        const Block& nonce = field.get(tlv::Nonce);
+        uint32_t nonceValue = 0;
+        if (nonce.value_size() == sizeof(nonceValue)) {
+          std::memcpy(&nonceValue, nonce.value(), sizeof(nonceValue));
+        }
+        message << "?ndn.Nonce=" << nonceValue;
+        break;
+      }
+      case tlv::logging::DataField:
+        field.parse();
+        isUnderPrefix = this->printName(message, Name(field.get(tlv::Name))) || isUnderPrefix;
+        break;
+      default:
+        break;
+      }
+    }
+
+    if (!isUnderPrefix) {
+      return;
+    }
+
+    uint64_t timestamp = readNonNegativeInteger(record.get(tlv::logging::Timestamp));
+    // same format as text log lines: seconds.microseconds LEVEL: [module] message
+    char timestampStr[32];
+    snprintf(timestampStr, sizeof(timestampStr), "%" PRIu64 ".%06" PRIu64,
+             timestamp / 1000000000, timestamp / 1000 % 1000000);
+    std::cout << timestampStr << ' '
+              << (level < sizeof(LEVEL_LABELS) / sizeof(LEVEL_LABELS[0]) ?
+                  LEVEL_LABELS[level] : "ALL")
+              << ": [" << module->second << "] " << message.str() << '\n';
+  }
+
+  /** \return whether \p name is under the prefix filter
+   */
+  bool
+  printName(std::ostream& os, const Name& name) const
+  {
+    os << name;
+    return m_hasPrefix && m_prefix.isPrefixOf(name);
+  }
+
+  static uint64_t
+  readFixedInteger(const Block& field)
+  {
+    if (field.value_size() != sizeof(uint64_t)) {
+      BOOST_THROW_EXCEPTION(tlv::Error("Fixed-length field must have 8 octets"));
+    }
+    uint64_t value;
+    std::memcpy(&value, field.value(), sizeof(value));
+    return be64toh(value);
+  }
+
+private:
+  /** \brief labels of levels, indexed by the value of Level element
+   */
+  static const char* const LEVEL_LABELS[7];
+  static const size_t INITIAL_BUFFER_SIZE = 1 << 20;
+
+  std::map<uint64_t, std::string> m_modules;
+  std::string m_module;
+  uint64_t m_maxLevel;
+  Name m_prefix;
+  bool m_hasPrefix;
+};
+
+const char* const LogCat::LEVEL_LABELS[] = {
+  "FATAL", "NONE", "ERROR", "WARNING", "INFO", "DEBUG", "TRACE"
+};
+
+static int
+usage(const std::string& programName)
+{
+  std::cerr << "Usage: " << programName << " [-m module] [-l level] [-n prefix] [file...]\n"
+            << "Print structured log files as text lines.\n"
+            << "\n"
+            << "  -m module  show only records of this module\n"
+            << "  -l level   show only records at this level or more severe, e.g. INFO\n"
+            << "  -n prefix  show only records that mention a name under this prefix\n"
+            << "  file       structured log file; standard input is read if none is given\n";
+  return 2;
+}
+
+int
+main(int argc, char** argv)
+{
+  LogCat logCat;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "m:l:n:h")) != -1) {
+    switch (opt) {
+    case 'm':
+      logCat.setModule(optarg);
+      break;
+    case 'l':
+      if (!logCat.setMaxLevel(optarg)) {
+        std::cerr << "Unrecognized log level '" << optarg << "'" << std::endl;
+        return 2;
+      }
+      break;
+    case 'n':
+      try {
+        logCat.setPrefix(Name(optarg));
+      }
+      catch (const Name::Error&) {
+        std::cerr << "Invalid prefix '" << optarg << "'" << std::endl;
+        return 2;
+      }
+      break;
+    default:
+      return usage(argv[0]);
+    }
+  }
+
+  if (optind == argc) {
+    return logCat.process(std::cin, "(stdin)") ? 0 : 1;
+  }
+
+  int exitCode = 0;
+  for (int i = optind; i < argc; ++i) {
+    std::ifstream is(argv[i], std::ios::binary);
+    if (!is) {
+      std::cerr << argv[i] << ": cannot open" << std::endl;
+      exitCode = 1;
+      continue;
+    }
+    if (!logCat.process(is, argv[i])) {
+      exitCode = 1;
+    }
+  }
+  return exitCode;
+}
+
+} // namespace ndn
+
+int
+main(int argc, char** argv)
+{
+  return ndn::main(argc, argv);
+}
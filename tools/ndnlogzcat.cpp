@@ -0,0 +1,401 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+/** \file
+ *  \brief decompress log files written by ndn::util::CompressedLogSink, optionally starting
+ *         from a byte offset or a point in time
+ */
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <tuple>
+#include <vector>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace ndn {
+
+class LogZCat : noncopyable
+{
+public:
+  enum class Status {
+    COMPLETE,   ///< the compressed stream ended properly
+    TRUNCATED,  ///< the input ended within the compressed stream
+    CORRUPT     ///< the compressed stream is malformed
+  };
+
+  /** \param is the input, which must be seekable unless printing from the beginning
+   */
+  LogZCat(std::istream& is, const std::string& inputName)
+    : m_is(is)
+    , m_inputName(inputName)
+    , m_input(BUFFER_SIZE)
+    , m_output(BUFFER_SIZE)
+  {
+  }
+
+  /** \brief print all records
+   */
+  bool
+  printAll()
+  {
+    return this->report(this->decompress(0, false, [] (const std::string& line) {
+      std::cout << line << '\n';
+      return true;
+    }));
+  }
+
+  /** \brief print records from the first sync point at or after \p offset
+   */
+  bool
+  printFromOffset(uint64_t offset)
+  {
+    int64_t syncPoint = -1;
+    double timestamp = 0.0;
+    std::tie(syncPoint, timestamp) = this->findValidSyncPoint(offset);
+    if (syncPoint < 0) {
+      return true;
+    }
+
+    return this->report(this->decompress(syncPoint, true, [] (const std::string& line) {
+      std::cout << line << '\n';
+      return true;
+    }));
+  }
+
+  /** \brief print records from the first one whose timestamp is at or after \p startTime
+   *
+   *  The sync point to start decompression is found by a binary search on the timestamps of
+   *  the first record after each sync point, so that only a small portion of a large file is
+   *  decompressed before the first printed record.
+   */
+  bool
+  printFromTime(double startTime)
+  {
+    uint64_t low = 0;
+    uint64_t high = this->getInputSize();
+    int64_t start = 0;
+    bool isRaw = false;
+    while (low < high) {
+      uint64_t middle = low + (high - low) / 2;
+      int64_t syncPoint = -1;
+      double timestamp = 0.0;
+      std::tie(syncPoint, timestamp) = this->findValidSyncPoint(middle);
+      if (syncPoint < 0 || timestamp >= startTime) {
+        high = middle;
+      }
+      else {
+        start = syncPoint;
+        isRaw = true;
+        low = static_cast<uint64_t>(syncPoint);
+      }
+    }
+
+    bool isPrinting = false;
+    return this->report(this->decompress(start, isRaw, [&] (const std::string& line) {
+      // a line without timestamp belongs to a multi-line record
+      double timestamp = 0.0;
+      if (!isPrinting && parseTimestamp(line, timestamp) && timestamp >= startTime) {
+        isPrinting = true;
+      }
+      if (isPrinting) {
+        std::cout << line << '\n';
+      }
+      return true;
+    }));
+  }
+
+private:
+  uint64_t
+  getInputSize()
+  {
+    m_is.clear();
+    m_is.seekg(0, std::ios::end);
+    return static_cast<uint64_t>(std::max<std::streamoff>(m_is.tellg(), 0));
+  }
+
+  /** \brief find the first sync point at or after \p offset that is followed by a record
+   *
+   *  The marker of a sync point, an empty stored block, can also occur by chance within
+   *  compressed data.  Such a false sync point is skipped when decompression from it fails,
+   *  or does not yield a line that starts with a timestamp.
+   *
+   *  \return offset of the compressed data after the sync point, and the timestamp of its
+   *          first record; or -1 if there is no such sync point
+   */
+  std::tuple<int64_t, double>
+  findValidSyncPoint(uint64_t offset)
+  {
+    while (true) {
+      int64_t syncPoint = this->findSyncMarker(offset);
+      if (syncPoint < 0) {
+        return std::make_tuple(-1, 0.0);
+      }
+
+      std::string firstLine;
+      this->decompress(syncPoint, true, [&firstLine] (const std::string& line) {
+        firstLine = line;
+        return false;
+      });
+      double timestamp = 0.0;
+      if (parseTimestamp(firstLine, timestamp)) {
+        return std::make_tuple(syncPoint, timestamp);
+      }
+      offset = static_cast<uint64_t>(syncPoint) - SYNC_MARKER_SIZE + 1;
+    }
+  }
+
+  /** \return offset after the first sync marker that starts at or after \p offset,
+   *          or -1 if there is none
+   */
+  int64_t
+  findSyncMarker(uint64_t offset)
+  {
+    static const uint8_t SYNC_MARKER[SYNC_MARKER_SIZE] = {0x00, 0x00, 0xFF, 0xFF};
+
+    m_is.clear();
+    m_is.seekg(static_cast<std::streamoff>(offset));
+    size_t bufferEnd = 0;
+    while (m_is) {
+      m_is.read(reinterpret_cast<char*>(m_input.data() + bufferEnd), m_input.size() - bufferEnd);
+      bufferEnd += static_cast<size_t>(m_is.gcount());
+      if (bufferEnd < SYNC_MARKER_SIZE) {
+        continue;
+      }
+
+      auto found = std::search(m_input.begin(), m_input.begin() + bufferEnd,
+                               std::begin(SYNC_MARKER), std::end(SYNC_MARKER));
+      if (found != m_input.begin() + bufferEnd) {
+        return static_cast<int64_t>(offset) + (found - m_input.begin()) + SYNC_MARKER_SIZE;
+      }
+
+      // keep a partial marker at the end of the buffer
+      size_t nKept = SYNC_MARKER_SIZE - 1;
+      std::memmove(m_input.data(), m_input.data() + bufferEnd - nKept, nKept);
+      offset += bufferEnd - nKept;
+      bufferEnd = nKept;
+    }
+    return -1;
+  }
+
+  /** \brief decompress from \p offset, and pass each complete line to \p onLine
+   *  \param isRaw true if \p offset is a sync point, false if \p offset is the start of
+   *               the gzip stream
+   *  \param onLine returns false to stop decompression
+   */
+  Status
+  decompress(uint64_t offset, bool isRaw, const function<bool(const std::string&)>& onLine)
+  {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    // negative windowBits: raw deflate data; 15 + 16: gzip format
+    if (inflateInit2(&stream, isRaw ? -15 : 15 + 16) != Z_OK) {
+      return Status::CORRUPT;
+    }
+
+    m_is.clear();
+    if (offset > 0) {
+      m_is.seekg(static_cast<std::streamoff>(offset));
+    }
+
+    std::string line;
+    int result = Z_OK;
+    while (result == Z_OK) {
+      if (stream.avail_in == 0) {
+        m_is.read(reinterpret_cast<char*>(m_input.data()), m_input.size());
+        stream.next_in = m_input.data();
+        stream.avail_in = static_cast<uInt>(m_is.gcount());
+        if (stream.avail_in == 0) {
+          break;
+        }
+      }
+
+      stream.next_out = m_output.data();
+      stream.avail_out = static_cast<uInt>(m_output.size());
+      result = inflate(&stream, Z_NO_FLUSH);
+      if (result == Z_BUF_ERROR) {
+        // no progress is possible without more input
+        result = Z_OK;
+      }
+
+      const char* begin = reinterpret_cast<const char*>(m_output.data());
+      const char* end = begin + (m_output.size() - stream.avail_out);
+      while (begin != end) {
+        const char* newline = std::find(begin, end, '\n');
+        line.append(begin, newline);
+        if (newline == end) {
+          break;
+        }
+        if (!onLine(line)) {
+          inflateEnd(&stream);
+          return Status::COMPLETE;
+        }
+        line.clear();
+        begin = newline + 1;
+      }
+    }
+    // an unterminated line is the partial record of an incomplete stream
+    inflateEnd(&stream);
+
+    switch (result) {
+    case Z_STREAM_END:
+      return Status::COMPLETE;
+    case Z_OK:
+      return Status::TRUNCATED;
+    default:
+      return Status::CORRUPT;
+    }
+  }
+
+  bool
+  report(Status status) const
+  {
+    switch (status) {
+    case Status::COMPLETE:
+      return true;
+    case Status::TRUNCATED:
+      std::cerr << m_inputName << ": compressed stream is incomplete,"
+                << " the file may be still written or truncated" << std::endl;
+      return true;
+    case Status::CORRUPT:
+    default:
+      std::cerr << m_inputName << ": compressed stream is corrupt" << std::endl;
+      return false;
+    }
+  }
+
+  /** \brief parse the timestamp at the beginning of a log line
+   *  \return whether the line starts with a timestamp followed by a space
+   */
+  static bool
+  parseTimestamp(const std::string& line, double& timestamp)
+  {
+    const char* begin = line.c_str();
+    char* end = nullptr;
+    timestamp = std::strtod(begin, &end);
+    return end != begin && *end == ' ' && (*begin == '-' || std::isdigit(*begin));
+  }
+
+private:
+  static const size_t BUFFER_SIZE = 65536;
+  static const size_t SYNC_MARKER_SIZE = 4;
+
+  std::istream& m_is;
+  std::string m_inputName;
+  std::vector<uint8_t> m_input;
+  std::vector<uint8_t> m_output;
+};
+
+static int
+usage(const std::string& programName)
+{
+  std::cerr << "Usage: " << programName << " [-o offset | -s time] file...\n"
+            << "Decompress log files written with a .gz destination, such as NDN_LOG=Face>face.gz\n"
+            << "\n"
+            << "  -o offset  start from the first sync point at or after this byte offset\n"
+            << "  -s time    start from the first record at or after this timestamp,\n"
+            << "             in seconds as printed in log lines, e.g. 1476700000.5\n"
+            << "  file       compressed log file; standard input is read if none is given,\n"
+            << "             but -o and -s require a file\n";
+  return 2;
+}
+
+int
+main(int argc, char** argv)
+{
+  bool hasOffset = false;
+  uint64_t offset = 0;
+  bool hasStartTime = false;
+  double startTime = 0.0;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "o:s:h")) != -1) {
+    char* end = nullptr;
+    switch (opt) {
+    case 'o':
+      offset = std::strtoull(optarg, &end, 10);
+      hasOffset = true;
+      break;
+    case 's':
+      startTime = std::strtod(optarg, &end);
+      hasStartTime = true;
+      break;
+    default:
+      return usage(argv[0]);
+    }
+    if (end == optarg || *end != '\0') {
+      std::cerr << "Invalid argument '" << optarg << "'" << std::endl;
+      return 2;
+    }
+  }
+
+  if (hasOffset && hasStartTime) {
+    return usage(argv[0]);
+  }
+
+  if (optind == argc) {
+    if (hasOffset || hasStartTime) {
+      return usage(argv[0]);
+    }
+    return LogZCat(std::cin, "(stdin)").printAll() ? 0 : 1;
+  }
+
+  int exitCode = 0;
+  for (int i = optind; i < argc; ++i) {
+    std::ifstream is(argv[i], std::ios::binary);
+    if (!is) {
+      std::cerr << argv[i] << ": cannot open" << std::endl;
+      exitCode = 1;
+      continue;
+    }
+
+    LogZCat logZCat(is, argv[i]);
+    bool isOk = false;
+    if (hasOffset) {
+      isOk = logZCat.printFromOffset(offset);
+    }
+    else if (hasStartTime) {
+      isOk = logZCat.printFromTime(startTime);
+    }
+    else {
+      isOk = logZCat.printAll();
+    }
+    if (!isOk) {
+      exitCode = 1;
+    }
+  }
+  return exitCode;
+}
+
+} // namespace ndn
+
+int
+main(int argc, char** argv)
+{
+  return ndn::main(argc, argv);
+}